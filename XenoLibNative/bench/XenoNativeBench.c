@@ -0,0 +1,1023 @@
+#include "XenoNativeVerify.h"
+#include "Algorithms/Xenophyte/Centralized/XenophyteCentralizedAlgorithm.h"
+#include "Algorithms/Xenophyte/Centralized/XenophyteCentralizedPacketCodec.h"
+#include "Algorithms/Xiropht/Decentralized/XirophtDecentralizedAlgorithm.h"
+#include "Utilities/AesMultiBufferUtility.h"
+#include "Utilities/Base58Utility.h"
+#include "Utilities/Base64Utility.h"
+#include "Utilities/CpuDispatchUtility.h"
+#include "Utilities/CpuInformationUtility.h"
+#include "Utilities/CryptographyUtility.h"
+#include "Utilities/KeyDerivationFunctionUtility.h"
+#include "Utilities/MessageDigestUtility.h"
+#include "Utilities/SymmetricAlgorithmUtility.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_MAX_THREAD_COUNTS 16
+#define BENCH_SHARE_BATCH_SIZE 4096
+#define BENCH_MIN_SAMPLE_NANOSECONDS 50000.0
+#define BENCH_RANDOM_PAIRS_LENGTH 1024
+#define BENCH_LANE_BATCH_SIZE 8
+#define BENCH_PBKDF2_BATCH_SIZE 16
+#define BENCH_POC_BATCH_SIZE 16
+
+typedef struct BENCH_CASE BENCH_CASE;
+
+typedef void *(*BENCH_SETUP)(const BENCH_CASE *benchCase);
+typedef void (*BENCH_RUN)(void *state, DOTNET_INT iterations);
+
+struct BENCH_CASE {
+    const char *Name;
+    BENCH_SETUP Setup;
+    BENCH_RUN Run;
+    void (*Teardown)(void *state);
+    DOTNET_INT OperationsPerIteration;
+    DOTNET_INT KeySize;
+    DOTNET_INT AesRound;
+    DOTNET_INT DataLength;
+    DOTNET_INT Threads;
+};
+
+typedef struct BENCH_THREAD {
+    const BENCH_CASE *Case;
+    void *State;
+    pthread_t Thread;
+
+    const DOTNET_INT *Start;
+    DOTNET_DOUBLE TimeNanoseconds;
+
+    DOTNET_DOUBLE *Samples;
+    DOTNET_INT SamplesLength;
+    DOTNET_INT SamplesCapacity;
+
+    DOTNET_LONG Operations;
+    DOTNET_DOUBLE BusyNanoseconds;
+    DOTNET_DOUBLE EndNanoseconds;
+} BENCH_THREAD;
+
+typedef struct BENCH_OPTIONS {
+    DOTNET_INT MaxThreads;
+    DOTNET_INT TimeMilliseconds;
+    const char *Filter;
+    const char *OutputPath;
+
+    DOTNET_BOOL IsVerify;
+    DOTNET_INT VerifyIterations;
+    DOTNET_ULONG VerifySeed;
+} BENCH_OPTIONS;
+
+DOTNET_PRIVATE DOTNET_DOUBLE GetNanoseconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (DOTNET_DOUBLE) now.tv_sec * 1e9 + (DOTNET_DOUBLE) now.tv_nsec;
+}
+
+DOTNET_PRIVATE void FillBytes(DOTNET_SPAN_BYTE output, DOTNET_INT length, DOTNET_UINT seed) {
+    for (DOTNET_INT i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        output[i] = (DOTNET_BYTE) (seed >> 16);
+    }
+}
+
+/*
+ * Xenophyte share benchmarks
+ */
+
+typedef struct SHARE_STATE {
+    DOTNET_BYTE XorKey[128];
+    DOTNET_BYTE AesKey[32];
+    DOTNET_BYTE AesIv[16];
+    DOTNET_INT KeySize;
+    DOTNET_INT AesRound;
+
+    DOTNET_BYTE Input[64];
+    DOTNET_INT InputLength;
+
+    XENOPHYTE_SHARE_CTX *Context;
+    XENOPHYTE_SHARE_CANDIDATE Candidates[BENCH_SHARE_BATCH_SIZE];
+    XENOPHYTE_SHARE_CANDIDATE CommonFirstCandidates[BENCH_SHARE_BATCH_SIZE];
+
+    DOTNET_BYTE EncryptedShare[64 * 2];
+    DOTNET_BYTE HashEncryptedShare[64 * 2];
+} SHARE_STATE;
+
+DOTNET_PRIVATE void *SetupShare(const BENCH_CASE *benchCase) {
+    SHARE_STATE *state = calloc(1, sizeof(SHARE_STATE));
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    FillBytes(state->XorKey, sizeof(state->XorKey), 1);
+    FillBytes(state->AesKey, sizeof(state->AesKey), 2);
+    FillBytes(state->AesIv, sizeof(state->AesIv), 3);
+
+    state->KeySize = benchCase->KeySize;
+    state->AesRound = benchCase->AesRound;
+
+    // "<first> + <second><timestamp>" with the first number padded to the requested length.
+    DOTNET_INT firstLength = benchCase->DataLength - (DOTNET_INT) strlen(" + 56781654187614");
+
+    for (DOTNET_INT i = 0; i < firstLength; i++) {
+        state->Input[i] = (DOTNET_BYTE) ('1' + i % 9);
+    }
+
+    memcpy(state->Input + firstLength, " + 56781654187614", strlen(" + 56781654187614"));
+    state->InputLength = benchCase->DataLength;
+
+    state->Context = XenophyteCentralizedAlgorithm_CreateShareContext(state->XorKey, sizeof(state->XorKey), state->KeySize, state->AesKey, state->AesIv, state->AesRound);
+
+    if (state->Context == NULL) {
+        free(state);
+        return NULL;
+    }
+
+    // An indication that never matches keeps the batch doing the full work.
+    DOTNET_BYTE blockIndication[64 * 2];
+    memset(blockIndication, '0', sizeof(blockIndication));
+    XenophyteCentralizedAlgorithm_SetShareContextBlockIndication(state->Context, blockIndication, sizeof(blockIndication));
+
+    DOTNET_UINT seed = 4;
+
+    for (DOTNET_INT i = 0; i < BENCH_SHARE_BATCH_SIZE; i++) {
+        seed = seed * 1103515245 + 12345;
+        state->Candidates[i].FirstNumber = 1 + seed % 1000000000;
+        seed = seed * 1103515245 + 12345;
+        state->Candidates[i].SecondNumber = 1 + seed % 1000000000;
+        state->Candidates[i].Operator = "+-*/%"[i % 5];
+    }
+
+    // Runs of 256 candidates share a ten digit first number, like a random number paired with every easy block number.
+    for (DOTNET_INT i = 0; i < BENCH_SHARE_BATCH_SIZE; i++) {
+        seed = seed * 1103515245 + 12345;
+        state->CommonFirstCandidates[i].FirstNumber = 1000000000 + i / 256 * 7919;
+        state->CommonFirstCandidates[i].SecondNumber = 1 + seed % 1000000000;
+        state->CommonFirstCandidates[i].Operator = "+-*/%"[i % 5];
+    }
+
+    return state;
+}
+
+DOTNET_PRIVATE void TeardownShare(void *state) {
+    XenophyteCentralizedAlgorithm_FreeShareContext(((SHARE_STATE *) state)->Context);
+    free(state);
+}
+
+DOTNET_PRIVATE void RunMakeEncryptedShare(void *state, DOTNET_INT iterations) {
+    SHARE_STATE *share = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_MakeEncryptedShare(share->Input, share->InputLength, share->EncryptedShare, share->HashEncryptedShare, share->XorKey, sizeof(share->XorKey), share->KeySize, share->AesKey, share->AesIv, share->AesRound);
+    }
+}
+
+DOTNET_PRIVATE void RunMakeEncryptedShareWithContext(void *state, DOTNET_INT iterations) {
+    SHARE_STATE *share = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_MakeEncryptedShareWithContext(share->Context, share->Input, share->InputLength, share->EncryptedShare, share->HashEncryptedShare);
+    }
+}
+
+DOTNET_PRIVATE void RunMakeEncryptedShareBatch(void *state, DOTNET_INT iterations) {
+    SHARE_STATE *share = state;
+    DOTNET_INT matchIndex;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_MakeEncryptedShareBatch(share->Context, share->Candidates, BENCH_SHARE_BATCH_SIZE, 1654187614, &matchIndex, share->EncryptedShare, 1);
+    }
+}
+
+DOTNET_PRIVATE void RunMakeEncryptedShareBatchCommonFirst(void *state, DOTNET_INT iterations) {
+    SHARE_STATE *share = state;
+    DOTNET_INT matchIndex;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_MakeEncryptedShareBatch(share->Context, share->CommonFirstCandidates, BENCH_SHARE_BATCH_SIZE, 1654187614, &matchIndex, share->EncryptedShare, 1);
+    }
+}
+
+/*
+ * Block number benchmarks
+ */
+
+typedef struct BLOCK_NUMBER_STATE {
+    DOTNET_LONG MaxValue;
+    DOTNET_LONG Output[];
+} BLOCK_NUMBER_STATE;
+
+DOTNET_PRIVATE void *SetupBlockNumbers(const BENCH_CASE *benchCase) {
+    BLOCK_NUMBER_STATE *state = malloc(sizeof(BLOCK_NUMBER_STATE) + sizeof(DOTNET_LONG) * (benchCase->DataLength > 256 ? benchCase->DataLength : 256));
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    state->MaxValue = benchCase->DataLength;
+
+    return state;
+}
+
+DOTNET_PRIVATE void RunGenerateEasyBlockNumbers(void *state, DOTNET_INT iterations) {
+    BLOCK_NUMBER_STATE *blockNumbers = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_GenerateEasyBlockNumbers(1, blockNumbers->MaxValue, blockNumbers->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunGenerateNonEasyBlockNumbers(void *state, DOTNET_INT iterations) {
+    BLOCK_NUMBER_STATE *blockNumbers = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_GenerateNonEasyBlockNumbers(1, blockNumbers->MaxValue, blockNumbers->Output);
+    }
+}
+
+typedef struct RANDOM_PAIRS_STATE {
+    DOTNET_LONG MaxValue;
+    RANDOM_NUMBER_GENERATOR_LANES Generator;
+    DOTNET_LONG FirstNumbers[BENCH_RANDOM_PAIRS_LENGTH];
+    DOTNET_LONG SecondNumbers[BENCH_RANDOM_PAIRS_LENGTH];
+} RANDOM_PAIRS_STATE;
+
+DOTNET_PRIVATE void *SetupRandomPairs(const BENCH_CASE *benchCase) {
+    RANDOM_PAIRS_STATE *state = malloc(sizeof(RANDOM_PAIRS_STATE));
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    state->MaxValue = benchCase->DataLength;
+    RandomNumberGeneratorUtility_InitializeLanes(&state->Generator, 1);
+
+    return state;
+}
+
+DOTNET_PRIVATE void RunGenerateRandomBlockNumberPairs(void *state, DOTNET_INT iterations) {
+    RANDOM_PAIRS_STATE *randomPairs = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(&randomPairs->Generator, 1, randomPairs->MaxValue, DOTNET_FALSE, randomPairs->FirstNumbers, randomPairs->SecondNumbers, BENCH_RANDOM_PAIRS_LENGTH);
+    }
+}
+
+DOTNET_PRIVATE void RunGenerateBiasRandomBlockNumberPairs(void *state, DOTNET_INT iterations) {
+    RANDOM_PAIRS_STATE *randomPairs = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(&randomPairs->Generator, 1, randomPairs->MaxValue, DOTNET_TRUE, randomPairs->FirstNumbers, randomPairs->SecondNumbers, BENCH_RANDOM_PAIRS_LENGTH);
+    }
+}
+
+/*
+ * Buffer benchmarks
+ */
+
+typedef struct BUFFER_STATE {
+    DOTNET_BYTE Key[32];
+    DOTNET_BYTE Iv[16];
+    DOTNET_INT AesRound;
+    DOTNET_INT InputLength;
+    DOTNET_INT EncodedLength;
+    DOTNET_BYTE *Input;
+    DOTNET_BYTE *Encoded;
+    DOTNET_BYTE *Output;
+    XENOPHYTE_PACKET_CODEC *PacketCodec;
+} BUFFER_STATE;
+
+DOTNET_PRIVATE void *SetupBuffer(const BENCH_CASE *benchCase) {
+    BUFFER_STATE *state = calloc(1, sizeof(BUFFER_STATE));
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    DOTNET_INT capacity = Base64Utility_EncodeLength(benchCase->DataLength) + 64;
+
+    state->InputLength = benchCase->DataLength;
+    state->Input = malloc(capacity);
+    state->Encoded = malloc(capacity);
+    state->Output = malloc(capacity);
+
+    if (state->Input == NULL || state->Encoded == NULL || state->Output == NULL) {
+        free(state->Input);
+        free(state->Encoded);
+        free(state->Output);
+        free(state);
+        return NULL;
+    }
+
+    FillBytes(state->Key, sizeof(state->Key), 5);
+    FillBytes(state->Iv, sizeof(state->Iv), 6);
+    FillBytes(state->Input, state->InputLength, 7);
+
+    state->EncodedLength = Base64Utility_Encode(state->Input, state->InputLength, state->Encoded);
+
+    return state;
+}
+
+DOTNET_PRIVATE void TeardownBuffer(void *state) {
+    BUFFER_STATE *buffer = state;
+
+    XenophyteCentralizedPacketCodec_Free(buffer->PacketCodec);
+    free(buffer->Input);
+    free(buffer->Encoded);
+    free(buffer->Output);
+    free(buffer);
+}
+
+DOTNET_PRIVATE void RunBase64Encode(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        Base64Utility_Encode(buffer->Input, buffer->InputLength, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunBase64Decode(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        Base64Utility_Decode(buffer->Encoded, buffer->EncodedLength, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunAes256Cfb8Encrypt(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        SymmetricAlgorithmUtility_Encrypt_AES_256_CFB_8(buffer->Key, buffer->Iv, buffer->Input, buffer->InputLength, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunAes256Cfb8Decrypt(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        SymmetricAlgorithmUtility_Decrypt_AES_256_CFB_8(buffer->Key, buffer->Iv, buffer->Input, buffer->InputLength, buffer->Output);
+    }
+}
+
+// The encoded buffer holds Base58 instead of Base64.
+DOTNET_PRIVATE void *SetupBase58(const BENCH_CASE *benchCase) {
+    BUFFER_STATE *state = SetupBuffer(benchCase);
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    state->EncodedLength = Base58Utility_Encode(state->Input, state->InputLength, state->Encoded);
+
+    return state;
+}
+
+DOTNET_PRIVATE void RunBase58Encode(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        Base58Utility_Encode(buffer->Input, buffer->InputLength, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunBase58Decode(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        Base58Utility_Decode(buffer->Encoded, buffer->EncodedLength, buffer->Output);
+    }
+}
+
+// The encoded buffer holds a whole frame instead of plain Base64.
+DOTNET_PRIVATE void *SetupPacketCodec(const BENCH_CASE *benchCase) {
+    BUFFER_STATE *state = SetupBuffer(benchCase);
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    state->PacketCodec = XenophyteCentralizedPacketCodec_Create(state->Key, state->Iv, state->InputLength);
+
+    if (state->PacketCodec == NULL) {
+        TeardownBuffer(state);
+        return NULL;
+    }
+
+    state->EncodedLength = XenophyteCentralizedPacketCodec_Encode(state->PacketCodec, state->Input, state->InputLength, state->Encoded);
+
+    return state;
+}
+
+DOTNET_PRIVATE void RunPacketCodecEncode(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedPacketCodec_Encode(buffer->PacketCodec, buffer->Input, buffer->InputLength, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunPacketCodecDecode(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+    DOTNET_INT packetLength;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XenophyteCentralizedPacketCodec_Decode(buffer->PacketCodec, buffer->Encoded, buffer->EncodedLength, &packetLength);
+    }
+}
+
+DOTNET_PRIVATE void RunSha2_512(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        MessageDigestUtility_ComputeSha2_512Hash(buffer->Input, buffer->InputLength, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunSha3_512(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        MessageDigestUtility_ComputeSha3_512Hash(buffer->Input, buffer->InputLength, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void *SetupSha3_512Batch(const BENCH_CASE *benchCase) {
+    BUFFER_STATE *state = calloc(1, sizeof(BUFFER_STATE));
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    state->InputLength = benchCase->DataLength;
+    state->Input = malloc(BENCH_LANE_BATCH_SIZE * state->InputLength);
+    state->Output = malloc(BENCH_LANE_BATCH_SIZE * SHA512_DIGEST_SIZE);
+
+    if (state->Input == NULL || state->Output == NULL) {
+        TeardownBuffer(state);
+        return NULL;
+    }
+
+    FillBytes(state->Input, BENCH_LANE_BATCH_SIZE * state->InputLength, 7);
+
+    return state;
+}
+
+DOTNET_PRIVATE void RunSha3_512Batch(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+    const DOTNET_BYTE *sources[BENCH_LANE_BATCH_SIZE];
+    DOTNET_BYTE *destinations[BENCH_LANE_BATCH_SIZE];
+    DOTNET_INT sourceLengths[BENCH_LANE_BATCH_SIZE];
+
+    for (DOTNET_INT i = 0; i < BENCH_LANE_BATCH_SIZE; i++) {
+        sources[i] = buffer->Input + i * buffer->InputLength;
+        destinations[i] = buffer->Output + i * SHA512_DIGEST_SIZE;
+        sourceLengths[i] = buffer->InputLength;
+    }
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        MessageDigestUtility_ComputeSha3_512HashBatch(sources, sourceLengths, destinations, BENCH_LANE_BATCH_SIZE, 1);
+    }
+}
+
+DOTNET_PRIVATE void RunPbkdf1(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    // Same shape as the block header key derivation: 100 SHA1 iterations, then the key and the iv.
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        KDF_PBKDF1_CTX *context = KeyDerivationFunctionUtility_CreatePBKDF1(buffer->Input, buffer->InputLength, buffer->Key, sizeof(buffer->Key), 100, "SHA1");
+
+        KeyDerivationFunctionUtility_GetBytes(context, buffer->Output, 32);
+        KeyDerivationFunctionUtility_GetBytes(context, buffer->Output + 32, 16);
+        KeyDerivationFunctionUtility_Free(context);
+    }
+}
+
+// Nonce iv sized passwords against a mark key salt, the data length is the iteration count.
+DOTNET_PRIVATE void RunPbkdf2Sha1(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        PKCS5_PBKDF2_HMAC_SHA1((const char *) buffer->Input, 16, buffer->Input + 16, 64, buffer->InputLength, 16, buffer->Output);
+    }
+}
+
+DOTNET_PRIVATE void RunPbkdf2Sha1Batch(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+    const DOTNET_BYTE *passwords[BENCH_PBKDF2_BATCH_SIZE];
+    DOTNET_BYTE *destinations[BENCH_PBKDF2_BATCH_SIZE];
+    DOTNET_INT passwordLengths[BENCH_PBKDF2_BATCH_SIZE];
+
+    for (DOTNET_INT i = 0; i < BENCH_PBKDF2_BATCH_SIZE; i++) {
+        passwords[i] = buffer->Input + 80 + i * 16;
+        destinations[i] = buffer->Output + i * 16;
+        passwordLengths[i] = 16;
+    }
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        KeyDerivationFunctionUtility_ComputePbkdf2Sha1Batch(passwords, passwordLengths, buffer->Input + 16, 64, buffer->InputLength, destinations, 16, BENCH_PBKDF2_BATCH_SIZE);
+    }
+}
+
+DOTNET_PRIVATE void RunLz4CompressNonceIv(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        DOTNET_INT length = buffer->InputLength;
+
+        memcpy(buffer->Output, buffer->Input, length);
+        XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(buffer->Output, &length);
+    }
+}
+
+// Every lane needs room for the data and one extra block per share iteration, the output also takes the unencrypted data in front.
+DOTNET_PRIVATE void *SetupEncryptedPocShare(const BENCH_CASE *benchCase) {
+    BUFFER_STATE *state = calloc(1, sizeof(BUFFER_STATE));
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    DOTNET_INT laneCapacity = benchCase->DataLength * 2 + benchCase->AesRound * 16;
+
+    state->AesRound = benchCase->AesRound;
+    state->InputLength = benchCase->DataLength;
+    state->Input = malloc(BENCH_POC_BATCH_SIZE * laneCapacity);
+    state->Output = malloc(BENCH_POC_BATCH_SIZE * laneCapacity);
+
+    if (state->Input == NULL || state->Output == NULL) {
+        TeardownBuffer(state);
+        return NULL;
+    }
+
+    FillBytes(state->Key, sizeof(state->Key), 5);
+    FillBytes(state->Iv, sizeof(state->Iv), 6);
+    FillBytes(state->Input, BENCH_POC_BATCH_SIZE * laneCapacity, 7);
+    memcpy(state->Output, state->Input, state->InputLength);
+
+    return state;
+}
+
+DOTNET_PRIVATE void RunEncryptedPocShare(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+
+    // The instruction leaves the data in front alone, so it is encrypted again every time.
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        DOTNET_INT length = buffer->InputLength;
+        XirophtDecentralizedAlgorithm_Solo_DoEncryptedPocShareMiningInstruction(buffer->Key, buffer->Iv, buffer->AesRound, buffer->Output, &length);
+    }
+}
+
+DOTNET_PRIVATE void RunEncryptedPocShareBatch(void *state, DOTNET_INT iterations) {
+    BUFFER_STATE *buffer = state;
+    DOTNET_INT laneCapacity = buffer->InputLength * 2 + buffer->AesRound * 16;
+
+    const DOTNET_BYTE *ivs[BENCH_POC_BATCH_SIZE];
+    const DOTNET_BYTE *sources[BENCH_POC_BATCH_SIZE];
+    DOTNET_BYTE *destinations[BENCH_POC_BATCH_SIZE];
+    DOTNET_INT lengths[BENCH_POC_BATCH_SIZE];
+
+    for (DOTNET_INT i = 0; i < BENCH_POC_BATCH_SIZE; i++) {
+        ivs[i] = buffer->Input + i * laneCapacity + buffer->InputLength;
+        sources[i] = buffer->Input + i * laneCapacity;
+        destinations[i] = buffer->Output + i * laneCapacity;
+    }
+
+    // Like a PoC workspace, the key is expanded once and every call encrypts a group of nonces.
+    AES_MULTI_BUFFER_KEY key;
+    AesMultiBufferUtility_ExpandKey(&key, 256, buffer->Key);
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        for (DOTNET_INT j = 0; j < BENCH_POC_BATCH_SIZE; j++) {
+            lengths[j] = buffer->InputLength;
+        }
+
+        AesMultiBufferUtility_Encrypt_CFB128_Iterations(&key, ivs, buffer->AesRound, sources, destinations, lengths, BENCH_POC_BATCH_SIZE);
+    }
+}
+
+/*
+ * Xiropht benchmarks
+ */
+
+typedef struct POC_STATE {
+    XIROPHT_POC_WORKSPACE *Workspace;
+    DOTNET_SPAN_BYTE PocShare;
+    DOTNET_LONG Nonce;
+
+    DOTNET_SPAN_BYTE PocShares;
+    DOTNET_LONG PocShareNonces[BENCH_POC_BATCH_SIZE];
+    DOTNET_INT PocShareLengths[BENCH_POC_BATCH_SIZE];
+} POC_STATE;
+
+DOTNET_PRIVATE void TeardownPocShare(void *state) {
+    POC_STATE *poc = state;
+
+    XirophtDecentralizedAlgorithm_Solo_FreePocWorkspace(poc->Workspace);
+    free(poc->PocShare);
+    free(poc->PocShares);
+    free(poc);
+}
+
+DOTNET_PRIVATE void *SetupPocShare(const BENCH_CASE *benchCase) {
+    POC_STATE *state = calloc(1, sizeof(POC_STATE));
+
+    if (state == NULL) {
+        return NULL;
+    }
+
+    DOTNET_BYTE walletAddress[96], blockDifficulty[16], previousFinalBlockTransactionHashKey[128], blockchainMarkKey[64], pocShareKey[32];
+
+    FillBytes(walletAddress, sizeof(walletAddress), 8);
+    FillBytes(blockDifficulty, sizeof(blockDifficulty), 9);
+    FillBytes(previousFinalBlockTransactionHashKey, sizeof(previousFinalBlockTransactionHashKey), 10);
+    FillBytes(blockchainMarkKey, sizeof(blockchainMarkKey), 11);
+    FillBytes(pocShareKey, sizeof(pocShareKey), 12);
+
+    // The range accepts every nonce so each iteration runs the whole sequence.
+    XIROPHT_POC_JOB job;
+
+    job.RandomNumber = 1234;
+    job.RandomNumber2 = 5678;
+    job.ChecksumSize = 32;
+    job.WalletAddress = walletAddress;
+    job.WalletAddressLength = sizeof(walletAddress);
+    job.BlockHeight = 100000;
+    job.PocRoundShaNonce = benchCase->DataLength;
+    job.PocShareNonceMaxSquareRetry = 4;
+    job.PocShareNonceNoSquareFoundShaRounds = benchCase->DataLength;
+    job.PocShareNonceMin = 0;
+    job.PocShareNonceMax = DOTNET_LONG_MAX;
+    job.BlockDifficulty = blockDifficulty;
+    job.BlockDifficultyLength = sizeof(blockDifficulty);
+    job.PreviousFinalBlockTransactionHashKey = previousFinalBlockTransactionHashKey;
+    job.PreviousFinalBlockTransactionHashKeyLength = sizeof(previousFinalBlockTransactionHashKey);
+    job.BlockchainMarkKey = blockchainMarkKey;
+    job.BlockchainMarkKeyLength = sizeof(blockchainMarkKey);
+    job.PocShareNonceIvIteration = benchCase->DataLength;
+    job.PocShareKey = pocShareKey;
+    job.PocShareIterations = benchCase->AesRound;
+
+    state->Workspace = XirophtDecentralizedAlgorithm_Solo_CreatePocWorkspace(&job);
+    state->PocShare = state->Workspace != NULL ? malloc(XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(state->Workspace)) : NULL;
+    state->PocShares = state->Workspace != NULL ? malloc(BENCH_POC_BATCH_SIZE * XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(state->Workspace)) : NULL;
+
+    if (state->PocShare == NULL || state->PocShares == NULL) {
+        TeardownPocShare(state);
+        return NULL;
+    }
+
+    return state;
+}
+
+DOTNET_PRIVATE void RunComputePocShare(void *state, DOTNET_INT iterations) {
+    POC_STATE *poc = state;
+    DOTNET_LONG pocShareNonce;
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        XirophtDecentralizedAlgorithm_Solo_ComputePocShare(poc->Workspace, 1700000000, poc->Nonce++, &pocShareNonce, poc->PocShare);
+    }
+}
+
+DOTNET_PRIVATE void RunComputePocShares(void *state, DOTNET_INT iterations) {
+    POC_STATE *poc = state;
+    DOTNET_LONG nonces[BENCH_POC_BATCH_SIZE];
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        for (DOTNET_INT j = 0; j < BENCH_POC_BATCH_SIZE; j++) {
+            nonces[j] = poc->Nonce++;
+        }
+
+        XirophtDecentralizedAlgorithm_Solo_ComputePocShares(poc->Workspace, 1700000000, nonces, BENCH_POC_BATCH_SIZE, poc->PocShareNonces, poc->PocShares, poc->PocShareLengths);
+    }
+}
+
+/*
+ * Runner
+ */
+
+DOTNET_PRIVATE void AddSample(BENCH_THREAD *thread, DOTNET_DOUBLE nanosecondsPerOperation) {
+    if (thread->SamplesLength == thread->SamplesCapacity) {
+        DOTNET_INT capacity = thread->SamplesCapacity == 0 ? 1024 : thread->SamplesCapacity * 2;
+        DOTNET_DOUBLE *samples = realloc(thread->Samples, sizeof(DOTNET_DOUBLE) * capacity);
+
+        if (samples == NULL) {
+            return;
+        }
+
+        thread->Samples = samples;
+        thread->SamplesCapacity = capacity;
+    }
+
+    thread->Samples[thread->SamplesLength++] = nanosecondsPerOperation;
+}
+
+DOTNET_PRIVATE void *RunBenchThread(void *argument) {
+    BENCH_THREAD *thread = argument;
+    const BENCH_CASE *benchCase = thread->Case;
+
+    while (!__atomic_load_n(thread->Start, __ATOMIC_ACQUIRE)) {
+    }
+
+    // Grow the iterations per sample until one sample is long enough to time reliably, this doubles as the warm up.
+    DOTNET_INT iterations = 1;
+
+    while (DOTNET_TRUE) {
+        DOTNET_DOUBLE start = GetNanoseconds();
+        benchCase->Run(thread->State, iterations);
+
+        if (GetNanoseconds() - start >= BENCH_MIN_SAMPLE_NANOSECONDS || iterations >= 1 << 20) {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    DOTNET_DOUBLE begin = GetNanoseconds();
+    DOTNET_DOUBLE now = begin;
+
+    while (now - begin < thread->TimeNanoseconds) {
+        DOTNET_DOUBLE start = now;
+        benchCase->Run(thread->State, iterations);
+        now = GetNanoseconds();
+
+        DOTNET_LONG operations = (DOTNET_LONG) iterations * benchCase->OperationsPerIteration;
+
+        AddSample(thread, (now - start) / (DOTNET_DOUBLE) operations);
+        thread->Operations += operations;
+        thread->BusyNanoseconds += now - start;
+    }
+
+    thread->EndNanoseconds = now;
+
+    return NULL;
+}
+
+DOTNET_PRIVATE int CompareDouble(const void *left, const void *right) {
+    DOTNET_DOUBLE a = *(const DOTNET_DOUBLE *) left;
+    DOTNET_DOUBLE b = *(const DOTNET_DOUBLE *) right;
+    return (a > b) - (a < b);
+}
+
+DOTNET_PRIVATE DOTNET_DOUBLE GetPercentile(const DOTNET_DOUBLE *samples, DOTNET_INT samplesLength, DOTNET_DOUBLE percentile) {
+    if (samplesLength == 0) {
+        return 0;
+    }
+
+    DOTNET_INT index = (DOTNET_INT) (percentile / 100.0 * (samplesLength - 1) + 0.5);
+    return samples[index];
+}
+
+DOTNET_PRIVATE DOTNET_BOOL RunBenchCase(const BENCH_CASE *benchCase, const BENCH_OPTIONS *options, FILE *output, DOTNET_BOOL isFirst) {
+    BENCH_THREAD *threads = calloc(benchCase->Threads, sizeof(BENCH_THREAD));
+    DOTNET_INT start = 0;
+    DOTNET_BOOL isSuccess = threads != NULL;
+
+    for (DOTNET_INT i = 0; isSuccess && i < benchCase->Threads; i++) {
+        threads[i].Case = benchCase;
+        threads[i].Start = &start;
+        threads[i].TimeNanoseconds = options->TimeMilliseconds * 1e6;
+        threads[i].State = benchCase->Setup(benchCase);
+
+        isSuccess = threads[i].State != NULL;
+    }
+
+    DOTNET_INT startedThreads = 0;
+
+    for (; isSuccess && startedThreads < benchCase->Threads; startedThreads++) {
+        isSuccess = pthread_create(&threads[startedThreads].Thread, NULL, RunBenchThread, &threads[startedThreads]) == 0;
+    }
+
+    DOTNET_DOUBLE begin = GetNanoseconds();
+    __atomic_store_n(&start, 1, __ATOMIC_RELEASE);
+
+    DOTNET_LONG operations = 0;
+    DOTNET_DOUBLE busyNanoseconds = 0;
+    DOTNET_DOUBLE end = begin;
+    DOTNET_INT samplesLength = 0;
+
+    for (DOTNET_INT i = 0; i < startedThreads; i++) {
+        pthread_join(threads[i].Thread, NULL);
+
+        operations += threads[i].Operations;
+        busyNanoseconds += threads[i].BusyNanoseconds;
+        samplesLength += threads[i].SamplesLength;
+
+        if (threads[i].EndNanoseconds > end) {
+            end = threads[i].EndNanoseconds;
+        }
+    }
+
+    DOTNET_DOUBLE *samples = isSuccess ? malloc(sizeof(DOTNET_DOUBLE) * (samplesLength > 0 ? samplesLength : 1)) : NULL;
+
+    if (samples != NULL) {
+        DOTNET_INT offset = 0;
+
+        for (DOTNET_INT i = 0; i < startedThreads; i++) {
+            memcpy(samples + offset, threads[i].Samples, sizeof(DOTNET_DOUBLE) * threads[i].SamplesLength);
+            offset += threads[i].SamplesLength;
+        }
+
+        qsort(samples, samplesLength, sizeof(DOTNET_DOUBLE), CompareDouble);
+
+        // The wall time covers the warm up as well, so ops/sec is derived from the time each thread spent measuring.
+        DOTNET_DOUBLE operationsPerSecond = busyNanoseconds > 0 ? (DOTNET_DOUBLE) operations / (busyNanoseconds / startedThreads / 1e9) : 0;
+
+        fprintf(output, "%s\n    {\"name\": \"%s\", \"keySize\": %d, \"aesRound\": %d, \"dataLength\": %d, \"threads\": %d, ", isFirst ? "" : ",", benchCase->Name, benchCase->KeySize, benchCase->AesRound, benchCase->DataLength, benchCase->Threads);
+        fprintf(output, "\"operations\": %lld, \"seconds\": %.3f, \"opsPerSecond\": %.1f, ", (long long) operations, (end - begin) / 1e9, operationsPerSecond);
+        fprintf(output, "\"nsPerOp\": {\"mean\": %.1f, \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"min\": %.1f, \"max\": %.1f}}", operations > 0 ? busyNanoseconds / (DOTNET_DOUBLE) operations : 0, GetPercentile(samples, samplesLength, 50), GetPercentile(samples, samplesLength, 90), GetPercentile(samples, samplesLength, 99), GetPercentile(samples, samplesLength, 0), GetPercentile(samples, samplesLength, 100));
+        fflush(output);
+
+        fprintf(stderr, "%-36s key=%-3d rounds=%d length=%-5d threads=%-3d %14.1f ops/s\n", benchCase->Name, benchCase->KeySize, benchCase->AesRound, benchCase->DataLength, benchCase->Threads, operationsPerSecond);
+    } else {
+        fprintf(stderr, "%s: setup failed\n", benchCase->Name);
+    }
+
+    for (DOTNET_INT i = 0; threads != NULL && i < benchCase->Threads; i++) {
+        if (threads[i].State != NULL) {
+            benchCase->Teardown(threads[i].State);
+        }
+
+        free(threads[i].Samples);
+    }
+
+    free(samples);
+    free(threads);
+
+    return samples != NULL;
+}
+
+DOTNET_PRIVATE DOTNET_INT GetThreadCounts(DOTNET_INT maxThreads, DOTNET_INT *threadCounts) {
+    DOTNET_INT length = 0;
+
+    for (DOTNET_INT threads = 1; threads < maxThreads && length < BENCH_MAX_THREAD_COUNTS - 1; threads *= 2) {
+        threadCounts[length++] = threads;
+    }
+
+    threadCounts[length++] = maxThreads;
+
+    return length;
+}
+
+DOTNET_PRIVATE void PrintUsage() {
+    fprintf(stderr, "usage: xeno_native_bench [--threads N] [--time-ms MS] [--filter NAME] [--output FILE]\n");
+    fprintf(stderr, "       xeno_native_bench --verify [--iterations N] [--seed SEED]\n");
+}
+
+int main(int argc, char **argv) {
+    BENCH_OPTIONS options = {CpuInformationUtility_GetProcessorCount(), 500, NULL, NULL, DOTNET_FALSE, 1000, 1};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.MaxThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--time-ms") == 0 && i + 1 < argc) {
+            options.TimeMilliseconds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.Filter = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options.OutputPath = argv[++i];
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            options.IsVerify = DOTNET_TRUE;
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            options.VerifyIterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.VerifySeed = strtoull(argv[++i], NULL, 10);
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.MaxThreads <= 0) {
+        options.MaxThreads = 1;
+    }
+
+    if (!options.IsVerify && options.TimeMilliseconds <= 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    if (!CryptographyUtility_Initialize()) {
+        fprintf(stderr, "unable to fetch the openssl algorithms\n");
+        return 1;
+    }
+
+    if (options.IsVerify) {
+        DOTNET_BOOL isVerified = XenoNativeVerify_Run(options.VerifyIterations, options.VerifySeed) == 0;
+        CryptographyUtility_Shutdown();
+        return isVerified ? 0 : 1;
+    }
+
+    FILE *output = options.OutputPath != NULL ? fopen(options.OutputPath, "w") : stdout;
+
+    if (output == NULL) {
+        fprintf(stderr, "unable to open %s\n", options.OutputPath);
+        CryptographyUtility_Shutdown();
+        return 1;
+    }
+
+    fprintf(output, "{\n  \"processor\": \"%s\",\n  \"tier\": \"%s\",\n  \"kernels\": {", CpuInformationUtility_GetProcessorName(), CpuDispatchUtility_GetTierName());
+
+    for (DOTNET_INT i = 0; i < CPU_DISPATCH_PRIMITIVE_COUNT; i++) {
+        fprintf(output, "%s\"%s\": \"%s\"", i == 0 ? "" : ", ", CpuDispatchUtility_GetPrimitiveName(i), CpuDispatchUtility_GetKernelName(i));
+    }
+
+    fprintf(output, "},\n  \"maxThreads\": %d,\n  \"timeMs\": %d,\n  \"results\": [", options.MaxThreads, options.TimeMilliseconds);
+
+    DOTNET_INT threadCounts[BENCH_MAX_THREAD_COUNTS];
+    DOTNET_INT threadCountsLength = GetThreadCounts(options.MaxThreads, threadCounts);
+
+    static const DOTNET_INT KeySizes[] = {128, 192, 256};
+    static const DOTNET_INT AesRounds[] = {1, 2, 3, 4};
+    static const DOTNET_INT InputLengths[] = {24, 30, 36};
+
+    BENCH_CASE cases[1024];
+    DOTNET_INT casesLength = 0;
+
+    for (DOTNET_INT k = 0; k < 3; k++) {
+        for (DOTNET_INT r = 0; r < 4; r++) {
+            for (DOTNET_INT t = 0; t < threadCountsLength; t++) {
+                for (DOTNET_INT l = 0; l < 3; l++) {
+                    cases[casesLength++] = (BENCH_CASE) {"make_encrypted_share", SetupShare, RunMakeEncryptedShare, TeardownShare, 1, KeySizes[k], AesRounds[r], InputLengths[l], threadCounts[t]};
+                    cases[casesLength++] = (BENCH_CASE) {"make_encrypted_share_with_context", SetupShare, RunMakeEncryptedShareWithContext, TeardownShare, 1, KeySizes[k], AesRounds[r], InputLengths[l], threadCounts[t]};
+                }
+
+                cases[casesLength++] = (BENCH_CASE) {"make_encrypted_share_batch", SetupShare, RunMakeEncryptedShareBatch, TeardownShare, BENCH_SHARE_BATCH_SIZE, KeySizes[k], AesRounds[r], 24, threadCounts[t]};
+                cases[casesLength++] = (BENCH_CASE) {"make_encrypted_share_batch_common_first", SetupShare, RunMakeEncryptedShareBatchCommonFirst, TeardownShare, BENCH_SHARE_BATCH_SIZE, KeySizes[k], AesRounds[r], 24, threadCounts[t]};
+            }
+        }
+    }
+
+    cases[casesLength++] = (BENCH_CASE) {"generate_easy_block_numbers", SetupBlockNumbers, RunGenerateEasyBlockNumbers, free, 1, 0, 0, 1000000, 1};
+    cases[casesLength++] = (BENCH_CASE) {"generate_non_easy_block_numbers", SetupBlockNumbers, RunGenerateNonEasyBlockNumbers, free, 1, 0, 0, 65536, 1};
+    cases[casesLength++] = (BENCH_CASE) {"generate_random_block_number_pairs", SetupRandomPairs, RunGenerateRandomBlockNumberPairs, free, BENCH_RANDOM_PAIRS_LENGTH, 0, 0, 1000000000, 1};
+    cases[casesLength++] = (BENCH_CASE) {"generate_bias_random_block_number_pairs", SetupRandomPairs, RunGenerateBiasRandomBlockNumberPairs, free, BENCH_RANDOM_PAIRS_LENGTH, 0, 0, 1000000000, 1};
+
+    static const DOTNET_INT DataLengths[] = {64, 1024, 16384};
+
+    for (DOTNET_INT d = 0; d < 3; d++) {
+        cases[casesLength++] = (BENCH_CASE) {"base64_encode", SetupBuffer, RunBase64Encode, TeardownBuffer, 1, 0, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"base64_decode", SetupBuffer, RunBase64Decode, TeardownBuffer, 1, 0, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"aes_256_cfb8_encrypt", SetupBuffer, RunAes256Cfb8Encrypt, TeardownBuffer, 1, 256, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"aes_256_cfb8_decrypt", SetupBuffer, RunAes256Cfb8Decrypt, TeardownBuffer, 1, 256, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"packet_codec_encode", SetupPacketCodec, RunPacketCodecEncode, TeardownBuffer, 1, 256, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"packet_codec_decode", SetupPacketCodec, RunPacketCodecDecode, TeardownBuffer, 1, 256, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"sha2_512", SetupBuffer, RunSha2_512, TeardownBuffer, 1, 0, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"sha3_512", SetupBuffer, RunSha3_512, TeardownBuffer, 1, 0, 0, DataLengths[d], 1};
+        cases[casesLength++] = (BENCH_CASE) {"sha3_512_batch", SetupSha3_512Batch, RunSha3_512Batch, TeardownBuffer, BENCH_LANE_BATCH_SIZE, 0, 0, DataLengths[d], 1};
+    }
+
+    // Wallet address sized, the conversion is quadratic and addresses are all this short.
+    cases[casesLength++] = (BENCH_CASE) {"base58_encode", SetupBase58, RunBase58Encode, TeardownBuffer, 1, 0, 0, 64, 1};
+    cases[casesLength++] = (BENCH_CASE) {"base58_decode", SetupBase58, RunBase58Decode, TeardownBuffer, 1, 0, 0, 64, 1};
+    cases[casesLength++] = (BENCH_CASE) {"pbkdf1_sha1", SetupBuffer, RunPbkdf1, TeardownBuffer, 1, 0, 0, 32, 1};
+    cases[casesLength++] = (BENCH_CASE) {"pbkdf2_sha1", SetupBuffer, RunPbkdf2Sha1, TeardownBuffer, 1, 0, 0, 1000, 1};
+    cases[casesLength++] = (BENCH_CASE) {"pbkdf2_sha1_batch", SetupBuffer, RunPbkdf2Sha1Batch, TeardownBuffer, BENCH_PBKDF2_BATCH_SIZE, 0, 0, 1000, 1};
+
+    // The share pipeline always compresses the 8 byte nonce, the longer iv goes through lz4.
+    cases[casesLength++] = (BENCH_CASE) {"lz4_compress_nonce_iv", SetupBuffer, RunLz4CompressNonceIv, TeardownBuffer, 1, 0, 0, 8, 1};
+    cases[casesLength++] = (BENCH_CASE) {"lz4_compress_nonce_iv", SetupBuffer, RunLz4CompressNonceIv, TeardownBuffer, 1, 0, 0, 64, 1};
+
+    // Sized like the PoC random data of a typical wallet address, with four share iterations.
+    cases[casesLength++] = (BENCH_CASE) {"encrypted_poc_share", SetupEncryptedPocShare, RunEncryptedPocShare, TeardownBuffer, 1, 256, 4, 160, 1};
+
+    // Without AES instructions the lanes are not available and the workspace encrypts one share at a time like the case above.
+    if (AesMultiBufferUtility_GetLaneCount() > 0) {
+        cases[casesLength++] = (BENCH_CASE) {"encrypted_poc_share_batch", SetupEncryptedPocShare, RunEncryptedPocShareBatch, TeardownBuffer, BENCH_POC_BATCH_SIZE, 256, 4, 160, 1};
+    }
+
+    // The data length doubles as the number of SHA3-512 rounds and PBKDF2 iterations of the job.
+    static const DOTNET_INT PocRounds[] = {10, 100};
+
+    for (DOTNET_INT p = 0; p < 2; p++) {
+        cases[casesLength++] = (BENCH_CASE) {"xiropht_poc_share", SetupPocShare, RunComputePocShare, TeardownPocShare, 1, 256, 4, PocRounds[p], 1};
+        cases[casesLength++] = (BENCH_CASE) {"xiropht_poc_share_batch", SetupPocShare, RunComputePocShares, TeardownPocShare, BENCH_POC_BATCH_SIZE, 256, 4, PocRounds[p], 1};
+    }
+
+    DOTNET_BOOL isFirst = DOTNET_TRUE;
+    DOTNET_BOOL isSuccess = DOTNET_TRUE;
+
+    for (DOTNET_INT i = 0; i < casesLength; i++) {
+        if (options.Filter != NULL && strstr(cases[i].Name, options.Filter) == NULL) {
+            continue;
+        }
+
+        if (RunBenchCase(&cases[i], &options, output, isFirst)) {
+            isFirst = DOTNET_FALSE;
+        } else {
+            isSuccess = DOTNET_FALSE;
+        }
+    }
+
+    fprintf(output, "\n  ]\n}\n");
+
+    if (output != stdout) {
+        fclose(output);
+    }
+
+    CryptographyUtility_Shutdown();
+
+    return isSuccess ? 0 : 1;
+}
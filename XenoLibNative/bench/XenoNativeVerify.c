@@ -0,0 +1,1312 @@
+#include "XenoNativeVerify.h"
+#include "Algorithms/Xenophyte/Centralized/XenophyteCentralizedAlgorithm.h"
+#include "Algorithms/Xenophyte/Centralized/XenophyteCentralizedPacketCodec.h"
+#include "Algorithms/Xiropht/Decentralized/XirophtDecentralizedAlgorithm.h"
+#include "Utilities/AesMultiBufferUtility.h"
+#include "Utilities/Base58Utility.h"
+#include "Utilities/Base64Utility.h"
+#include "Utilities/CpuDispatchUtility.h"
+#include "Utilities/HexUtility.h"
+#include "Utilities/KeyDerivationFunctionUtility.h"
+#include "Utilities/MessageDigestUtility.h"
+#include "Utilities/RandomNumberGeneratorUtility.h"
+#include "Utilities/SymmetricAlgorithmUtility.h"
+
+#include "lz4.h"
+
+#include <stdio.h>
+
+#define VERIFY_MAX_REPORTED_FAILURES 20
+
+typedef struct VERIFY_GOLDEN_SHARE {
+    const char *Input;
+    DOTNET_INT XorKeyLength;
+    DOTNET_INT AesKeySize;
+    DOTNET_INT AesRound;
+    DOTNET_ULONG Seed;
+    const char *EncryptedShare;
+} VERIFY_GOLDEN_SHARE;
+
+// Captured from the scalar share implementation, the keys are expanded from the seed with SeedGenerator/FillRandomBytes.
+DOTNET_PRIVATE const VERIFY_GOLDEN_SHARE GoldenShares[] = {
+        {"1 + 11654187614", 128, 128, 1, 1, "98E958FEA83A6A20F014F9292F04AF7513B664D848CC88B782FD417F605EDAD493DA8FA740EEE97CA3640223C1D5B95AAEA976D1282DB8784C75D49098215313"},
+        {"12345678 - 876543211654187614", 128, 192, 2, 2, "FA2F1C9A8E895ADF23456A7E2950F619CC255C6CA12BDD946801AA1BA75433228CC64F2ACDBCE655C996A4967FEB22A1E7B5C475CA154E39F2CC22C10124C5DB"},
+        {"9223372036854775807 * 9223372036854775807", 128, 256, 2, 3, "E3106E7550AA4947B4B1DB6008E163452AEEEC607FE6DE7511D395C594EF0CB003811B6E21418B02289088082CC75608E0E95474C67B48A6217E962F1D15C030"},
+        {"-42 / 7", 37, 256, 0, 4, "4A9D2E2BCB9A1529CA7A27D5F4D87E0564ED3077141D4890DF8CF5168955784076116426CEF140547ED1F239E60FBEA8120A9A752968539867C3D832263D653E"},
+        {"100000 % 99991654187614", 1, 128, 3, 5, "6852CF4BC991517EDAB6CCFBDE807579F011C1F9FA65A887BB5592B6415B28A85CC482BD467D0C17B4A7180E358ADCF813F1C7DD3C587776BD46C25870DB8FB3"},
+        {"506 + 27731654187614", 96, 256, 4, 6, "59FA7217A57EED2B02FD3E92926532B9AD70E129DB615C71195CE660628245C4B8F55E5EECCC176965CB8598C23CCB2375202D81E15570FA708E4E7E67CF40FC"},
+};
+
+DOTNET_PRIVATE DOTNET_INT Failures;
+
+DOTNET_PRIVATE const DOTNET_BYTE UpperHexCharacters[] = "0123456789ABCDEF";
+
+DOTNET_PRIVATE void SeedGenerator(RANDOM_NUMBER_GENERATOR *generator, DOTNET_ULONG seed) {
+    // splitmix64, so nearby seeds still give unrelated xoshiro states.
+    for (DOTNET_INT i = 0; i < 4; i++) {
+        DOTNET_ULONG value = seed += 0x9E3779B97F4A7C15;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+        generator->State[i] = value ^ (value >> 31);
+    }
+}
+
+DOTNET_PRIVATE void FillRandomBytes(RANDOM_NUMBER_GENERATOR *generator, DOTNET_SPAN_BYTE output, DOTNET_INT length) {
+    for (DOTNET_INT i = 0; i < length; i++) {
+        output[i] = (DOTNET_BYTE) RandomNumberGeneratorUtility_NextULong(generator);
+    }
+}
+
+DOTNET_PRIVATE DOTNET_INT NextInt(RANDOM_NUMBER_GENERATOR *generator, DOTNET_INT minimumValue, DOTNET_INT maximumValue) {
+    return (DOTNET_INT) RandomNumberGeneratorUtility_GetRandomBetween(generator, minimumValue, maximumValue);
+}
+
+DOTNET_PRIVATE DOTNET_BOOL CompareBytes(const char *name, const char *parameters, DOTNET_READ_ONLY_SPAN_BYTE expected, DOTNET_READ_ONLY_SPAN_BYTE actual, DOTNET_INT length) {
+    for (DOTNET_INT i = 0; i < length; i++) {
+        if (expected[i] == actual[i]) {
+            continue;
+        }
+
+        if (Failures++ < VERIFY_MAX_REPORTED_FAILURES) {
+            fprintf(stderr, "FAIL %s (%s): first difference at byte %d of %d, expected %02X got %02X\n", name, parameters, i, length, expected[i], actual[i]);
+        }
+
+        return DOTNET_FALSE;
+    }
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_PRIVATE DOTNET_BOOL Check(const char *name, const char *parameters, DOTNET_BOOL condition) {
+    if (!condition && Failures++ < VERIFY_MAX_REPORTED_FAILURES) {
+        fprintf(stderr, "FAIL %s (%s)\n", name, parameters);
+    }
+
+    return condition;
+}
+
+/*
+ * Scalar reference
+ */
+
+DOTNET_PRIVATE void ReferenceHex(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_BOOL withDash, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_SPAN_BYTE output) {
+    DOTNET_INT outputLength = 0;
+
+    for (DOTNET_INT i = 0; i < inputLength; i++) {
+        output[outputLength++] = UpperHexCharacters[input[i] >> 4];
+        output[outputLength++] = UpperHexCharacters[input[i] & 15];
+
+        if (withDash && i < inputLength - 1) {
+            output[outputLength++] = '-';
+        }
+    }
+
+    for (DOTNET_INT i = 0; xorKey != NULL && i < outputLength; i++) {
+        output[i] ^= xorKey[i % xorKeyLength];
+    }
+}
+
+DOTNET_PRIVATE DOTNET_INT ReferenceEncryptCbc(DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    switch (aesKeySize) {
+        case 128:
+            return SymmetricAlgorithmUtility_Encrypt_AES_128_CBC(aesKey, aesIv, source, sourceLength, destination);
+
+        case 192:
+            return SymmetricAlgorithmUtility_Encrypt_AES_192_CBC(aesKey, aesIv, source, sourceLength, destination);
+
+        case 256:
+            return SymmetricAlgorithmUtility_Encrypt_AES_256_CBC(aesKey, aesIv, source, sourceLength, destination);
+
+        default:
+            return 0;
+    }
+}
+
+// The share algorithm exactly as the node computes it: hex and xor, aesRound + 1 cbc rounds each followed by hex with dashes, then sha512 twice.
+DOTNET_PRIVATE DOTNET_BOOL ReferenceMakeEncryptedShare(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE encryptedShare, DOTNET_SPAN_BYTE hashEncryptedShare, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound) {
+    DOTNET_INT capacity = inputLength * 2;
+
+    for (DOTNET_INT i = aesRound; i >= 0; i--) {
+        capacity += 16 - capacity % 16;
+        capacity = capacity * 3;
+    }
+
+    DOTNET_SPAN_BYTE current = malloc(capacity);
+    DOTNET_SPAN_BYTE encrypted = malloc(capacity);
+    DOTNET_BOOL isSuccess = current != NULL && encrypted != NULL;
+
+    DOTNET_INT currentLength = inputLength * 2;
+
+    if (isSuccess) {
+        ReferenceHex(input, inputLength, DOTNET_FALSE, xorKey, xorKeyLength, current);
+    }
+
+    for (DOTNET_INT i = aesRound; isSuccess && i >= 0; i--) {
+        DOTNET_INT encryptedLength = ReferenceEncryptCbc(aesKeySize, aesKey, aesIv, current, currentLength, encrypted);
+
+        if (encryptedLength == 0) {
+            isSuccess = DOTNET_FALSE;
+            break;
+        }
+
+        ReferenceHex(encrypted, encryptedLength, DOTNET_TRUE, i == 1 ? xorKey : NULL, xorKeyLength, current);
+        currentLength = encryptedLength * 3 - 1;
+    }
+
+    DOTNET_BYTE digest[64];
+
+    isSuccess = isSuccess && MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha512(), current, currentLength, digest);
+
+    if (isSuccess) {
+        ReferenceHex(digest, 64, DOTNET_FALSE, NULL, 0, encryptedShare);
+        isSuccess = MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha512(), encryptedShare, 64 * 2, digest);
+    }
+
+    if (isSuccess) {
+        ReferenceHex(digest, 64, DOTNET_FALSE, NULL, 0, hashEncryptedShare);
+    }
+
+    free(current);
+    free(encrypted);
+
+    return isSuccess;
+}
+
+/*
+ * Share checks
+ */
+
+DOTNET_PRIVATE void VerifyGoldenShares() {
+    for (DOTNET_INT i = 0; i < (DOTNET_INT) (sizeof(GoldenShares) / sizeof(GoldenShares[0])); i++) {
+        const VERIFY_GOLDEN_SHARE *golden = &GoldenShares[i];
+
+        RANDOM_NUMBER_GENERATOR generator;
+        DOTNET_BYTE xorKey[128], aesKey[32], aesIv[16];
+
+        SeedGenerator(&generator, golden->Seed);
+        FillRandomBytes(&generator, xorKey, golden->XorKeyLength);
+        FillRandomBytes(&generator, aesKey, sizeof(aesKey));
+        FillRandomBytes(&generator, aesIv, sizeof(aesIv));
+
+        char parameters[64];
+        snprintf(parameters, sizeof(parameters), "golden vector %d", i);
+
+        DOTNET_BYTE expected[64 * 2], actual[64 * 2], hashActual[64 * 2];
+        DOTNET_INT inputLength = (DOTNET_INT) strlen(golden->Input);
+
+        memcpy(expected, golden->EncryptedShare, 64 * 2);
+
+        if (Check("reference_share", parameters, ReferenceMakeEncryptedShare((DOTNET_READ_ONLY_SPAN_BYTE) golden->Input, inputLength, actual, hashActual, xorKey, golden->XorKeyLength, golden->AesKeySize, aesKey, aesIv, golden->AesRound))) {
+            CompareBytes("reference_share", parameters, expected, actual, 64 * 2);
+        }
+
+        if (Check("make_encrypted_share", parameters, XenophyteCentralizedAlgorithm_MakeEncryptedShare((DOTNET_READ_ONLY_SPAN_BYTE) golden->Input, inputLength, actual, hashActual, xorKey, golden->XorKeyLength, golden->AesKeySize, aesKey, aesIv, golden->AesRound))) {
+            CompareBytes("make_encrypted_share", parameters, expected, actual, 64 * 2);
+        }
+    }
+}
+
+DOTNET_PRIVATE void VerifyShares(RANDOM_NUMBER_GENERATOR *generator) {
+    static const DOTNET_INT AesKeySizes[] = {128, 192, 256};
+
+    DOTNET_BYTE xorKey[128], aesKey[32], aesIv[16];
+    DOTNET_INT xorKeyLength = NextInt(generator, 1, 128);
+    DOTNET_INT aesKeySize = AesKeySizes[NextInt(generator, 0, 2)];
+
+    // Five rounds and more are rare on the network and the reference grows threefold per round, keep them occasional.
+    DOTNET_INT aesRound = NextInt(generator, 0, 15) == 0 ? 4 : NextInt(generator, 0, 3);
+
+    FillRandomBytes(generator, xorKey, xorKeyLength);
+    FillRandomBytes(generator, aesKey, sizeof(aesKey));
+    FillRandomBytes(generator, aesIv, sizeof(aesIv));
+
+    XENOPHYTE_SHARE_CTX *ctx = XenophyteCentralizedAlgorithm_CreateShareContext(xorKey, xorKeyLength, aesKeySize, aesKey, aesIv, aesRound);
+
+    char parameters[96];
+    snprintf(parameters, sizeof(parameters), "key=%d rounds=%d xorKeyLength=%d", aesKeySize, aesRound, xorKeyLength);
+
+    if (!Check("create_share_context", parameters, ctx != NULL)) {
+        return;
+    }
+
+    // Batch candidates span several input lengths so both the full lane groups and the leftovers are exercised.
+    XENOPHYTE_SHARE_CANDIDATE candidates[AES_MULTI_BUFFER_MAX_LANES * 2 + 3];
+    DOTNET_INT candidatesLength = NextInt(generator, 1, sizeof(candidates) / sizeof(candidates[0]));
+    DOTNET_LONG timestamp = NextInt(generator, 0, DOTNET_INT_MAX);
+
+    // Long first numbers repeat across candidates so lane groups resume from a saved prefix, now and then a whole input repeats.
+    DOTNET_LONG sharedFirstNumbers[2];
+
+    for (DOTNET_INT i = 0; i < 2; i++) {
+        sharedFirstNumbers[i] = RandomNumberGeneratorUtility_GetRandomBetween(generator, 10000000, 1000000000000000000);
+    }
+
+    for (DOTNET_INT i = 0; i < candidatesLength; i++) {
+        if (i > 0 && NextInt(generator, 0, 7) == 0) {
+            candidates[i] = candidates[i - 1];
+            continue;
+        }
+
+        candidates[i].FirstNumber = NextInt(generator, 0, 1) == 0 ? sharedFirstNumbers[NextInt(generator, 0, 1)] : RandomNumberGeneratorUtility_GetRandomBetween(generator, -1000, 1000000);
+
+        // A long negative first number puts the only space of its group past the first stage 0 block.
+        if (NextInt(generator, 0, 7) == 0) {
+            candidates[i].FirstNumber = -RandomNumberGeneratorUtility_GetRandomBetween(generator, 100000000, 1000000000000000000);
+        }
+        candidates[i].SecondNumber = NextInt(generator, 0, 3) == 0 ? (DOTNET_LONG) RandomNumberGeneratorUtility_NextULong(generator) : RandomNumberGeneratorUtility_GetRandomBetween(generator, 1, 1000);
+        candidates[i].Solution = 0;
+        candidates[i].Operator = "+-*/%"[NextInt(generator, 0, 4)];
+    }
+
+    DOTNET_INT target = NextInt(generator, 0, candidatesLength - 1);
+
+    for (DOTNET_INT i = 0; i < candidatesLength; i++) {
+        char input[XENOPHYTE_SHARE_INPUT_MAX_LENGTH + 1];
+        DOTNET_INT inputLength = snprintf(input, sizeof(input), "%lld %c %lld%lld", (long long) candidates[i].FirstNumber, (char) candidates[i].Operator, (long long) candidates[i].SecondNumber, (long long) timestamp);
+
+        DOTNET_BYTE expected[64 * 2], hashExpected[64 * 2], actual[64 * 2], hashActual[64 * 2];
+
+        if (!Check("reference_share", parameters, ReferenceMakeEncryptedShare((DOTNET_READ_ONLY_SPAN_BYTE) input, inputLength, expected, hashExpected, xorKey, xorKeyLength, aesKeySize, aesKey, aesIv, aesRound))) {
+            break;
+        }
+
+        // Only a few candidates go through the one shot paths, they are the slow ones.
+        if (i < 2) {
+            if (Check("make_encrypted_share", parameters, XenophyteCentralizedAlgorithm_MakeEncryptedShare((DOTNET_READ_ONLY_SPAN_BYTE) input, inputLength, actual, hashActual, xorKey, xorKeyLength, aesKeySize, aesKey, aesIv, aesRound))) {
+                if (CompareBytes("make_encrypted_share", parameters, expected, actual, 64 * 2)) {
+                    CompareBytes("make_encrypted_share.hash", parameters, hashExpected, hashActual, 64 * 2);
+                }
+            }
+
+            if (Check("make_encrypted_share_with_context", parameters, XenophyteCentralizedAlgorithm_MakeEncryptedShareWithContext(ctx, (DOTNET_READ_ONLY_SPAN_BYTE) input, inputLength, actual, hashActual))) {
+                if (CompareBytes("make_encrypted_share_with_context", parameters, expected, actual, 64 * 2)) {
+                    CompareBytes("make_encrypted_share_with_context.hash", parameters, hashExpected, hashActual, 64 * 2);
+                }
+            }
+        }
+
+        if (i != target) {
+            continue;
+        }
+
+        XenophyteCentralizedAlgorithm_SetShareContextBlockIndication(ctx, hashExpected, 64 * 2);
+
+        DOTNET_INT matchIndices[AES_MULTI_BUFFER_MAX_LANES * 2 + 3];
+        DOTNET_BYTE matchEncryptedShares[(AES_MULTI_BUFFER_MAX_LANES * 2 + 3) * 64 * 2];
+        DOTNET_INT matches = XenophyteCentralizedAlgorithm_MakeEncryptedShareBatch(ctx, candidates, candidatesLength, timestamp, matchIndices, matchEncryptedShares, candidatesLength);
+
+        char batchParameters[160];
+        snprintf(batchParameters, sizeof(batchParameters), "%s candidates=%d target=%d", parameters, candidatesLength, target);
+
+        // Another candidate can only match as well if it formats to the exact same input.
+        DOTNET_BOOL isFound = DOTNET_FALSE;
+
+        for (DOTNET_INT m = 0; m < matches; m++) {
+            if (matchIndices[m] != target) {
+                continue;
+            }
+
+            isFound = DOTNET_TRUE;
+            CompareBytes("make_encrypted_share_batch", batchParameters, expected, matchEncryptedShares + m * 64 * 2, 64 * 2);
+        }
+
+        Check("make_encrypted_share_batch.match", batchParameters, matches > 0 && isFound);
+    }
+
+    // The context keeps no prefix for an input without a space, or whose only space lies past the first stage 0 block.
+    for (DOTNET_INT i = 0; i < 2; i++) {
+        char input[XENOPHYTE_SHARE_INPUT_MAX_LENGTH];
+        DOTNET_INT inputLength = NextInt(generator, i == 0 ? 1 : 10, XENOPHYTE_SHARE_INPUT_MAX_LENGTH);
+
+        for (DOTNET_INT j = 0; j < inputLength; j++) {
+            input[j] = (char) ('0' + NextInt(generator, 0, 9));
+        }
+
+        if (i == 1) {
+            input[NextInt(generator, 8, inputLength - 1)] = ' ';
+        }
+
+        char inputParameters[128];
+        snprintf(inputParameters, sizeof(inputParameters), "%s length=%d spaces=%d", parameters, inputLength, i);
+
+        DOTNET_BYTE expected[64 * 2], hashExpected[64 * 2], actual[64 * 2], hashActual[64 * 2];
+
+        if (!Check("reference_share", inputParameters, ReferenceMakeEncryptedShare((DOTNET_READ_ONLY_SPAN_BYTE) input, inputLength, expected, hashExpected, xorKey, xorKeyLength, aesKeySize, aesKey, aesIv, aesRound))) {
+            break;
+        }
+
+        if (Check("make_encrypted_share.separator", inputParameters, XenophyteCentralizedAlgorithm_MakeEncryptedShare((DOTNET_READ_ONLY_SPAN_BYTE) input, inputLength, actual, hashActual, xorKey, xorKeyLength, aesKeySize, aesKey, aesIv, aesRound))) {
+            if (CompareBytes("make_encrypted_share.separator", inputParameters, expected, actual, 64 * 2)) {
+                CompareBytes("make_encrypted_share.separator.hash", inputParameters, hashExpected, hashActual, 64 * 2);
+            }
+        }
+
+        if (Check("make_encrypted_share_with_context.separator", inputParameters, XenophyteCentralizedAlgorithm_MakeEncryptedShareWithContext(ctx, (DOTNET_READ_ONLY_SPAN_BYTE) input, inputLength, actual, hashActual))) {
+            if (CompareBytes("make_encrypted_share_with_context.separator", inputParameters, expected, actual, 64 * 2)) {
+                CompareBytes("make_encrypted_share_with_context.separator.hash", inputParameters, hashExpected, hashActual, 64 * 2);
+            }
+        }
+    }
+
+    XenophyteCentralizedAlgorithm_FreeShareContext(ctx);
+}
+
+/*
+ * Block number checks
+ */
+
+DOTNET_PRIVATE void VerifyBlockNumbers(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_LONG easyBlockNumbers[256];
+
+    // Small ranges are enumerated completely, large ones are sampled around every easy block number.
+    DOTNET_BOOL isSmallRange = NextInt(generator, 0, 3) != 0;
+    DOTNET_LONG minValue = RandomNumberGeneratorUtility_GetRandomBetween(generator, 0, 1000000);
+    DOTNET_LONG range = isSmallRange ? NextInt(generator, 1, 5000) : RandomNumberGeneratorUtility_GetRandomBetween(generator, 5000, (DOTNET_LONG) 1 << 40);
+    DOTNET_LONG maxValue = minValue + range - 1;
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "min=%lld max=%lld", (long long) minValue, (long long) maxValue);
+
+    DOTNET_INT easyBlockNumbersLength = XenophyteCentralizedAlgorithm_GenerateEasyBlockNumbers(minValue, maxValue, easyBlockNumbers);
+    DOTNET_LONG count = XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(minValue, maxValue);
+
+    if (!Check("non_easy_block_number_count", parameters, count == range - easyBlockNumbersLength)) {
+        return;
+    }
+
+    Check("is_easy_block_number.bounds", parameters, !XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, minValue - 1) && !XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, maxValue + 1));
+
+    if (isSmallRange) {
+        DOTNET_INT easyIndex = 0;
+        DOTNET_LONG nonEasyIndex = 0;
+
+        for (DOTNET_LONG value = minValue; value <= maxValue; value++) {
+            DOTNET_BOOL isEasy = easyIndex < easyBlockNumbersLength && easyBlockNumbers[easyIndex] == value;
+
+            if (!Check("is_easy_block_number", parameters, XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, value) == isEasy)) {
+                return;
+            }
+
+            if (isEasy) {
+                easyIndex++;
+                continue;
+            }
+
+            DOTNET_LONG nonEasyValue;
+
+            if (!Check("non_easy_block_number", parameters, XenophyteCentralizedAlgorithm_GetNonEasyBlockNumber(minValue, maxValue, nonEasyIndex++, &nonEasyValue) && nonEasyValue == value)) {
+                return;
+            }
+        }
+
+        return;
+    }
+
+    // Below easy block number i sit exactly (number - minValue - i) non easy numbers, the ones next to it are the closest to a mistake.
+    for (DOTNET_INT i = 0; i < easyBlockNumbersLength; i++) {
+        DOTNET_LONG index = easyBlockNumbers[i] - minValue - i;
+        DOTNET_LONG value;
+
+        Check("is_easy_block_number", parameters, XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, easyBlockNumbers[i]));
+
+        if (index > 0) {
+            Check("non_easy_block_number", parameters, XenophyteCentralizedAlgorithm_GetNonEasyBlockNumber(minValue, maxValue, index - 1, &value) && value == easyBlockNumbers[i] - 1);
+        }
+
+        if (index < count) {
+            Check("non_easy_block_number", parameters, XenophyteCentralizedAlgorithm_GetNonEasyBlockNumber(minValue, maxValue, index, &value) && value > easyBlockNumbers[i] && !XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, value));
+        }
+    }
+}
+
+DOTNET_PRIVATE void VerifyRandomBlockNumberPairs(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_LONG firstNumbers[512], secondNumbers[512], repeatedFirstNumbers[512], repeatedSecondNumbers[512];
+
+    // Block ranges start low, a high minimum with a narrow range makes the biased draw reject almost every digit count.
+    DOTNET_LONG minValue = NextInt(generator, 0, 1000);
+    DOTNET_LONG range = NextInt(generator, 0, 1) == 0 ? NextInt(generator, 1, 1000) : RandomNumberGeneratorUtility_GetRandomBetween(generator, 1000, (DOTNET_LONG) 1 << 40);
+    DOTNET_LONG maxValue = minValue + range - 1;
+    DOTNET_BOOL useXenophyteRandomizer = NextInt(generator, 0, 1);
+    DOTNET_INT length = NextInt(generator, 1, 512);
+    DOTNET_ULONG seed = RandomNumberGeneratorUtility_NextULong(generator) | 1;
+
+    char parameters[96];
+    snprintf(parameters, sizeof(parameters), "min=%lld max=%lld bias=%d length=%d", (long long) minValue, (long long) maxValue, useXenophyteRandomizer, length);
+
+    RANDOM_NUMBER_GENERATOR_LANES lanes;
+    RandomNumberGeneratorUtility_InitializeLanes(&lanes, seed);
+
+    DOTNET_INT generated = XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(&lanes, minValue, maxValue, useXenophyteRandomizer, firstNumbers, secondNumbers, length);
+
+    if (!Check("random_block_number_pairs.length", parameters, generated == (range > 256 ? length : 0)) || generated == 0) {
+        return;
+    }
+
+    for (DOTNET_INT i = 0; i < generated; i++) {
+        DOTNET_BOOL isFirstValid = firstNumbers[i] >= minValue && firstNumbers[i] <= maxValue && !XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, firstNumbers[i]);
+        DOTNET_BOOL isSecondValid = secondNumbers[i] >= minValue && secondNumbers[i] <= maxValue && !XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, secondNumbers[i]);
+
+        if (!Check("random_block_number_pairs", parameters, isFirstValid && isSecondValid)) {
+            return;
+        }
+    }
+
+    // The same seed has to give the same pairs whichever kernel advances the lanes.
+    RandomNumberGeneratorUtility_InitializeLanes(&lanes, seed);
+    XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(&lanes, minValue, maxValue, useXenophyteRandomizer, repeatedFirstNumbers, repeatedSecondNumbers, length);
+
+    CompareBytes("random_block_number_pairs.seeded", parameters, (DOTNET_READ_ONLY_SPAN_BYTE) firstNumbers, (DOTNET_READ_ONLY_SPAN_BYTE) repeatedFirstNumbers, (DOTNET_INT) sizeof(DOTNET_LONG) * length);
+    CompareBytes("random_block_number_pairs.seeded", parameters, (DOTNET_READ_ONLY_SPAN_BYTE) secondNumbers, (DOTNET_READ_ONLY_SPAN_BYTE) repeatedSecondNumbers, (DOTNET_INT) sizeof(DOTNET_LONG) * length);
+}
+
+/*
+ * Primitive checks
+ */
+
+DOTNET_PRIVATE void VerifyHex(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE input[600], keyStream[600 * 3], expected[600 * 3], actual[600 * 3];
+    DOTNET_INT inputLength = NextInt(generator, 1, sizeof(input));
+    DOTNET_BOOL hasKeyStream = NextInt(generator, 0, 1);
+
+    FillRandomBytes(generator, input, inputLength);
+    FillRandomBytes(generator, keyStream, inputLength * 3);
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "length=%d keyStream=%d", inputLength, hasKeyStream);
+
+    // A key stream of the full output length is the same as xoring with a key of that length.
+    ReferenceHex(input, inputLength, DOTNET_FALSE, hasKeyStream ? keyStream : NULL, inputLength * 2, expected);
+
+    HexUtility_ToUpperHex_Scalar(input, inputLength, hasKeyStream ? keyStream : NULL, actual);
+    CompareBytes("hex_scalar", parameters, expected, actual, inputLength * 2);
+
+    HexUtility_ToUpperHex(input, inputLength, hasKeyStream ? keyStream : NULL, actual);
+    CompareBytes("hex", parameters, expected, actual, inputLength * 2);
+
+    // The dashed kernels also write a trailing dash after the last byte.
+    ReferenceHex(input, inputLength, DOTNET_TRUE, hasKeyStream ? keyStream : NULL, inputLength * 3, expected);
+
+    HexUtility_ToUpperHexWithDash_Scalar(input, inputLength, hasKeyStream ? keyStream : NULL, actual);
+    CompareBytes("hex_with_dash_scalar", parameters, expected, actual, inputLength * 3 - 1);
+
+    HexUtility_ToUpperHexWithDash(input, inputLength, hasKeyStream ? keyStream : NULL, actual);
+    CompareBytes("hex_with_dash", parameters, expected, actual, inputLength * 3 - 1);
+}
+
+DOTNET_PRIVATE void VerifyAesMultiBuffer(RANDOM_NUMBER_GENERATOR *generator) {
+    static const DOTNET_INT AesKeySizes[] = {128, 192, 256};
+
+    // Without a multi-buffer kernel the share pipeline falls back to OpenSSL, which the share checks already cover.
+    if (AesMultiBufferUtility_GetLaneCount() == 0) {
+        return;
+    }
+
+    DOTNET_INT aesKeySize = AesKeySizes[NextInt(generator, 0, 2)];
+    DOTNET_INT lanes = NextInt(generator, 1, AES_MULTI_BUFFER_MAX_LANES + 4);
+    DOTNET_INT sourceLength = NextInt(generator, 0, 200);
+
+    DOTNET_BYTE aesKey[32], aesIv[16];
+    DOTNET_BYTE sources[AES_MULTI_BUFFER_MAX_LANES + 4][200];
+    DOTNET_BYTE destinations[AES_MULTI_BUFFER_MAX_LANES + 4][216];
+    DOTNET_BYTE expected[216];
+
+    const DOTNET_BYTE *sourcePointers[AES_MULTI_BUFFER_MAX_LANES + 4];
+    DOTNET_BYTE *destinationPointers[AES_MULTI_BUFFER_MAX_LANES + 4];
+
+    FillRandomBytes(generator, aesKey, sizeof(aesKey));
+    FillRandomBytes(generator, aesIv, sizeof(aesIv));
+
+    for (DOTNET_INT i = 0; i < lanes; i++) {
+        FillRandomBytes(generator, sources[i], sourceLength);
+        sourcePointers[i] = sources[i];
+        destinationPointers[i] = destinations[i];
+    }
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "key=%d lanes=%d length=%d", aesKeySize, lanes, sourceLength);
+
+    AES_MULTI_BUFFER_KEY key;
+
+    if (!Check("aes_multi_buffer_expand_key", parameters, AesMultiBufferUtility_ExpandKey(&key, aesKeySize, aesKey))) {
+        return;
+    }
+
+    DOTNET_INT destinationLength = AesMultiBufferUtility_Encrypt_CBC(&key, aesIv, sourcePointers, sourceLength, destinationPointers, lanes);
+
+    for (DOTNET_INT i = 0; i < lanes; i++) {
+        DOTNET_INT expectedLength = ReferenceEncryptCbc(aesKeySize, aesKey, aesIv, sources[i], sourceLength, expected);
+
+        if (!Check("aes_multi_buffer_cbc.length", parameters, destinationLength == expectedLength)) {
+            return;
+        }
+
+        CompareBytes("aes_multi_buffer_cbc", parameters, expected, destinations[i], expectedLength);
+    }
+}
+
+DOTNET_PRIVATE void VerifySha2_512(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_INT count = NextInt(generator, 1, SHA512_LANES_MAX_LANES);
+    DOTNET_INT sourceLengths[SHA512_LANES_MAX_LANES];
+
+    DOTNET_BYTE sources[SHA512_LANES_MAX_LANES][600];
+    DOTNET_BYTE destinations[SHA512_LANES_MAX_LANES][64];
+    DOTNET_BYTE expected[SHA512_LANES_MAX_LANES][64];
+
+    const DOTNET_BYTE *sourcePointers[SHA512_LANES_MAX_LANES];
+    DOTNET_BYTE *destinationPointers[SHA512_LANES_MAX_LANES];
+
+    // Half of the time every lane has the same length, like the share pipeline uses it.
+    DOTNET_BOOL isSameLength = NextInt(generator, 0, 1);
+    DOTNET_INT sameLength = NextInt(generator, 0, 600);
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        sourceLengths[i] = isSameLength ? sameLength : NextInt(generator, 0, 600);
+        FillRandomBytes(generator, sources[i], sourceLengths[i]);
+        MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha512(), sources[i], sourceLengths[i], expected[i]);
+
+        sourcePointers[i] = sources[i];
+        destinationPointers[i] = destinations[i];
+    }
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "count=%d sameLength=%d", count, isSameLength);
+
+    EVP_MD_CTX *context = EVP_MD_CTX_new();
+
+    if (Check("sha2_512_batch", parameters, MessageDigestUtility_ComputeSha2_512HashBatch(context, sourcePointers, sourceLengths, destinationPointers, count))) {
+        for (DOTNET_INT i = 0; i < count; i++) {
+            CompareBytes("sha2_512_batch", parameters, expected[i], destinations[i], 64);
+        }
+    }
+
+    EVP_MD_CTX_free(context);
+
+    if (!isSameLength) {
+        return;
+    }
+
+    // The lanes api takes the message in arbitrary pieces.
+    SHA512_LANES_CTX lanes;
+    MessageDigestUtility_Sha2_512Lanes_Init(&lanes, count);
+
+    for (DOTNET_INT offset = 0; offset < sameLength;) {
+        DOTNET_INT length = NextInt(generator, 1, sameLength - offset);
+
+        for (DOTNET_INT i = 0; i < count; i++) {
+            sourcePointers[i] = sources[i] + offset;
+        }
+
+        MessageDigestUtility_Sha2_512Lanes_Update(&lanes, sourcePointers, length);
+        offset += length;
+    }
+
+    if (Check("sha2_512_lanes", parameters, MessageDigestUtility_Sha2_512Lanes_Final(&lanes, destinationPointers))) {
+        for (DOTNET_INT i = 0; i < count; i++) {
+            CompareBytes("sha2_512_lanes", parameters, expected[i], destinations[i], 64);
+        }
+    }
+}
+
+DOTNET_PRIVATE void VerifySha3_512(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE source[1000], expected[64], actual[64];
+    DOTNET_INT sourceLength = NextInt(generator, 0, sizeof(source));
+
+    FillRandomBytes(generator, source, sourceLength);
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "length=%d", sourceLength);
+
+    MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha3_512(), source, sourceLength, expected);
+
+    if (Check("sha3_512", parameters, MessageDigestUtility_ComputeSha3_512Hash(source, sourceLength, actual))) {
+        CompareBytes("sha3_512", parameters, expected, actual, 64);
+    }
+
+    // Up to two full lane groups, hashed in place some of the time like the nonce iv rounds.
+    DOTNET_INT count = NextInt(generator, 1, 16);
+    DOTNET_INT rounds = NextInt(generator, 0, 3) == 0 ? NextInt(generator, 2, 20) : 1;
+    DOTNET_BOOL isInPlace = NextInt(generator, 0, 1);
+    DOTNET_INT sourceLengths[16];
+
+    DOTNET_BYTE sources[16][300];
+    DOTNET_BYTE destinations[16][64];
+    DOTNET_BYTE expectedDigests[16][64];
+
+    const DOTNET_BYTE *sourcePointers[16];
+    DOTNET_BYTE *destinationPointers[16];
+
+    DOTNET_BOOL isSameLength = NextInt(generator, 0, 1);
+    DOTNET_INT sameLength = NextInt(generator, isInPlace ? 64 : 0, 300);
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        sourceLengths[i] = isSameLength ? sameLength : NextInt(generator, isInPlace ? 64 : 0, 300);
+        FillRandomBytes(generator, sources[i], sourceLengths[i]);
+        MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha3_512(), sources[i], sourceLengths[i], expectedDigests[i]);
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha3_512(), expectedDigests[i], 64, expectedDigests[i]);
+        }
+
+        sourcePointers[i] = sources[i];
+        destinationPointers[i] = isInPlace ? sources[i] : destinations[i];
+    }
+
+    snprintf(parameters, sizeof(parameters), "count=%d rounds=%d sameLength=%d", count, rounds, isSameLength);
+
+    if (Check("sha3_512_batch", parameters, MessageDigestUtility_ComputeSha3_512HashBatch(sourcePointers, sourceLengths, destinationPointers, count, rounds))) {
+        for (DOTNET_INT i = 0; i < count; i++) {
+            CompareBytes("sha3_512_batch", parameters, expectedDigests[i], destinationPointers[i], 64);
+        }
+    }
+}
+
+DOTNET_PRIVATE void VerifyPbkdf2Sha1(RANDOM_NUMBER_GENERATOR *generator) {
+    // More than two lane groups, passwords longer than a block get hashed first and keys longer than a digest take several blocks.
+    DOTNET_INT count = NextInt(generator, 1, 40);
+    DOTNET_INT iterations = NextInt(generator, 0, 7) == 0 ? NextInt(generator, 100, 1000) : NextInt(generator, 1, 40);
+    DOTNET_INT saltLength = NextInt(generator, 0, 150);
+    DOTNET_INT keyLength = NextInt(generator, 1, 70);
+    DOTNET_BOOL isInPlace = NextInt(generator, 0, 1);
+
+    DOTNET_BYTE salt[150];
+    DOTNET_BYTE passwords[40][100];
+    DOTNET_BYTE destinations[40][100];
+    DOTNET_BYTE expected[40][70];
+    DOTNET_INT passwordLengths[40];
+
+    const DOTNET_BYTE *passwordPointers[40];
+    DOTNET_BYTE *destinationPointers[40];
+
+    FillRandomBytes(generator, salt, saltLength);
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        passwordLengths[i] = NextInt(generator, 0, 100);
+        FillRandomBytes(generator, passwords[i], passwordLengths[i]);
+        PKCS5_PBKDF2_HMAC_SHA1((const char *) passwords[i], passwordLengths[i], salt, saltLength, iterations, keyLength, expected[i]);
+
+        passwordPointers[i] = passwords[i];
+        destinationPointers[i] = isInPlace ? passwords[i] : destinations[i];
+    }
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "count=%d iterations=%d salt=%d key=%d", count, iterations, saltLength, keyLength);
+
+    if (Check("pbkdf2_sha1_batch", parameters, KeyDerivationFunctionUtility_ComputePbkdf2Sha1Batch(passwordPointers, passwordLengths, salt, saltLength, iterations, destinationPointers, keyLength, count))) {
+        for (DOTNET_INT i = 0; i < count; i++) {
+            CompareBytes("pbkdf2_sha1_batch", parameters, expected[i], destinationPointers[i], keyLength);
+        }
+    }
+}
+
+DOTNET_PRIVATE void VerifyAes256Cfb8(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE aesKey[32], aesIv[16];
+    DOTNET_BYTE source[1000 + 16], expected[1000 + 16], actual[1000 + 16];
+    DOTNET_INT sourceLength = NextInt(generator, 1, 1000);
+
+    FillRandomBytes(generator, aesKey, sizeof(aesKey));
+    FillRandomBytes(generator, aesIv, sizeof(aesIv));
+    FillRandomBytes(generator, source, sourceLength);
+
+    char parameters[32];
+    snprintf(parameters, sizeof(parameters), "length=%d", sourceLength);
+
+    // Like the managed side, the stream is padded with PKCS7 even though cfb8 does not need it.
+    DOTNET_INT paddingLength = 16 - sourceLength % 16;
+    DOTNET_INT expectedLength = 0;
+
+    memset(source + sourceLength, paddingLength, paddingLength);
+
+    EVP_CIPHER_CTX *context = EVP_CIPHER_CTX_new();
+    EVP_EncryptInit_ex(context, EVP_aes_256_cfb8(), NULL, aesKey, aesIv);
+    EVP_EncryptUpdate(context, expected, &expectedLength, source, sourceLength + paddingLength);
+    EVP_CIPHER_CTX_free(context);
+
+    if (Check("aes_256_cfb8_encrypt.length", parameters, SymmetricAlgorithmUtility_Encrypt_AES_256_CFB_8(aesKey, aesIv, source, sourceLength, actual) == expectedLength)) {
+        CompareBytes("aes_256_cfb8_encrypt", parameters, expected, actual, expectedLength);
+    }
+
+    if (Check("aes_256_cfb8_decrypt.length", parameters, SymmetricAlgorithmUtility_Decrypt_AES_256_CFB_8(aesKey, aesIv, expected, expectedLength, actual) == sourceLength)) {
+        CompareBytes("aes_256_cfb8_decrypt", parameters, source, actual, sourceLength);
+    }
+
+    // Any prefix of the stream decrypts on its own, short ones only use windows that reach back into the iv.
+    AES_MULTI_BUFFER_KEY expandedKey;
+    DOTNET_INT prefixLength = NextInt(generator, 1, NextInt(generator, 0, 1) == 0 && expectedLength > 32 ? 32 : expectedLength);
+
+    snprintf(parameters, sizeof(parameters), "length=%d", prefixLength);
+
+    if (AesMultiBufferUtility_ExpandKey(&expandedKey, 256, aesKey) && AesMultiBufferUtility_Decrypt_CFB8(&expandedKey, aesIv, expected, prefixLength, actual)) {
+        CompareBytes("aes_256_cfb8_decrypt_kernel", parameters, source, actual, prefixLength);
+    }
+}
+
+// Every iteration pads with PKCS7 and restarts cfb128 from the same iv, the way the PoC share is encrypted.
+DOTNET_PRIVATE DOTNET_INT ReferenceEncryptCfb128Iterations(DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT iterations, DOTNET_SPAN_BYTE data, DOTNET_INT dataLength) {
+    EVP_CIPHER_CTX *context = EVP_CIPHER_CTX_new();
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        DOTNET_INT paddingLength = 16 - dataLength % 16;
+
+        memset(data + dataLength, paddingLength, paddingLength);
+        dataLength += paddingLength;
+
+        EVP_EncryptInit_ex(context, EVP_aes_256_cfb128(), NULL, aesKey, aesIv);
+        EVP_EncryptUpdate(context, data, &dataLength, data, dataLength);
+    }
+
+    EVP_CIPHER_CTX_free(context);
+
+    return dataLength;
+}
+
+DOTNET_PRIVATE void VerifyAes256Cfb128Iterations(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE aesKey[32], aesIvs[AES_MULTI_BUFFER_MAX_LANES + 4][16];
+    DOTNET_BYTE sources[AES_MULTI_BUFFER_MAX_LANES + 4][300 + 6 * 16];
+    DOTNET_BYTE destinations[AES_MULTI_BUFFER_MAX_LANES + 4][300 + 6 * 16];
+    DOTNET_BYTE expected[300 + 6 * 16];
+    DOTNET_INT sourceLengths[AES_MULTI_BUFFER_MAX_LANES + 4], lengths[AES_MULTI_BUFFER_MAX_LANES + 4];
+
+    const DOTNET_BYTE *ivPointers[AES_MULTI_BUFFER_MAX_LANES + 4];
+    const DOTNET_BYTE *sourcePointers[AES_MULTI_BUFFER_MAX_LANES + 4];
+    DOTNET_BYTE *destinationPointers[AES_MULTI_BUFFER_MAX_LANES + 4];
+
+    DOTNET_INT lanes = NextInt(generator, 1, AES_MULTI_BUFFER_MAX_LANES + 4);
+    DOTNET_INT iterations = NextInt(generator, 0, 6);
+
+    // Half of the time the lanes are encrypted in place and share one length, like the PoC shares are.
+    DOTNET_BOOL isInPlace = NextInt(generator, 0, 1);
+    DOTNET_INT sameLength = NextInt(generator, 0, 300);
+
+    FillRandomBytes(generator, aesKey, sizeof(aesKey));
+
+    for (DOTNET_INT i = 0; i < lanes; i++) {
+        sourceLengths[i] = isInPlace ? sameLength : NextInt(generator, 0, 300);
+        lengths[i] = sourceLengths[i];
+
+        FillRandomBytes(generator, aesIvs[i], 16);
+        FillRandomBytes(generator, sources[i], sourceLengths[i]);
+
+        if (isInPlace) {
+            memcpy(destinations[i], sources[i], sourceLengths[i]);
+        }
+
+        ivPointers[i] = aesIvs[i];
+        sourcePointers[i] = isInPlace ? destinations[i] : sources[i];
+        destinationPointers[i] = destinations[i];
+    }
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "lanes=%d iterations=%d in_place=%d", lanes, iterations, isInPlace);
+
+    AES_MULTI_BUFFER_KEY expandedKey;
+
+    // Without AES instructions the kernel declines and the share pipeline stays on OpenSSL, which the PoC share checks cover.
+    if (AesMultiBufferUtility_ExpandKey(&expandedKey, 256, aesKey) && AesMultiBufferUtility_Encrypt_CFB128_Iterations(&expandedKey, ivPointers, iterations, sourcePointers, destinationPointers, lengths, lanes)) {
+        for (DOTNET_INT i = 0; i < lanes; i++) {
+            memcpy(expected, sources[i], sourceLengths[i]);
+
+            DOTNET_INT expectedLength = ReferenceEncryptCfb128Iterations(aesKey, aesIvs[i], iterations, expected, sourceLengths[i]);
+
+            if (!Check("aes_256_cfb128_iterations.length", parameters, lengths[i] == expectedLength)) {
+                return;
+            }
+
+            CompareBytes("aes_256_cfb128_iterations", parameters, expected, destinations[i], expectedLength);
+        }
+    } else {
+        Check("aes_256_cfb128_iterations.kernel", parameters, AesMultiBufferUtility_GetLaneCount() == 0);
+    }
+
+    // The instruction encrypts into the space right after the data and leaves the data itself alone.
+    DOTNET_BYTE data[300 + 300 + 6 * 16];
+    DOTNET_INT dataLength = sourceLengths[0];
+
+    memcpy(data, sources[0], dataLength);
+    memcpy(expected, sources[0], dataLength);
+
+    DOTNET_INT expectedLength = ReferenceEncryptCfb128Iterations(aesKey, aesIvs[0], iterations, expected, dataLength);
+
+    if (Check("xiropht_encrypted_poc_share", parameters, XirophtDecentralizedAlgorithm_Solo_DoEncryptedPocShareMiningInstruction(aesKey, aesIvs[0], iterations, data, &dataLength)) && Check("xiropht_encrypted_poc_share.length", parameters, dataLength == expectedLength)) {
+        CompareBytes("xiropht_encrypted_poc_share", parameters, expected, data + sourceLengths[0], expectedLength);
+        CompareBytes("xiropht_encrypted_poc_share.data", parameters, sources[0], data, sourceLengths[0]);
+    }
+}
+
+DOTNET_PRIVATE void VerifyBase64(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE source[1000], expected[1400], actual[1400], decoded[1000];
+    DOTNET_INT sourceLength = NextInt(generator, 1, sizeof(source));
+
+    FillRandomBytes(generator, source, sourceLength);
+
+    char parameters[32];
+    snprintf(parameters, sizeof(parameters), "length=%d", sourceLength);
+
+    DOTNET_INT expectedLength = EVP_EncodeBlock(expected, source, sourceLength);
+    DOTNET_INT actualLength = Base64Utility_Encode(source, sourceLength, actual);
+
+    if (Check("base64_encode.length", parameters, actualLength == expectedLength && Base64Utility_EncodeLength(sourceLength) == expectedLength)) {
+        CompareBytes("base64_encode", parameters, expected, actual, expectedLength);
+    }
+
+    if (Check("base64_decode.length", parameters, Base64Utility_DecodeLength(expected, expectedLength) == sourceLength && Base64Utility_Decode(expected, expectedLength, decoded) == sourceLength)) {
+        CompareBytes("base64_decode", parameters, source, decoded, sourceLength);
+    }
+
+    // A single character outside the alphabet anywhere, or a '=' before the last group, has to fail the whole decode.
+    DOTNET_INT position = NextInt(generator, 0, expectedLength - 1);
+    DOTNET_BYTE original = expected[position];
+    DOTNET_BYTE invalid;
+
+    do {
+        invalid = (DOTNET_BYTE) NextInt(generator, 0, 255);
+    } while ((invalid >= 'A' && invalid <= 'Z') || (invalid >= 'a' && invalid <= 'z') || (invalid >= '0' && invalid <= '9') || invalid == '+' || invalid == '/' || invalid == '=');
+
+    snprintf(parameters, sizeof(parameters), "length=%d position=%d", sourceLength, position);
+
+    expected[position] = invalid;
+    Check("base64_decode.invalid", parameters, Base64Utility_Decode(expected, expectedLength, decoded) == -1);
+
+    if (position < expectedLength - 4) {
+        expected[position] = '=';
+        Check("base64_decode.misplaced_padding", parameters, Base64Utility_Decode(expected, expectedLength, decoded) == -1);
+    }
+
+    expected[position] = original;
+}
+
+DOTNET_PRIVATE void VerifyPacketCodec(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE aesKey[32], aesIv[16];
+    DOTNET_BYTE packets[2][2000], cipherText[2000 + 16], expected[2800], stream[2 * 2800];
+    DOTNET_INT packetLengths[2], streamLength = 0;
+
+    FillRandomBytes(generator, aesKey, sizeof(aesKey));
+    FillRandomBytes(generator, aesIv, sizeof(aesIv));
+
+    XENOPHYTE_PACKET_CODEC *codec = XenophyteCentralizedPacketCodec_Create(aesKey, aesIv, 4096);
+
+    if (!Check("packet_codec_create", "", codec != NULL)) {
+        return;
+    }
+
+    char parameters[64];
+
+    // The fused encoder has to match encrypting, Base64 encoding and terminating in separate passes.
+    for (DOTNET_INT i = 0; i < 2; i++) {
+        packetLengths[i] = NextInt(generator, 1, sizeof(packets[i]));
+        FillRandomBytes(generator, packets[i], packetLengths[i]);
+
+        snprintf(parameters, sizeof(parameters), "length=%d", packetLengths[i]);
+
+        DOTNET_INT cipherTextLength = SymmetricAlgorithmUtility_Encrypt_AES_256_CFB_8(aesKey, aesIv, packets[i], packetLengths[i], cipherText);
+        DOTNET_INT expectedLength = Base64Utility_Encode(cipherText, cipherTextLength, expected);
+        expected[expectedLength++] = XENOPHYTE_PACKET_TERMINATOR;
+
+        DOTNET_INT actualLength = XenophyteCentralizedPacketCodec_Encode(codec, packets[i], packetLengths[i], stream + streamLength);
+
+        if (Check("packet_codec_encode.length", parameters, actualLength == expectedLength && XenophyteCentralizedPacketCodec_GetEncodeLength(packetLengths[i]) == expectedLength)) {
+            CompareBytes("packet_codec_encode", parameters, expected, stream + streamLength, expectedLength);
+        }
+
+        streamLength += actualLength;
+    }
+
+    // Both frames arrive back to back in random pieces, a piece can end inside a Base64 group or carry the start of the next frame.
+    DOTNET_INT offset = 0, pieceEnd = 0, decoded = 0;
+
+    while (offset < streamLength && decoded < 2) {
+        if (offset == pieceEnd) {
+            pieceEnd = offset + NextInt(generator, 1, streamLength - offset < 700 ? streamLength - offset : 700);
+        }
+
+        DOTNET_INT packetLength;
+        DOTNET_INT consumed = XenophyteCentralizedPacketCodec_Decode(codec, stream + offset, pieceEnd - offset, &packetLength);
+
+        snprintf(parameters, sizeof(parameters), "packet=%d offset=%d length=%d", decoded, offset, pieceEnd - offset);
+
+        if (!Check("packet_codec_decode.consumed", parameters, consumed > 0)) {
+            break;
+        }
+
+        offset += consumed;
+
+        if (packetLength < 0) {
+            continue;
+        }
+
+        if (Check("packet_codec_decode.length", parameters, packetLength == packetLengths[decoded])) {
+            CompareBytes("packet_codec_decode", parameters, packets[decoded], XenophyteCentralizedPacketCodec_GetPacket(codec), packetLength);
+        }
+
+        decoded++;
+    }
+
+    Check("packet_codec_decode.count", "", decoded == 2 && offset == streamLength);
+
+    // A frame that breaks off inside a Base64 group is rejected and the codec starts over on the next one.
+    DOTNET_INT packetLength;
+    DOTNET_BYTE malformed[] = {'Q', 'U', 'J', XENOPHYTE_PACKET_TERMINATOR};
+
+    Check("packet_codec_decode.malformed", "", XenophyteCentralizedPacketCodec_Decode(codec, malformed, sizeof(malformed), &packetLength) == -1);
+
+    XenophyteCentralizedPacketCodec_Free(codec);
+}
+
+DOTNET_PRIVATE DOTNET_INT ReferenceBase58Encode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    static const DOTNET_BYTE characters[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+    DOTNET_BYTE digits[200];
+    DOTNET_INT digitsLength = 0, zeros = 0;
+
+    while (zeros < inputLength && input[zeros] == 0) {
+        zeros++;
+    }
+
+    // Byte by byte schoolbook conversion, the digits are kept least significant first.
+    for (DOTNET_INT i = zeros; i < inputLength; i++) {
+        DOTNET_UINT carry = input[i];
+
+        for (DOTNET_INT j = 0; j < digitsLength; j++) {
+            carry += (DOTNET_UINT) digits[j] << 8;
+            digits[j] = carry % 58;
+            carry /= 58;
+        }
+
+        while (carry > 0) {
+            digits[digitsLength++] = carry % 58;
+            carry /= 58;
+        }
+    }
+
+    DOTNET_INT outputLength = 0;
+
+    for (; outputLength < zeros; outputLength++) {
+        output[outputLength] = '1';
+    }
+
+    while (digitsLength > 0) {
+        output[outputLength++] = characters[digits[--digitsLength]];
+    }
+
+    return outputLength;
+}
+
+DOTNET_PRIVATE void VerifyBase58(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE source[128], expected[200], actual[200], decoded[200];
+    DOTNET_INT sourceLength = NextInt(generator, 1, 100);
+    DOTNET_INT zeros = NextInt(generator, 0, 3);
+
+    FillRandomBytes(generator, source, sourceLength);
+    memset(source, 0, zeros < sourceLength ? zeros : sourceLength);
+
+    char parameters[64];
+    snprintf(parameters, sizeof(parameters), "length=%d zeros=%d", sourceLength, zeros);
+
+    DOTNET_INT expectedLength = ReferenceBase58Encode(source, sourceLength, expected);
+    DOTNET_INT actualLength = Base58Utility_Encode(source, sourceLength, actual);
+
+    if (Check("base58_encode.length", parameters, actualLength == expectedLength && actualLength <= Base58Utility_EncodeLength(sourceLength))) {
+        CompareBytes("base58_encode", parameters, expected, actual, expectedLength);
+    }
+
+    if (Check("base58_decode.length", parameters, Base58Utility_Decode(expected, expectedLength, decoded) == sourceLength && sourceLength <= Base58Utility_DecodeLength(expectedLength))) {
+        CompareBytes("base58_decode", parameters, source, decoded, sourceLength);
+    }
+
+    // 0, O, I and l are left out of the alphabet.
+    static const DOTNET_BYTE invalidCharacters[] = {'0', 'O', 'I', 'l', '+', '/', '=', ' ', 0x80, 0xff};
+    DOTNET_INT position = NextInt(generator, 0, expectedLength - 1);
+    DOTNET_BYTE original = expected[position];
+
+    expected[position] = invalidCharacters[NextInt(generator, 0, sizeof(invalidCharacters) - 1)];
+    Check("base58_decode.invalid", parameters, Base58Utility_Decode(expected, expectedLength, decoded) == -1);
+    expected[position] = original;
+
+    // A checksummed address, the same one with a changed character and the same one outside the length bounds.
+    DOTNET_BYTE hash[32];
+    EVP_Digest(source, sourceLength, hash, NULL, EVP_sha256(), NULL);
+    EVP_Digest(hash, sizeof(hash), hash, NULL, EVP_sha256(), NULL);
+    memcpy(source + sourceLength, hash, BASE58_CHECKSUM_LENGTH);
+
+    DOTNET_BYTE addresses[3 * 200];
+    DOTNET_INT addressLengths[3];
+    DOTNET_BOOL results[3];
+
+    addressLengths[0] = ReferenceBase58Encode(source, sourceLength + BASE58_CHECKSUM_LENGTH, addresses);
+    addressLengths[1] = addressLengths[0];
+    addressLengths[2] = addressLengths[0];
+
+    memcpy(addresses + addressLengths[0], addresses, addressLengths[0]);
+    memcpy(addresses + 2 * addressLengths[0], addresses, addressLengths[0]);
+
+    position = addressLengths[0] + NextInt(generator, zeros < sourceLength ? zeros : sourceLength, addressLengths[0] - 1);
+    addresses[position] = addresses[position] == 'z' ? 'y' : 'z';
+
+    DOTNET_INT validCount = Base58Utility_ValidateWalletAddresses(addresses, addressLengths, 3, 1, addressLengths[0], DOTNET_TRUE, results);
+    Check("base58_validate_wallet_addresses", parameters, validCount == 2 && results[0] && !results[1] && results[2]);
+
+    validCount = Base58Utility_ValidateWalletAddresses(addresses, addressLengths, 1, addressLengths[0] + 1, addressLengths[0] + 10, DOTNET_FALSE, results);
+    Check("base58_validate_wallet_addresses.length", parameters, validCount == 0 && !results[0]);
+}
+
+// The frame as the instruction used to build it, with a freshly cleared lz4 state for every call.
+DOTNET_PRIVATE DOTNET_INT ReferenceLz4Frame(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE frame) {
+    DOTNET_INT compressedSize = LZ4_compress_default((const char *) source, (char *) frame + 8, sourceLength, LZ4_COMPRESSBOUND(sourceLength));
+
+    if (compressedSize <= 0 || compressedSize >= sourceLength) {
+        compressedSize = sourceLength;
+        memcpy(frame + 8, source, sourceLength);
+    }
+
+    memcpy(frame, &sourceLength, sizeof(DOTNET_INT));
+    memcpy(frame + 4, &compressedSize, sizeof(DOTNET_INT));
+
+    return compressedSize + 8;
+}
+
+DOTNET_PRIVATE void VerifyLz4CompressNonceIv(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE source[300], expected[8 + LZ4_COMPRESSBOUND(300)], actual[300 * 2 + 8];
+
+    // Short ivs skip lz4, the longer ones are made of a few repeated pieces half the time so that they compress.
+    for (DOTNET_INT i = 0; i < 2; i++) {
+        DOTNET_INT sourceLength = NextInt(generator, 0, 1) == 0 ? NextInt(generator, 0, 20) : NextInt(generator, 0, sizeof(source));
+        DOTNET_INT pieceLength = NextInt(generator, 0, 1) == 0 ? NextInt(generator, 1, 8) : (DOTNET_INT) sizeof(source);
+
+        FillRandomBytes(generator, source, pieceLength < sourceLength ? pieceLength : sourceLength);
+
+        for (DOTNET_INT j = pieceLength; j < sourceLength; j++) {
+            source[j] = source[j - pieceLength];
+        }
+
+        char parameters[48];
+        snprintf(parameters, sizeof(parameters), "length=%d piece=%d", sourceLength, pieceLength);
+
+        DOTNET_INT expectedLength = ReferenceLz4Frame(source, sourceLength, expected);
+        DOTNET_INT actualLength = sourceLength;
+
+        memcpy(actual, source, sourceLength);
+        XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(actual, &actualLength);
+
+        if (Check("xiropht_lz4_compress_nonce_iv.length", parameters, actualLength == expectedLength)) {
+            CompareBytes("xiropht_lz4_compress_nonce_iv", parameters, expected, actual, expectedLength);
+        }
+    }
+}
+
+// Runs the instructions one call at a time like the managed miner did, then encrypts the share with OpenSSL directly.
+DOTNET_PRIVATE DOTNET_INT ReferencePocShare(const XIROPHT_POC_JOB *job, DOTNET_LONG timestamp, DOTNET_LONG nonce, DOTNET_LONG *pocShareNonce, DOTNET_SPAN_BYTE pocShare) {
+    DOTNET_BYTE pocRandomData[256] = {0}, pocShareIv[256], pocShareWorkToDoBytes[512];
+    DOTNET_INT pocRandomDataLength = 32 + job->ChecksumSize + job->WalletAddressLength;
+    DOTNET_INT pocShareIvSize = pocRandomDataLength;
+
+    XirophtDecentralizedAlgorithm_Solo_GeneratePocRandomData(pocRandomData, job->RandomNumber, job->RandomNumber2, timestamp, job->ChecksumSize, job->WalletAddress, job->WalletAddressLength, job->BlockHeight, nonce);
+    memcpy(pocShareIv, pocRandomData, pocRandomDataLength);
+
+    XirophtDecentralizedAlgorithm_Solo_DoNonceIvMiningInstruction(pocShareIv, &pocShareIvSize, job->PocRoundShaNonce);
+    XirophtDecentralizedAlgorithm_Solo_DoNonceIvXorMiningInstruction(pocShareIv, pocShareIvSize);
+
+    if (!XirophtDecentralizedAlgorithm_Solo_DoNonceIvEasySquareMathMiningInstruction(job->PocShareNonceMaxSquareRetry, job->PocShareNonceNoSquareFoundShaRounds, job->PocShareNonceMin, job->PocShareNonceMax, job->BlockHeight, pocShareIv, &pocShareIvSize, pocShareWorkToDoBytes, job->BlockDifficulty, job->BlockDifficultyLength, job->PreviousFinalBlockTransactionHashKey, job->PreviousFinalBlockTransactionHashKeyLength)) {
+        return 0;
+    }
+
+    memcpy(pocShareNonce, pocShareIv, sizeof(DOTNET_LONG));
+
+    XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(pocShareIv, &pocShareIvSize);
+    PKCS5_PBKDF2_HMAC_SHA1((const char *) pocShareIv, pocShareIvSize, job->BlockchainMarkKey, job->BlockchainMarkKeyLength, job->PocShareNonceIvIteration, XIROPHT_POC_SHARE_IV_LENGTH, pocShareIv);
+
+    DOTNET_INT pocShareLength = pocRandomDataLength;
+    memcpy(pocShare, pocRandomData, pocShareLength);
+
+    EVP_CIPHER_CTX *context = EVP_CIPHER_CTX_new();
+
+    for (DOTNET_INT i = 0; i < job->PocShareIterations; i++) {
+        DOTNET_INT paddingLength = 16 - pocShareLength % 16;
+
+        memset(pocShare + pocShareLength, paddingLength, paddingLength);
+        pocShareLength += paddingLength;
+
+        EVP_EncryptInit_ex(context, EVP_aes_256_cfb128(), NULL, job->PocShareKey, pocShareIv);
+        EVP_EncryptUpdate(context, pocShare, &pocShareLength, pocShare, pocShareLength);
+    }
+
+    EVP_CIPHER_CTX_free(context);
+
+    return pocShareLength;
+}
+
+DOTNET_PRIVATE void VerifyPocShare(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_BYTE walletAddress[96], blockDifficulty[32], previousFinalBlockTransactionHashKey[128], blockchainMarkKey[64], pocShareKey[32];
+    DOTNET_BYTE expected[256 + 4 * 16], actual[256 + 4 * 16];
+    XIROPHT_POC_JOB job;
+
+    job.RandomNumber = NextInt(generator, 0, DOTNET_INT_MAX);
+    job.RandomNumber2 = NextInt(generator, 0, DOTNET_INT_MAX);
+    job.ChecksumSize = NextInt(generator, 0, 64);
+    job.WalletAddress = walletAddress;
+    job.WalletAddressLength = NextInt(generator, 1, sizeof(walletAddress));
+    job.BlockHeight = NextInt(generator, 1, DOTNET_INT_MAX);
+    job.PocRoundShaNonce = NextInt(generator, 0, 8);
+    job.PocShareNonceMaxSquareRetry = NextInt(generator, 0, 4);
+    job.PocShareNonceNoSquareFoundShaRounds = NextInt(generator, 0, 8);
+    job.PocShareNonceMin = NextInt(generator, 0, DOTNET_INT_MAX / 4);
+    job.PocShareNonceMax = job.PocShareNonceMin + NextInt(generator, 0, DOTNET_INT_MAX) * 2LL;
+    job.BlockDifficulty = blockDifficulty;
+    job.BlockDifficultyLength = NextInt(generator, 1, sizeof(blockDifficulty));
+    job.PreviousFinalBlockTransactionHashKey = previousFinalBlockTransactionHashKey;
+    job.PreviousFinalBlockTransactionHashKeyLength = NextInt(generator, 1, sizeof(previousFinalBlockTransactionHashKey));
+    job.BlockchainMarkKey = blockchainMarkKey;
+    job.BlockchainMarkKeyLength = NextInt(generator, 1, sizeof(blockchainMarkKey));
+    job.PocShareNonceIvIteration = NextInt(generator, 1, 8);
+    job.PocShareKey = pocShareKey;
+    job.PocShareIterations = NextInt(generator, 0, 4);
+
+    FillRandomBytes(generator, walletAddress, job.WalletAddressLength);
+    FillRandomBytes(generator, blockDifficulty, job.BlockDifficultyLength);
+    FillRandomBytes(generator, previousFinalBlockTransactionHashKey, job.PreviousFinalBlockTransactionHashKeyLength);
+    FillRandomBytes(generator, blockchainMarkKey, job.BlockchainMarkKeyLength);
+    FillRandomBytes(generator, pocShareKey, sizeof(pocShareKey));
+
+    char parameters[96];
+    snprintf(parameters, sizeof(parameters), "rounds=%d retry=%d iterations=%d", job.PocRoundShaNonce, job.PocShareNonceMaxSquareRetry, job.PocShareIterations);
+
+    // The workspace keeps its own copies, so it is created from scratch buffers that are wiped right after.
+    DOTNET_BYTE scratch[sizeof(walletAddress) + sizeof(blockDifficulty) + sizeof(previousFinalBlockTransactionHashKey) + sizeof(blockchainMarkKey) + sizeof(pocShareKey)];
+    XIROPHT_POC_JOB scratchJob = job;
+
+    memcpy(scratch, walletAddress, sizeof(walletAddress));
+    memcpy(scratch + 96, blockDifficulty, sizeof(blockDifficulty));
+    memcpy(scratch + 128, previousFinalBlockTransactionHashKey, sizeof(previousFinalBlockTransactionHashKey));
+    memcpy(scratch + 256, blockchainMarkKey, sizeof(blockchainMarkKey));
+    memcpy(scratch + 320, pocShareKey, sizeof(pocShareKey));
+
+    scratchJob.WalletAddress = scratch;
+    scratchJob.BlockDifficulty = scratch + 96;
+    scratchJob.PreviousFinalBlockTransactionHashKey = scratch + 128;
+    scratchJob.BlockchainMarkKey = scratch + 256;
+    scratchJob.PocShareKey = scratch + 320;
+
+    XIROPHT_POC_WORKSPACE *workspace = XirophtDecentralizedAlgorithm_Solo_CreatePocWorkspace(&scratchJob);
+    memset(scratch, 0, sizeof(scratch));
+
+    if (!Check("xiropht_poc_workspace", parameters, workspace != NULL)) {
+        return;
+    }
+
+    for (DOTNET_INT i = 0; i < 3; i++) {
+        DOTNET_LONG timestamp = NextInt(generator, 0, DOTNET_INT_MAX);
+        DOTNET_LONG nonce = NextInt(generator, 0, DOTNET_INT_MAX);
+        DOTNET_LONG expectedNonce = 0, actualNonce = 0;
+
+        DOTNET_INT expectedLength = ReferencePocShare(&job, timestamp, nonce, &expectedNonce, expected);
+        DOTNET_INT actualLength = XirophtDecentralizedAlgorithm_Solo_ComputePocShare(workspace, timestamp, nonce, &actualNonce, actual);
+
+        if (!Check("xiropht_poc_share.length", parameters, actualLength == expectedLength && (expectedLength == 0 || expectedLength == XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(workspace)))) {
+            break;
+        }
+
+        if (expectedLength != 0 && Check("xiropht_poc_share.nonce", parameters, actualNonce == expectedNonce)) {
+            CompareBytes("xiropht_poc_share", parameters, expected, actual, expectedLength);
+        }
+    }
+
+    // More nonces than lanes, so the last group is partial and the lanes finish the square math at different retries.
+    DOTNET_LONG timestamp = NextInt(generator, 0, DOTNET_INT_MAX);
+    DOTNET_LONG nonces[20], actualNonces[20];
+    DOTNET_INT actualLengths[20];
+    DOTNET_INT count = NextInt(generator, 1, 20);
+    DOTNET_INT pocShareLength = XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(workspace);
+    DOTNET_SPAN_BYTE actualShares = malloc(count * pocShareLength);
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        nonces[i] = NextInt(generator, 0, DOTNET_INT_MAX);
+    }
+
+    if (actualShares != NULL && Check("xiropht_poc_shares", parameters, XirophtDecentralizedAlgorithm_Solo_ComputePocShares(workspace, timestamp, nonces, count, actualNonces, actualShares, actualLengths))) {
+        for (DOTNET_INT i = 0; i < count; i++) {
+            DOTNET_LONG expectedNonce = 0;
+            DOTNET_INT expectedLength = ReferencePocShare(&job, timestamp, nonces[i], &expectedNonce, expected);
+
+            if (!Check("xiropht_poc_shares.length", parameters, actualLengths[i] == expectedLength)) {
+                break;
+            }
+
+            if (expectedLength != 0 && Check("xiropht_poc_shares.nonce", parameters, actualNonces[i] == expectedNonce)) {
+                CompareBytes("xiropht_poc_shares", parameters, expected, actualShares + i * pocShareLength, expectedLength);
+            }
+        }
+    }
+
+    free(actualShares);
+    XirophtDecentralizedAlgorithm_Solo_FreePocWorkspace(workspace);
+}
+
+DOTNET_PRIVATE void VerifyRandomLanes(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_ULONG expected[300], actual[300];
+
+    RANDOM_NUMBER_GENERATOR_LANES lanes;
+    RandomNumberGeneratorUtility_InitializeLanes(&lanes, RandomNumberGeneratorUtility_NextULong(generator) | 1);
+
+    // Every lane is a plain xoshiro256** stream, the single stream generator is the reference.
+    RANDOM_NUMBER_GENERATOR references[RANDOM_NUMBER_GENERATOR_LANE_COUNT];
+
+    for (DOTNET_INT lane = 0; lane < RANDOM_NUMBER_GENERATOR_LANE_COUNT; lane++) {
+        for (DOTNET_INT i = 0; i < 4; i++) {
+            references[lane].State[i] = lanes.State[i][lane];
+        }
+    }
+
+    // Odd lengths move between the buffered values and the direct fill.
+    DOTNET_INT position = 0;
+
+    for (DOTNET_INT chunk = 0; chunk < 4; chunk++) {
+        DOTNET_INT length = NextInt(generator, 1, 300);
+
+        for (DOTNET_INT i = 0; i < length; i++) {
+            expected[i] = RandomNumberGeneratorUtility_NextULong(&references[(position + i) % RANDOM_NUMBER_GENERATOR_LANE_COUNT]);
+        }
+
+        RandomNumberGeneratorUtility_FillULong(&lanes, actual, length);
+
+        char parameters[64];
+        snprintf(parameters, sizeof(parameters), "position=%d length=%d", position, length);
+
+        if (!CompareBytes("random_lanes", parameters, (DOTNET_READ_ONLY_SPAN_BYTE) expected, (DOTNET_READ_ONLY_SPAN_BYTE) actual, (DOTNET_INT) sizeof(DOTNET_ULONG) * length)) {
+            return;
+        }
+
+        position += length;
+    }
+}
+
+DOTNET_INT XenoNativeVerify_Run(DOTNET_INT iterations, DOTNET_ULONG seed) {
+    Failures = 0;
+
+    fprintf(stderr, "verifying tier %s, seed %llu, %d iterations\n", CpuDispatchUtility_GetTierName(), (unsigned long long) seed, iterations);
+
+    VerifyGoldenShares();
+
+    RANDOM_NUMBER_GENERATOR generator;
+    SeedGenerator(&generator, seed);
+
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        VerifyShares(&generator);
+        VerifyBlockNumbers(&generator);
+        VerifyRandomBlockNumberPairs(&generator);
+        VerifyHex(&generator);
+        VerifyAesMultiBuffer(&generator);
+        VerifySha2_512(&generator);
+        VerifySha3_512(&generator);
+        VerifyPbkdf2Sha1(&generator);
+        VerifyAes256Cfb8(&generator);
+        VerifyAes256Cfb128Iterations(&generator);
+        VerifyBase64(&generator);
+        VerifyBase58(&generator);
+        VerifyPacketCodec(&generator);
+        VerifyLz4CompressNonceIv(&generator);
+        VerifyPocShare(&generator);
+        VerifyRandomLanes(&generator);
+    }
+
+    fprintf(stderr, "%d mismatches\n", Failures);
+
+    return Failures;
+}
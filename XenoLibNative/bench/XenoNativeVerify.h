@@ -0,0 +1,10 @@
+#ifndef XENONATIVEVERIFY_H
+#define XENONATIVEVERIFY_H
+
+#include "global.h"
+
+// Runs the golden vectors, then compares every optimized kernel against the scalar reference on random inputs.
+// Returns the number of mismatches, the first diverging byte of each is printed to stderr.
+DOTNET_INT XenoNativeVerify_Run(DOTNET_INT iterations, DOTNET_ULONG seed);
+
+#endif
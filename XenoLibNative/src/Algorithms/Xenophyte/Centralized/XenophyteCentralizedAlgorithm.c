@@ -1,73 +1,88 @@
 #include "XenophyteCentralizedAlgorithm.h"
+#include "Utilities/CryptographyUtility.h"
+#include "Utilities/HexUtility.h"
 #include "Utilities/MessageDigestUtility.h"
 #include "Utilities/SymmetricAlgorithmUtility.h"
 
-DOTNET_PRIVATE DOTNET_BYTE Base16Characters[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+// Bytes a stage collects before it encrypts them, its hex-with-dash output has to fit into the xor key stream window.
+#define XENOPHYTE_SHARE_STAGE_CHUNK_LENGTH 128
+#define XENOPHYTE_SHARE_STAGE_PENDING_LENGTH (XENOPHYTE_SHARE_STAGE_CHUNK_LENGTH + 16)
+#define XENOPHYTE_SHARE_STAGE_ENCODED_LENGTH (XENOPHYTE_SHARE_STAGE_PENDING_LENGTH * 3)
 
-DOTNET_PRIVATE void ConvertByteArrayToHex(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
-    for (DOTNET_INT i = inputLength - 1; i >= 0; i--) {
-        DOTNET_INT index = 2 * i;
-        DOTNET_INT index2 = index + 1;
+// Candidates of a batch are ordered in windows of this many before they are grouped into lanes.
+#define XENOPHYTE_SHARE_BATCH_WINDOW_LENGTH 4096
 
-        output[index] = Base16Characters[input[i] >> 4];
-        output[index2] = Base16Characters[input[i] & 15];
-    }
+DOTNET_PRIVATE void ConvertByteArrayToHex(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    HexUtility_ToUpperHex(input, inputLength, NULL, output);
 }
 
-DOTNET_PRIVATE void ConvertByteArrayToHexWithDash(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
-    {
-        DOTNET_INT i = inputLength - 1;
-        DOTNET_INT index = 3 * i;
-        DOTNET_INT index2 = index + 1;
+DOTNET_PRIVATE void XorAndConvertByteArrayToHex(const XENOPHYTE_SHARE_CTX *ctx, DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    DOTNET_INT keyOffset = 0;
 
-        output[index] = Base16Characters[input[i] >> 4];
-        output[index2] = Base16Characters[input[i] & 15];
-    }
-
-    for (DOTNET_INT i = inputLength - 2; i >= 0; i--) {
-        DOTNET_INT index = 3 * i;
-        DOTNET_INT index2 = index + 1;
-        DOTNET_INT index3 = index2 + 1;
+    // Output byte n is xored with xorKey[n % xorKeyLength], each chunk starts reading the key stream at that offset.
+    for (DOTNET_INT i = 0; i < inputLength; i += XENOPHYTE_XOR_KEY_STREAM_WINDOW / 2) {
+        DOTNET_INT length = inputLength - i < XENOPHYTE_XOR_KEY_STREAM_WINDOW / 2 ? inputLength - i : XENOPHYTE_XOR_KEY_STREAM_WINDOW / 2;
 
-        output[index] = Base16Characters[input[i] >> 4];
-        output[index2] = Base16Characters[input[i] & 15];
-        output[index3] = '-';
+        HexUtility_ToUpperHex(input + i, length, ctx->XorKeyStream + keyOffset, output + i * 2);
+        keyOffset = (keyOffset + length * 2) % ctx->XorKeyLength;
     }
 }
 
-DOTNET_PRIVATE void XorAndConvertByteArrayToHex(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_SPAN_BYTE output) {
-    for (DOTNET_INT i = inputLength - 1; i >= 0; i--) {
-        DOTNET_INT index = 2 * i;
-        DOTNET_INT index2 = index + 1;
+inline DOTNET_PRIVATE DOTNET_DOUBLE Max_Double(DOTNET_DOUBLE a, DOTNET_DOUBLE b) {
+    return a > b ? a : b;
+}
 
-        output[index] = Base16Characters[input[i] >> 4] ^ xorKey[index % xorKeyLength];
-        output[index2] = Base16Characters[input[i] & 15] ^ xorKey[index2 % xorKeyLength];
+inline DOTNET_PRIVATE DOTNET_LONG GetEasyBlockNumber(DOTNET_LONG minValue, DOTNET_LONG range, DOTNET_INT index) {
+    return minValue + (DOTNET_LONG) (Max_Double(0, index / 255.0 - 0.00000000001) * (DOTNET_DOUBLE) range);
+}
+
+DOTNET_PRIVATE DOTNET_INT DecodeHexCharacter(DOTNET_BYTE value) {
+    if (value >= '0' && value <= '9') {
+        return value - '0';
+    } else if (value >= 'A' && value <= 'F') {
+        return value - 'A' + 10;
+    } else {
+        return -1;
     }
 }
 
-DOTNET_PRIVATE void XorAndConvertByteArrayToHexWithDash(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_SPAN_BYTE output) {
-    {
-        DOTNET_INT i = inputLength - 1;
-        DOTNET_INT index = 3 * i;
-        DOTNET_INT index2 = index + 1;
+DOTNET_PRIVATE DOTNET_INT FormatLong(DOTNET_LONG value, DOTNET_SPAN_BYTE output) {
+    DOTNET_BYTE digits[20];
+    DOTNET_INT digitsLength = 0;
+    DOTNET_ULONG absoluteValue = value < 0 ? (DOTNET_ULONG) 0 - (DOTNET_ULONG) value : (DOTNET_ULONG) value;
 
-        output[index] = Base16Characters[input[i] >> 4] ^ xorKey[index % xorKeyLength];
-        output[index2] = Base16Characters[input[i] & 15] ^ xorKey[index2 % xorKeyLength];
-    }
+    do {
+        digits[digitsLength++] = (DOTNET_BYTE) ('0' + absoluteValue % 10);
+        absoluteValue /= 10;
+    } while (absoluteValue != 0);
+
+    DOTNET_INT outputLength = 0;
 
-    for (DOTNET_INT i = inputLength - 2; i >= 0; i--) {
-        DOTNET_INT index = 3 * i;
-        DOTNET_INT index2 = index + 1;
-        DOTNET_INT index3 = index2 + 1;
+    if (value < 0) {
+        output[outputLength++] = '-';
+    }
 
-        output[index] = Base16Characters[input[i] >> 4] ^ xorKey[index % xorKeyLength];
-        output[index2] = Base16Characters[input[i] & 15] ^ xorKey[index2 % xorKeyLength];
-        output[index3] = '-' ^ xorKey[index3 % xorKeyLength];
+    while (digitsLength > 0) {
+        output[outputLength++] = digits[--digitsLength];
     }
+
+    return outputLength;
 }
 
-inline DOTNET_PRIVATE DOTNET_DOUBLE Max_Double(DOTNET_DOUBLE a, DOTNET_DOUBLE b) {
-    return a > b ? a : b;
+DOTNET_PRIVATE DOTNET_INT FormatShareInput(const XENOPHYTE_SHARE_CANDIDATE *candidate, DOTNET_READ_ONLY_SPAN_BYTE timestampString, DOTNET_INT timestampStringLength, DOTNET_SPAN_BYTE input) {
+    // Input layout: "<first> <op> <second><timestamp>", the timestamp suffix is shared by every candidate.
+    DOTNET_INT inputLength = FormatLong(candidate->FirstNumber, input);
+
+    input[inputLength++] = ' ';
+    input[inputLength++] = (DOTNET_BYTE) candidate->Operator;
+    input[inputLength++] = ' ';
+
+    inputLength += FormatLong(candidate->SecondNumber, input + inputLength);
+
+    memcpy(input + inputLength, timestampString, timestampStringLength);
+    inputLength += timestampStringLength;
+
+    return inputLength;
 }
 
 DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedAlgorithm_GenerateEasyBlockNumbers(DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_SPAN_LONG output) {
@@ -75,7 +90,7 @@ DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedAlgorithm_GenerateEasyBlockNumbers(
 
     if (range > 256) {
         for (DOTNET_INT i = 255; i >= 0; i--) {
-            output[i] = minValue + (DOTNET_LONG) (Max_Double(0, i / 255.0 - 0.00000000001) * (DOTNET_DOUBLE) range);
+            output[i] = GetEasyBlockNumber(minValue, range, i);
         }
 
         return 256;
@@ -122,103 +137,740 @@ DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedAlgorithm_GenerateNonEasyBlockNumbe
     return amount;
 }
 
-DOTNET_PUBLIC DOTNET_BOOL XenophyteCentralizedAlgorithm_MakeEncryptedShare(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE encryptedShare, DOTNET_SPAN_BYTE hashEncryptedShare, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound) {
-    // First encryption phase convert to hex and xor each result.
+DOTNET_PUBLIC DOTNET_BOOL XenophyteCentralizedAlgorithm_IsEasyBlockNumber(DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_LONG value) {
+    if (value < minValue || value > maxValue) {
+        return DOTNET_FALSE;
+    }
 
-    DOTNET_INT firstOutputLength = inputLength * 2;
-    DOTNET_BYTE firstOutput[firstOutputLength];
+    DOTNET_LONG range = maxValue - minValue + 1;
 
-    XorAndConvertByteArrayToHex(input, inputLength, xorKey, xorKeyLength, firstOutput);
+    if (range <= 256) {
+        return DOTNET_TRUE;
+    }
 
-    // Second encryption phase: run through aes per round and apply xor at the final round.
+    // Easy block number i lands at or just below i * range / 255, so only the neighbours of that estimate can be equal to the value.
+    DOTNET_INT index = (DOTNET_INT) ((DOTNET_DOUBLE) (value - minValue) * 255.0 / (DOTNET_DOUBLE) range);
 
-    DOTNET_INT secondInputLength = firstOutputLength;
-    DOTNET_INT secondOutputLength = firstOutputLength;
+    for (DOTNET_INT i = index - 1; i <= index + 2; i++) {
+        if (i >= 0 && i <= 255 && GetEasyBlockNumber(minValue, range, i) == value) {
+            return DOTNET_TRUE;
+        }
+    }
 
-    for (DOTNET_INT i = aesRound; i >= 0; i--) {
-        secondOutputLength += SymmetricAlgorithmUtility_GetPaddedLength(secondOutputLength);
-        secondOutputLength = secondOutputLength * 2 + (secondOutputLength - 1);
+    return DOTNET_FALSE;
+}
+
+DOTNET_PUBLIC DOTNET_LONG XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(DOTNET_LONG minValue, DOTNET_LONG maxValue) {
+    DOTNET_LONG range = maxValue - minValue + 1;
+
+    // The 256 easy block numbers of a larger range are all distinct.
+    return range > 256 ? range - 256 : 0;
+}
+
+DOTNET_PUBLIC DOTNET_BOOL XenophyteCentralizedAlgorithm_GetNonEasyBlockNumber(DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_LONG index, DOTNET_LONG *value) {
+    if (value == NULL || index < 0 || index >= XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(minValue, maxValue)) {
+        return DOTNET_FALSE;
     }
 
-    DOTNET_BYTE secondOutput[secondOutputLength];
-    memcpy(secondOutput, firstOutput, secondInputLength);
+    DOTNET_LONG range = maxValue - minValue + 1;
+
+    // There are (easy block number i - minValue - i) non easy numbers below easy block number i, find the last easy block number with at most index of them.
+    DOTNET_INT low = 0;
+    DOTNET_INT high = 255;
 
-    for (DOTNET_INT i = aesRound; i >= 0; i--) {
-        if (i == 1) {
-            switch (aesKeySize) {
-                case 128:
-                    secondInputLength = SymmetricAlgorithmUtility_Encrypt_AES_128_CBC(aesKey, aesIv, secondOutput, secondInputLength, secondOutput);
-                    break;
+    while (low < high) {
+        DOTNET_INT middle = (low + high + 1) / 2;
 
-                case 192:
-                    secondInputLength = SymmetricAlgorithmUtility_Encrypt_AES_192_CBC(aesKey, aesIv, secondOutput, secondInputLength, secondOutput);
-                    break;
+        if (GetEasyBlockNumber(minValue, range, middle) - minValue - middle <= index) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
 
-                case 256:
-                    secondInputLength = SymmetricAlgorithmUtility_Encrypt_AES_256_CBC(aesKey, aesIv, secondOutput, secondInputLength, secondOutput);
-                    break;
+    *value = minValue + index + low + 1;
 
-                default:
-                    return DOTNET_FALSE;
-            }
+    return DOTNET_TRUE;
+}
+
+DOTNET_PRIVATE void FillRandomNonEasyBlockNumbers(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_LONG nonEasyBlockNumberCount, DOTNET_READ_ONLY_SPAN_LONG nonEasyBlockNumbersBelow, DOTNET_BOOL useXenophyteRandomizer, DOTNET_SPAN_LONG output, DOTNET_INT length) {
+    // A uniform pick maps straight onto the non easy numbers, the biased one keeps its own distribution and redraws the few easy block numbers it hits.
+    if (!useXenophyteRandomizer) {
+        RandomNumberGeneratorUtility_FillRandomBetween(generator, 0, nonEasyBlockNumberCount - 1, output, length);
 
-            if (secondInputLength == 0) {
-                return DOTNET_FALSE;
+        for (DOTNET_INT i = 0; i < length; i++) {
+            DOTNET_LONG index = output[i];
+            DOTNET_INT easyBlockIndex = 0;
+
+            for (DOTNET_INT step = 128; step > 0; step >>= 1) {
+                easyBlockIndex += nonEasyBlockNumbersBelow[easyBlockIndex + step] <= index ? step : 0;
             }
 
-            DOTNET_INT tempSize = secondInputLength * 2 + (secondInputLength - 1);
-            DOTNET_BYTE temp[tempSize];
+            output[i] = minValue + index + easyBlockIndex + 1;
+        }
 
-            XorAndConvertByteArrayToHexWithDash(secondOutput, secondInputLength, xorKey, xorKeyLength, temp);
+        return;
+    }
 
-            memcpy(secondOutput, temp, tempSize);
-            secondInputLength = tempSize;
-        } else {
-            switch (aesKeySize) {
-                case 128:
-                    secondInputLength = SymmetricAlgorithmUtility_Encrypt_AES_128_CBC(aesKey, aesIv, secondOutput, secondInputLength, secondOutput);
-                    break;
+    RandomNumberGeneratorUtility_FillBiasRandomBetween(generator, minValue, maxValue, output, length);
 
-                case 192:
-                    secondInputLength = SymmetricAlgorithmUtility_Encrypt_AES_192_CBC(aesKey, aesIv, secondOutput, secondInputLength, secondOutput);
-                    break;
+    for (DOTNET_INT i = 0; i < length; i++) {
+        while (XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, output[i])) {
+            RandomNumberGeneratorUtility_FillBiasRandomBetween(generator, minValue, maxValue, &output[i], 1);
+        }
+    }
+}
 
-                case 256:
-                    secondInputLength = SymmetricAlgorithmUtility_Encrypt_AES_256_CBC(aesKey, aesIv, secondOutput, secondInputLength, secondOutput);
-                    break;
+DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_BOOL useXenophyteRandomizer, DOTNET_SPAN_LONG firstNumbers, DOTNET_SPAN_LONG secondNumbers, DOTNET_INT length) {
+    DOTNET_LONG nonEasyBlockNumberCount = XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(minValue, maxValue);
 
-                default:
-                    return DOTNET_FALSE;
-            }
+    if (generator == NULL || firstNumbers == NULL || secondNumbers == NULL || length <= 0 || nonEasyBlockNumberCount == 0) {
+        return 0;
+    }
+
+    // Same rank table as GetNonEasyBlockNumber, built once for the whole call.
+    DOTNET_LONG range = maxValue - minValue + 1;
+    DOTNET_LONG nonEasyBlockNumbersBelow[256];
+
+    if (!useXenophyteRandomizer) {
+        for (DOTNET_INT i = 0; i < 256; i++) {
+            nonEasyBlockNumbersBelow[i] = GetEasyBlockNumber(minValue, range, i) - minValue - i;
+        }
+    }
+
+    FillRandomNonEasyBlockNumbers(generator, minValue, maxValue, nonEasyBlockNumberCount, nonEasyBlockNumbersBelow, useXenophyteRandomizer, firstNumbers, length);
+    FillRandomNonEasyBlockNumbers(generator, minValue, maxValue, nonEasyBlockNumberCount, nonEasyBlockNumbersBelow, useXenophyteRandomizer, secondNumbers, length);
+
+    return length;
+}
+
+DOTNET_PUBLIC XENOPHYTE_SHARE_CTX *XenophyteCentralizedAlgorithm_CreateShareContext(DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound) {
+    if (xorKey == NULL || xorKeyLength <= 0 || aesKey == NULL || aesIv == NULL || aesRound < 0) {
+        return NULL;
+    }
+
+    const EVP_CIPHER *cipher;
+
+    switch (aesKeySize) {
+        case 128:
+            cipher = CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_128_CBC);
+            break;
+
+        case 192:
+            cipher = CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_192_CBC);
+            break;
+
+        case 256:
+            cipher = CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_256_CBC);
+            break;
+
+        default:
+            return NULL;
+    }
+
+    const EVP_MD *digest = CryptographyUtility_GetMessageDigest(CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_512);
+
+    if (cipher == NULL || digest == NULL) {
+        return NULL;
+    }
+
+    XENOPHYTE_SHARE_CTX *ctx = malloc(sizeof(XENOPHYTE_SHARE_CTX));
+
+    if (ctx == NULL) {
+        return NULL;
+    }
+
+    ctx->XorKey = malloc(xorKeyLength);
+
+    if (ctx->XorKey == NULL) {
+        free(ctx);
+        return NULL;
+    }
+
+    memcpy(ctx->XorKey, xorKey, xorKeyLength);
+    ctx->XorKeyLength = xorKeyLength;
+
+    ctx->XorKeyStream = malloc(xorKeyLength + XENOPHYTE_XOR_KEY_STREAM_WINDOW);
+
+    if (ctx->XorKeyStream == NULL) {
+        free(ctx->XorKey);
+        free(ctx);
+        return NULL;
+    }
 
-            if (secondInputLength == 0) {
-                return DOTNET_FALSE;
+    for (DOTNET_INT i = 0; i < xorKeyLength + XENOPHYTE_XOR_KEY_STREAM_WINDOW; i++) {
+        ctx->XorKeyStream[i] = xorKey[i % xorKeyLength];
+    }
+
+    ctx->AesKeySize = aesKeySize;
+    memcpy(ctx->AesIv, aesIv, sizeof(ctx->AesIv));
+    ctx->AesRound = aesRound;
+
+    ctx->HasBlockIndication = DOTNET_FALSE;
+
+    ctx->Digest = EVP_MD_CTX_new();
+    ctx->PrefixDigest = EVP_MD_CTX_new();
+    ctx->PrefixInputLength = 0;
+
+    ctx->Lanes = 1;
+    ctx->Stages = NULL;
+    ctx->StageBuffers = NULL;
+
+    if (ctx->Digest == NULL || ctx->PrefixDigest == NULL || !EVP_DigestInit_ex(ctx->Digest, digest, NULL)) {
+        XenophyteCentralizedAlgorithm_FreeShareContext(ctx);
+        return NULL;
+    }
+
+    // Batches run several candidates through the aes phase in parallel lanes when the cpu supports it, a single lane goes through the cipher contexts.
+    DOTNET_INT aesLanes = AesMultiBufferUtility_GetLaneCount();
+
+    if (aesLanes > 1 && AesMultiBufferUtility_ExpandKey(&ctx->AesKey, aesKeySize, aesKey)) {
+        ctx->Lanes = aesLanes;
+    }
+
+    ctx->Stages = calloc(aesRound + 1, sizeof(XENOPHYTE_SHARE_STAGE));
+    ctx->StageBuffers = malloc((size_t) (aesRound + 1) * ctx->Lanes * (16 + XENOPHYTE_SHARE_STAGE_PENDING_LENGTH + XENOPHYTE_SHARE_STAGE_ENCODED_LENGTH));
+
+    if (ctx->Stages == NULL || ctx->StageBuffers == NULL) {
+        XenophyteCentralizedAlgorithm_FreeShareContext(ctx);
+        return NULL;
+    }
+
+    DOTNET_SPAN_BYTE stageBuffer = ctx->StageBuffers;
+
+    for (DOTNET_INT i = 0; i <= aesRound; i++) {
+        XENOPHYTE_SHARE_STAGE *stage = &ctx->Stages[i];
+
+        // Padding is added by the stage itself, it only knows where the input ends once the last byte arrives.
+        stage->Cipher = SymmetricAlgorithmUtility_CreateEncryptContext_EVP_CIPHER(cipher, aesKey);
+
+        if (stage->Cipher == NULL || !EVP_CIPHER_CTX_set_padding(stage->Cipher, 0)) {
+            XenophyteCentralizedAlgorithm_FreeShareContext(ctx);
+            return NULL;
+        }
+
+        stage->Chains = stageBuffer;
+        stage->Pending = stage->Chains + 16 * ctx->Lanes;
+        stage->Encoded = stage->Pending + XENOPHYTE_SHARE_STAGE_PENDING_LENGTH * ctx->Lanes;
+        stageBuffer = stage->Encoded + XENOPHYTE_SHARE_STAGE_ENCODED_LENGTH * ctx->Lanes;
+    }
+
+    return ctx;
+}
+
+DOTNET_PRIVATE DOTNET_BOOL WriteShareStage(XENOPHYTE_SHARE_CTX *ctx, DOTNET_INT stageIndex, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_INT lanes);
+
+DOTNET_PRIVATE DOTNET_BOOL FlushShareStage(XENOPHYTE_SHARE_CTX *ctx, DOTNET_INT stageIndex, DOTNET_BOOL isLastChunk, DOTNET_INT lanes) {
+    XENOPHYTE_SHARE_STAGE *stage = &ctx->Stages[stageIndex];
+    DOTNET_INT length = stage->PendingLength;
+
+    DOTNET_SPAN_BYTE chains[AES_MULTI_BUFFER_MAX_LANES];
+    DOTNET_SPAN_BYTE pending[AES_MULTI_BUFFER_MAX_LANES];
+    DOTNET_SPAN_BYTE encoded[AES_MULTI_BUFFER_MAX_LANES];
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        chains[lane] = stage->Chains + lane * 16;
+        pending[lane] = stage->Pending + lane * XENOPHYTE_SHARE_STAGE_PENDING_LENGTH;
+        encoded[lane] = stage->Encoded + lane * XENOPHYTE_SHARE_STAGE_ENCODED_LENGTH;
+    }
+
+    if (lanes > 1) {
+        if (!AesMultiBufferUtility_Encrypt_CBC_Blocks(&ctx->AesKey, chains, (const DOTNET_BYTE *const *) pending, length, pending, lanes)) {
+            return DOTNET_FALSE;
+        }
+    } else {
+        DOTNET_INT outputLength;
+
+        if (!EVP_EncryptUpdate(stage->Cipher, pending[0], &outputLength, pending[0], length) || outputLength != length) {
+            return DOTNET_FALSE;
+        }
+
+        // The cipher context keeps its own chaining value, the copy is what a saved prefix resumes from.
+        memcpy(chains[0], pending[0] + length - 16, 16);
+    }
+
+    // Every byte but the very last one of the stage is followed by a dash, only the stage of round 1 is xored.
+    DOTNET_READ_ONLY_SPAN_BYTE keyStream = stageIndex == ctx->AesRound - 1 ? ctx->XorKeyStream + stage->KeyOffset : NULL;
+    DOTNET_INT dashLength = isLastChunk ? length - 1 : length;
+    DOTNET_INT encodedLength = isLastChunk ? length * 3 - 1 : length * 3;
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        HexUtility_ToUpperHexWithDash(pending[lane], dashLength, keyStream, encoded[lane]);
+
+        if (isLastChunk) {
+            HexUtility_ToUpperHex(pending[lane] + dashLength, 1, keyStream == NULL ? NULL : keyStream + dashLength * 3, encoded[lane] + dashLength * 3);
+        }
+    }
+
+    stage->KeyOffset = (stage->KeyOffset + encodedLength) % ctx->XorKeyLength;
+    stage->PendingLength = 0;
+
+    if (stageIndex < ctx->AesRound) {
+        return WriteShareStage(ctx, stageIndex + 1, (const DOTNET_BYTE *const *) encoded, encodedLength, lanes);
+    }
+
+    if (lanes > 1) {
+        return MessageDigestUtility_Sha2_512Lanes_Update(&ctx->DigestLanes, (const DOTNET_BYTE *const *) encoded, encodedLength);
+    }
+
+    return EVP_DigestUpdate(ctx->Digest, encoded[0], encodedLength);
+}
+
+DOTNET_PRIVATE DOTNET_BOOL WriteShareStage(XENOPHYTE_SHARE_CTX *ctx, DOTNET_INT stageIndex, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_INT lanes) {
+    XENOPHYTE_SHARE_STAGE *stage = &ctx->Stages[stageIndex];
+
+    for (DOTNET_INT offset = 0; offset < sourceLength;) {
+        DOTNET_INT length = XENOPHYTE_SHARE_STAGE_CHUNK_LENGTH - stage->PendingLength;
+
+        if (length > sourceLength - offset) {
+            length = sourceLength - offset;
+        }
+
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            memcpy(stage->Pending + lane * XENOPHYTE_SHARE_STAGE_PENDING_LENGTH + stage->PendingLength, sources[lane] + offset, length);
+        }
+
+        stage->PendingLength += length;
+        stage->InputConsumed += length;
+        offset += length;
+
+        if (stage->InputConsumed == stage->InputLength) {
+            // PKCS7 padding always adds between 1 and 16 bytes, the pending buffer keeps room for a full block past the chunk.
+            DOTNET_INT padding = 16 - (DOTNET_INT) (stage->InputLength % 16);
+
+            for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+                memset(stage->Pending + lane * XENOPHYTE_SHARE_STAGE_PENDING_LENGTH + stage->PendingLength, padding, padding);
             }
 
-            DOTNET_INT tempSize = secondInputLength * 2 + (secondInputLength - 1);
-            DOTNET_BYTE temp[tempSize];
+            stage->PendingLength += padding;
+
+            return FlushShareStage(ctx, stageIndex, DOTNET_TRUE, lanes);
+        }
+
+        if (stage->PendingLength == XENOPHYTE_SHARE_STAGE_CHUNK_LENGTH && !FlushShareStage(ctx, stageIndex, DOTNET_FALSE, lanes)) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_PRIVATE DOTNET_BOOL ResetShareStages(XENOPHYTE_SHARE_CTX *ctx, DOTNET_INT inputLength, DOTNET_INT lanes) {
+    // Every round is a stage of one cascade, a stage encrypts whole chunks as soon as they arrive and hands its hex output to the next one.
+    // Only the stage lengths are known up front, no round output is ever held in full.
+    DOTNET_LONG stageInputLength = inputLength * 2;
+
+    for (DOTNET_INT i = 0; i <= ctx->AesRound; i++) {
+        XENOPHYTE_SHARE_STAGE *stage = &ctx->Stages[i];
+
+        stage->PendingLength = 0;
+        stage->InputLength = stageInputLength;
+        stage->InputConsumed = 0;
+        stage->KeyOffset = 0;
+
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            memcpy(stage->Chains + lane * 16, ctx->AesIv, 16);
+        }
+
+        if (lanes == 1 && !EVP_EncryptInit_ex(stage->Cipher, NULL, NULL, NULL, ctx->AesIv)) {
+            return DOTNET_FALSE;
+        }
+
+        stageInputLength = (stageInputLength / 16 + 1) * 16 * 3 - 1;
+    }
+
+    if (lanes > 1) {
+        return MessageDigestUtility_Sha2_512Lanes_Init(&ctx->DigestLanes, lanes);
+    }
+
+    return EVP_DigestInit_ex(ctx->Digest, NULL, NULL);
+}
+
+DOTNET_PRIVATE DOTNET_INT GetSharedPrefixLength(const XENOPHYTE_SHARE_CTX *ctx, DOTNET_BYTE inputs[][XENOPHYTE_SHARE_INPUT_MAX_LENGTH], DOTNET_INT inputLength, DOTNET_INT lanes) {
+    // A lone candidate of a multi lane context goes through openssl, the saved digest state only exists in lane form there.
+    if (ctx->Lanes > 1 && lanes == 1) {
+        return 0;
+    }
+
+    // Only "<first> <op> " is worth keeping, it is what candidates next to each other in a batch have in common.
+    const DOTNET_BYTE *separator = memchr(inputs[0], ' ', inputLength);
+
+    if (separator == NULL) {
+        return 0;
+    }
+
+    DOTNET_INT length = (DOTNET_INT) (separator - inputs[0]) + 3;
 
-            ConvertByteArrayToHexWithDash(secondOutput, secondInputLength, temp);
+    // A stage 0 block is the hex of 8 input bytes, the block holding the padding always stays with the candidate.
+    if (length > (inputLength * 2 - 1) / 16 * 8) {
+        length = (inputLength * 2 - 1) / 16 * 8;
+    }
+
+    if (length < 0) {
+        return 0;
+    }
+
+    for (DOTNET_INT lane = 1; lane < lanes; lane++) {
+        DOTNET_INT i = 0;
+
+        while (i < length && inputs[lane][i] == inputs[0][i]) {
+            i++;
+        }
+
+        length = i;
+    }
+
+    return length - length % 8;
+}
+
+DOTNET_PRIVATE DOTNET_BOOL SaveSharePrefix(XENOPHYTE_SHARE_CTX *ctx, DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_READ_ONLY_SPAN_BYTE firstOutput, DOTNET_INT inputLength, DOTNET_INT prefixLength) {
+    // The prefix runs through every lane of the context, the saved state then fits a group of any size.
+    DOTNET_INT lanes = ctx->Lanes;
+    const DOTNET_BYTE *sources[AES_MULTI_BUFFER_MAX_LANES];
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        sources[lane] = firstOutput;
+    }
+
+    ctx->PrefixInputLength = 0;
+
+    if (!ResetShareStages(ctx, inputLength, lanes) || !WriteShareStage(ctx, 0, sources, prefixLength * 2, lanes)) {
+        return DOTNET_FALSE;
+    }
+
+    // Whole blocks are pending everywhere, pushing them down now yields the same bytes as waiting for a full chunk.
+    for (DOTNET_INT i = 0; i <= ctx->AesRound; i++) {
+        if (ctx->Stages[i].PendingLength > 0 && !FlushShareStage(ctx, i, DOTNET_FALSE, lanes)) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    for (DOTNET_INT i = 0; i <= ctx->AesRound; i++) {
+        XENOPHYTE_SHARE_STAGE *stage = &ctx->Stages[i];
+
+        memcpy(stage->PrefixChain, stage->Chains, 16);
+        stage->PrefixInputConsumed = stage->InputConsumed;
+        stage->PrefixKeyOffset = stage->KeyOffset;
+    }
+
+    if (lanes > 1) {
+        ctx->PrefixDigestLanes = ctx->DigestLanes;
+    } else if (!EVP_MD_CTX_copy_ex(ctx->PrefixDigest, ctx->Digest)) {
+        return DOTNET_FALSE;
+    }
+
+    memcpy(ctx->PrefixInput, input, prefixLength);
+    ctx->PrefixInputLength = prefixLength;
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_PRIVATE DOTNET_BOOL RestoreSharePrefix(XENOPHYTE_SHARE_CTX *ctx, DOTNET_INT lanes) {
+    for (DOTNET_INT i = 0; i <= ctx->AesRound; i++) {
+        XENOPHYTE_SHARE_STAGE *stage = &ctx->Stages[i];
+
+        stage->InputConsumed = stage->PrefixInputConsumed;
+        stage->KeyOffset = stage->PrefixKeyOffset;
+
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            memcpy(stage->Chains + lane * 16, stage->PrefixChain, 16);
+        }
+
+        if (lanes == 1 && !EVP_EncryptInit_ex(stage->Cipher, NULL, NULL, NULL, stage->PrefixChain)) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    if (lanes > 1) {
+        ctx->DigestLanes = ctx->PrefixDigestLanes;
+        ctx->DigestLanes.Lanes = lanes;
+
+        return DOTNET_TRUE;
+    }
+
+    return EVP_MD_CTX_copy_ex(ctx->Digest, ctx->PrefixDigest);
+}
+
+DOTNET_PRIVATE DOTNET_BOOL ComputeEncryptedShareLanes(XENOPHYTE_SHARE_CTX *ctx, DOTNET_BYTE inputs[][XENOPHYTE_SHARE_INPUT_MAX_LENGTH], DOTNET_INT inputLength, DOTNET_INT lanes, DOTNET_BYTE encryptedShares[][64 * 2], DOTNET_BYTE hashEncryptedShareDigests[][64]) {
+    if (lanes <= 0 || lanes > ctx->Lanes) {
+        return DOTNET_FALSE;
+    }
+
+    // First encryption phase convert to hex and xor each result.
 
-            memcpy(secondOutput, temp, tempSize);
-            secondInputLength = tempSize;
+    DOTNET_BYTE firstOutputs[AES_MULTI_BUFFER_MAX_LANES][XENOPHYTE_SHARE_INPUT_MAX_LENGTH * 2];
+    DOTNET_SPAN_BYTE firstOutputPointers[AES_MULTI_BUFFER_MAX_LANES];
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        XorAndConvertByteArrayToHex(ctx, inputs[lane], inputLength, firstOutputs[lane]);
+    }
+
+    // Equal leading input bytes give equal cipher text blocks in every round, a group resumes after the prefix the previous group saved.
+    DOTNET_INT prefixLength = GetSharedPrefixLength(ctx, inputs, inputLength, lanes);
+
+    if (prefixLength > 0 && (ctx->PrefixInputLength != prefixLength || memcmp(ctx->PrefixInput, inputs[0], prefixLength) != 0)) {
+        if (!SaveSharePrefix(ctx, inputs[0], firstOutputs[0], inputLength, prefixLength)) {
+            return DOTNET_FALSE;
         }
     }
 
+    if (!ResetShareStages(ctx, inputLength, lanes)) {
+        return DOTNET_FALSE;
+    }
+
+    if (prefixLength > 0 && !RestoreSharePrefix(ctx, lanes)) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        firstOutputPointers[lane] = firstOutputs[lane] + prefixLength * 2;
+    }
+
+    // Second encryption phase: run through aes per round and apply xor at the final round, the last stage feeds the digest.
+
+    if (!WriteShareStage(ctx, 0, (const DOTNET_BYTE *const *) firstOutputPointers, (inputLength - prefixLength) * 2, lanes)) {
+        return DOTNET_FALSE;
+    }
+
     // Third encryption phase: compute hash
-    DOTNET_BYTE thirdOutput[64];
 
-    if (!MessageDigestUtility_ComputeSha2_512Hash(secondOutput, secondOutputLength, thirdOutput)) {
+    DOTNET_BYTE thirdOutputs[AES_MULTI_BUFFER_MAX_LANES][64];
+    DOTNET_SPAN_BYTE digestSources[AES_MULTI_BUFFER_MAX_LANES];
+    DOTNET_SPAN_BYTE digestDestinations[AES_MULTI_BUFFER_MAX_LANES];
+    DOTNET_INT digestSourceLengths[AES_MULTI_BUFFER_MAX_LANES];
+
+    if (lanes > 1) {
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            digestDestinations[lane] = thirdOutputs[lane];
+        }
+
+        if (!MessageDigestUtility_Sha2_512Lanes_Final(&ctx->DigestLanes, digestDestinations)) {
+            return DOTNET_FALSE;
+        }
+    } else if (!EVP_DigestFinal_ex(ctx->Digest, thirdOutputs[0], NULL)) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        ConvertByteArrayToHex(thirdOutputs[lane], 64, encryptedShares[lane]);
+
+        digestSources[lane] = encryptedShares[lane];
+        digestDestinations[lane] = hashEncryptedShareDigests[lane];
+        digestSourceLengths[lane] = 64 * 2;
+    }
+
+    return MessageDigestUtility_ComputeSha2_512HashBatch(ctx->Digest, (const DOTNET_BYTE *const *) digestSources, digestSourceLengths, digestDestinations, lanes);
+}
+
+DOTNET_PUBLIC DOTNET_BOOL XenophyteCentralizedAlgorithm_SetShareContextBlockIndication(XENOPHYTE_SHARE_CTX *ctx, DOTNET_READ_ONLY_SPAN_BYTE blockIndication, DOTNET_INT blockIndicationLength) {
+    if (ctx == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    ctx->HasBlockIndication = DOTNET_FALSE;
+
+    if (blockIndication == NULL || blockIndicationLength != 64 * 2) {
+        return DOTNET_FALSE;
+    }
+
+    // Shares are compared against the upper case hex produced by ConvertByteArrayToHex, anything else can never match.
+    for (DOTNET_INT i = 0; i < 64; i++) {
+        DOTNET_INT high = DecodeHexCharacter(blockIndication[2 * i]);
+        DOTNET_INT low = DecodeHexCharacter(blockIndication[2 * i + 1]);
+
+        if (high < 0 || low < 0) {
+            return DOTNET_FALSE;
+        }
+
+        ctx->BlockIndication[i] = (DOTNET_BYTE) ((high << 4) | low);
+    }
+
+    ctx->HasBlockIndication = DOTNET_TRUE;
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_PUBLIC DOTNET_BOOL XenophyteCentralizedAlgorithm_MakeEncryptedShareWithContext(XENOPHYTE_SHARE_CTX *ctx, DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE encryptedShare, DOTNET_SPAN_BYTE hashEncryptedShare) {
+    if (ctx == NULL || input == NULL || inputLength <= 0 || encryptedShare == NULL || hashEncryptedShare == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    if (inputLength > XENOPHYTE_SHARE_INPUT_MAX_LENGTH) {
         return DOTNET_FALSE;
     }
 
-    ConvertByteArrayToHex(thirdOutput, 64, encryptedShare);
+    DOTNET_BYTE inputs[1][XENOPHYTE_SHARE_INPUT_MAX_LENGTH];
+    DOTNET_BYTE encryptedShares[1][64 * 2];
+    DOTNET_BYTE hashEncryptedShareDigests[1][64];
+
+    memcpy(inputs[0], input, inputLength);
+
+    if (!ComputeEncryptedShareLanes(ctx, inputs, inputLength, 1, encryptedShares, hashEncryptedShareDigests)) {
+        return DOTNET_FALSE;
+    }
+
+    memcpy(encryptedShare, encryptedShares[0], 64 * 2);
+    ConvertByteArrayToHex(hashEncryptedShareDigests[0], 64, hashEncryptedShare);
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_PRIVATE DOTNET_BOOL MakeEncryptedShareGroup(XENOPHYTE_SHARE_CTX *ctx, const XENOPHYTE_SHARE_CANDIDATE *candidates, DOTNET_READ_ONLY_SPAN_INT indices, DOTNET_INT indicesLength, DOTNET_READ_ONLY_SPAN_BYTE timestampString, DOTNET_INT timestampStringLength, DOTNET_SPAN_INT matchIndices, DOTNET_SPAN_BYTE matchEncryptedShares, DOTNET_INT maxMatches, DOTNET_INT *matches) {
+    DOTNET_BYTE inputs[AES_MULTI_BUFFER_MAX_LANES][XENOPHYTE_SHARE_INPUT_MAX_LENGTH];
+    DOTNET_BYTE encryptedShares[AES_MULTI_BUFFER_MAX_LANES][64 * 2];
+    DOTNET_BYTE hashEncryptedShareDigests[AES_MULTI_BUFFER_MAX_LANES][64];
+
+    DOTNET_INT inputLength = 0;
 
-    if (!MessageDigestUtility_ComputeSha2_512Hash(encryptedShare, 64 * 2, thirdOutput)) {
+    for (DOTNET_INT lane = 0; lane < indicesLength; lane++) {
+        inputLength = FormatShareInput(&candidates[indices[lane]], timestampString, timestampStringLength, inputs[lane]);
+    }
+
+    if (!ComputeEncryptedShareLanes(ctx, inputs, inputLength, indicesLength, encryptedShares, hashEncryptedShareDigests)) {
         return DOTNET_FALSE;
     }
 
-    ConvertByteArrayToHex(thirdOutput, 64, hashEncryptedShare);
+    for (DOTNET_INT lane = 0; lane < indicesLength && *matches < maxMatches; lane++) {
+        if (!ctx->HasBlockIndication || memcmp(hashEncryptedShareDigests[lane], ctx->BlockIndication, 64) != 0) {
+            continue;
+        }
+
+        matchIndices[*matches] = indices[lane];
+        memcpy(matchEncryptedShares + *matches * 64 * 2, encryptedShares[lane], 64 * 2);
+        *matches += 1;
+    }
 
     return DOTNET_TRUE;
 }
+
+typedef struct XENOPHYTE_SHARE_BATCH_ORDER {
+    DOTNET_LONG FirstNumber;
+    DOTNET_INT Operator;
+    DOTNET_INT InputLength;
+    DOTNET_INT Index;
+} XENOPHYTE_SHARE_BATCH_ORDER;
+
+DOTNET_PRIVATE int CompareShareBatchOrder(const void *left, const void *right) {
+    const XENOPHYTE_SHARE_BATCH_ORDER *a = left;
+    const XENOPHYTE_SHARE_BATCH_ORDER *b = right;
+
+    if (a->InputLength != b->InputLength) return a->InputLength < b->InputLength ? -1 : 1;
+    if (a->FirstNumber != b->FirstNumber) return a->FirstNumber < b->FirstNumber ? -1 : 1;
+    if (a->Operator != b->Operator) return a->Operator < b->Operator ? -1 : 1;
+    return a->Index < b->Index ? -1 : a->Index > b->Index;
+}
+
+DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedAlgorithm_MakeEncryptedShareBatch(XENOPHYTE_SHARE_CTX *ctx, const XENOPHYTE_SHARE_CANDIDATE *candidates, DOTNET_INT candidatesLength, DOTNET_LONG timestamp, DOTNET_SPAN_INT matchIndices, DOTNET_SPAN_BYTE matchEncryptedShares, DOTNET_INT maxMatches) {
+    if (ctx == NULL || candidates == NULL || candidatesLength < 0 || matchIndices == NULL || matchEncryptedShares == NULL || maxMatches <= 0) {
+        return -1;
+    }
+
+    DOTNET_BYTE timestampString[20];
+    DOTNET_INT timestampStringLength = FormatLong(timestamp, timestampString);
+
+    DOTNET_BYTE input[XENOPHYTE_SHARE_INPUT_MAX_LENGTH];
+    DOTNET_INT matches = 0;
+
+    XENOPHYTE_SHARE_BATCH_ORDER order[XENOPHYTE_SHARE_BATCH_WINDOW_LENGTH];
+
+    for (DOTNET_INT windowStart = 0; windowStart < candidatesLength && matches < maxMatches; windowStart += XENOPHYTE_SHARE_BATCH_WINDOW_LENGTH) {
+        DOTNET_INT windowLength = candidatesLength - windowStart < XENOPHYTE_SHARE_BATCH_WINDOW_LENGTH ? candidatesLength - windowStart : XENOPHYTE_SHARE_BATCH_WINDOW_LENGTH;
+
+        for (DOTNET_INT i = 0; i < windowLength; i++) {
+            const XENOPHYTE_SHARE_CANDIDATE *candidate = &candidates[windowStart + i];
+
+            order[i].FirstNumber = candidate->FirstNumber;
+            order[i].Operator = candidate->Operator;
+            order[i].InputLength = FormatShareInput(candidate, timestampString, timestampStringLength, input);
+            order[i].Index = windowStart + i;
+        }
+
+        // Equal lengths take the exact same path through every phase and can share the aes lanes, neighbours in this order also share their leading blocks.
+        qsort(order, windowLength, sizeof(XENOPHYTE_SHARE_BATCH_ORDER), CompareShareBatchOrder);
+
+        DOTNET_INT group[AES_MULTI_BUFFER_MAX_LANES];
+        DOTNET_INT groupLength = 0;
+
+        for (DOTNET_INT i = 0; i < windowLength && matches < maxMatches; i++) {
+            group[groupLength++] = order[i].Index;
+
+            if (groupLength < ctx->Lanes && i + 1 < windowLength && order[i + 1].InputLength == order[i].InputLength) {
+                continue;
+            }
+
+            if (!MakeEncryptedShareGroup(ctx, candidates, group, groupLength, timestampString, timestampStringLength, matchIndices, matchEncryptedShares, maxMatches, &matches)) {
+                return -1;
+            }
+
+            groupLength = 0;
+        }
+    }
+
+    return matches;
+}
+
+DOTNET_PUBLIC void XenophyteCentralizedAlgorithm_FreeShareContext(XENOPHYTE_SHARE_CTX *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+
+    DOTNET_SPAN_BYTE xorKey = ctx->XorKey;
+
+    if (xorKey != NULL) {
+        free(xorKey);
+    }
+
+    DOTNET_SPAN_BYTE xorKeyStream = ctx->XorKeyStream;
+
+    if (xorKeyStream != NULL) {
+        free(xorKeyStream);
+    }
+
+    EVP_MD_CTX *digest = ctx->Digest;
+
+    if (digest != NULL) {
+        EVP_MD_CTX_free(digest);
+    }
+
+    EVP_MD_CTX *prefixDigest = ctx->PrefixDigest;
+
+    if (prefixDigest != NULL) {
+        EVP_MD_CTX_free(prefixDigest);
+    }
+
+    XENOPHYTE_SHARE_STAGE *stages = ctx->Stages;
+
+    if (stages != NULL) {
+        for (DOTNET_INT i = 0; i <= ctx->AesRound; i++) {
+            EVP_CIPHER_CTX *cipher = stages[i].Cipher;
+
+            if (cipher != NULL) {
+                EVP_CIPHER_CTX_free(cipher);
+            }
+        }
+
+        free(stages);
+    }
+
+    DOTNET_SPAN_BYTE stageBuffers = ctx->StageBuffers;
+
+    if (stageBuffers != NULL) {
+        free(stageBuffers);
+    }
+
+    free(ctx);
+}
+
+DOTNET_PUBLIC DOTNET_BOOL XenophyteCentralizedAlgorithm_MakeEncryptedShare(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE encryptedShare, DOTNET_SPAN_BYTE hashEncryptedShare, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound) {
+    XENOPHYTE_SHARE_CTX *ctx = XenophyteCentralizedAlgorithm_CreateShareContext(xorKey, xorKeyLength, aesKeySize, aesKey, aesIv, aesRound);
+
+    if (ctx == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_BOOL result = XenophyteCentralizedAlgorithm_MakeEncryptedShareWithContext(ctx, input, inputLength, encryptedShare, hashEncryptedShare);
+
+    XenophyteCentralizedAlgorithm_FreeShareContext(ctx);
+
+    return result;
+}
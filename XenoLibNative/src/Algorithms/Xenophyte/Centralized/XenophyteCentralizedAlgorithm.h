@@ -2,9 +2,85 @@
 #define XENOPHYTECENTRALIZEDALGORITHM_H
 
 #include "global.h"
+#include "openssl/evp.h"
+#include "Utilities/AesMultiBufferUtility.h"
+#include "Utilities/MessageDigestUtility.h"
+#include "Utilities/RandomNumberGeneratorUtility.h"
+
+// Longest "<first> <op> <second><timestamp>" input: two signed 64-bit numbers, the operator with its spaces and the timestamp.
+#define XENOPHYTE_SHARE_INPUT_MAX_LENGTH (20 + 3 + 20 + 20)
+
+// The xor key repeated past its own length, so any key offset can be followed by this many contiguous output bytes.
+#define XENOPHYTE_XOR_KEY_STREAM_WINDOW 768
+
+// One stage per aes round, each keeps the cbc chaining value and a partial chunk of the previous stage's output for every lane.
+typedef struct XENOPHYTE_SHARE_STAGE {
+    EVP_CIPHER_CTX *Cipher;
+    DOTNET_SPAN_BYTE Chains;
+    DOTNET_SPAN_BYTE Pending;
+    DOTNET_SPAN_BYTE Encoded;
+    DOTNET_INT PendingLength;
+    DOTNET_LONG InputLength;
+    DOTNET_LONG InputConsumed;
+    DOTNET_INT KeyOffset;
+
+    // Where the stage stood once the saved prefix went through, the same for every lane.
+    DOTNET_BYTE PrefixChain[16];
+    DOTNET_LONG PrefixInputConsumed;
+    DOTNET_INT PrefixKeyOffset;
+} XENOPHYTE_SHARE_STAGE;
+
+typedef struct XENOPHYTE_SHARE_CTX {
+    DOTNET_SPAN_BYTE XorKey;
+    DOTNET_INT XorKeyLength;
+    DOTNET_SPAN_BYTE XorKeyStream;
+
+    DOTNET_INT AesKeySize;
+    DOTNET_BYTE AesIv[16];
+    DOTNET_INT AesRound;
+
+    DOTNET_BYTE BlockIndication[64];
+    DOTNET_BOOL HasBlockIndication;
+
+    EVP_MD_CTX *Digest;
+
+    AES_MULTI_BUFFER_KEY AesKey;
+    DOTNET_INT Lanes;
+
+    XENOPHYTE_SHARE_STAGE *Stages;
+    DOTNET_SPAN_BYTE StageBuffers;
+    SHA512_LANES_CTX DigestLanes;
+
+    // Leading input bytes shared by the last group of candidates, whole stage 0 blocks only, with the digest state they left behind.
+    DOTNET_BYTE PrefixInput[XENOPHYTE_SHARE_INPUT_MAX_LENGTH];
+    DOTNET_INT PrefixInputLength;
+    EVP_MD_CTX *PrefixDigest;
+    SHA512_LANES_CTX PrefixDigestLanes;
+} XENOPHYTE_SHARE_CTX;
+
+typedef struct XENOPHYTE_SHARE_CANDIDATE {
+    DOTNET_LONG FirstNumber;
+    DOTNET_LONG SecondNumber;
+    DOTNET_LONG Solution; // Not used by the share pipeline, carried along so the caller can submit a match.
+    DOTNET_INT Operator;
+} XENOPHYTE_SHARE_CANDIDATE;
 
 DOTNET_INT XenophyteCentralizedAlgorithm_GenerateEasyBlockNumbers(DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_SPAN_LONG output);
 DOTNET_INT XenophyteCentralizedAlgorithm_GenerateNonEasyBlockNumbers(DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_SPAN_LONG output);
+
+// Closed form view of [minValue, maxValue] without the numbers of GenerateEasyBlockNumbers, nothing has to be materialized.
+DOTNET_BOOL XenophyteCentralizedAlgorithm_IsEasyBlockNumber(DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_LONG value);
+DOTNET_LONG XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(DOTNET_LONG minValue, DOTNET_LONG maxValue);
+DOTNET_BOOL XenophyteCentralizedAlgorithm_GetNonEasyBlockNumber(DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_LONG index, DOTNET_LONG *value);
+
+// Fills length (first, second) pairs of random non easy block numbers, returns 0 when the range has none.
+DOTNET_INT XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minValue, DOTNET_LONG maxValue, DOTNET_BOOL useXenophyteRandomizer, DOTNET_SPAN_LONG firstNumbers, DOTNET_SPAN_LONG secondNumbers, DOTNET_INT length);
 DOTNET_BOOL XenophyteCentralizedAlgorithm_MakeEncryptedShare(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE encryptedShare, DOTNET_SPAN_BYTE hashEncryptedShare, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound);
 
+XENOPHYTE_SHARE_CTX *XenophyteCentralizedAlgorithm_CreateShareContext(DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound);
+DOTNET_BOOL XenophyteCentralizedAlgorithm_MakeEncryptedShareWithContext(XENOPHYTE_SHARE_CTX *ctx, DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE encryptedShare, DOTNET_SPAN_BYTE hashEncryptedShare);
+DOTNET_BOOL XenophyteCentralizedAlgorithm_SetShareContextBlockIndication(XENOPHYTE_SHARE_CTX *ctx, DOTNET_READ_ONLY_SPAN_BYTE blockIndication, DOTNET_INT blockIndicationLength);
+DOTNET_INT XenophyteCentralizedAlgorithm_MakeEncryptedShareBatch(XENOPHYTE_SHARE_CTX *ctx, const XENOPHYTE_SHARE_CANDIDATE *candidates, DOTNET_INT candidatesLength, DOTNET_LONG timestamp, DOTNET_SPAN_INT matchIndices, DOTNET_SPAN_BYTE matchEncryptedShares, DOTNET_INT maxMatches);
+void XenophyteCentralizedAlgorithm_FreeShareContext(XENOPHYTE_SHARE_CTX *ctx);
+
 #endif
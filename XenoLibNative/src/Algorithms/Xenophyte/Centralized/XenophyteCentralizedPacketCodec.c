@@ -0,0 +1,308 @@
+#include "XenophyteCentralizedPacketCodec.h"
+#include "Utilities/AesMultiBufferUtility.h"
+#include "Utilities/Base64Utility.h"
+#include "Utilities/CryptographyUtility.h"
+#include "Utilities/SymmetricAlgorithmUtility.h"
+
+// Packets are encoded and decoded in pieces of this many bytes, a multiple of both the Base64 group and the aes block so every piece stays in cache between the two passes.
+#define XENOPHYTE_PACKET_CHUNK_LENGTH 768
+#define XENOPHYTE_PACKET_CHUNK_CHARACTERS (XENOPHYTE_PACKET_CHUNK_LENGTH / 3 * 4)
+
+struct XENOPHYTE_PACKET_CODEC {
+    DOTNET_BYTE AesIv[16];
+
+    EVP_CIPHER_CTX *EncryptContext;
+
+    // The multi buffer kernel decrypts when the cpu has it, otherwise the OpenSSL context streams the cipher text.
+    AES_MULTI_BUFFER_KEY DecryptKey;
+    EVP_CIPHER_CTX *DecryptContext;
+    DOTNET_BOOL HasDecryptKernel;
+
+    // The last 16 cipher text bytes of the packet being decoded, the next byte is decrypted from them.
+    DOTNET_BYTE CipherTextWindow[16];
+
+    // Base64 characters that do not form a whole group yet.
+    DOTNET_BYTE Characters[4];
+    DOTNET_INT CharactersLength;
+    DOTNET_BOOL HasPaddingCharacters;
+
+    DOTNET_SPAN_BYTE Packet;
+    DOTNET_INT PacketLength;
+    DOTNET_INT PacketCapacity;
+    DOTNET_INT MaxPacketLength;
+    DOTNET_BOOL IsPacketComplete;
+};
+
+DOTNET_PRIVATE DOTNET_BOOL StartPacket(XENOPHYTE_PACKET_CODEC *codec) {
+    memcpy(codec->CipherTextWindow, codec->AesIv, 16);
+
+    codec->CharactersLength = 0;
+    codec->HasPaddingCharacters = DOTNET_FALSE;
+    codec->PacketLength = 0;
+    codec->IsPacketComplete = DOTNET_FALSE;
+
+    return codec->HasDecryptKernel || EVP_DecryptInit_ex(codec->DecryptContext, NULL, NULL, NULL, codec->AesIv);
+}
+
+DOTNET_PRIVATE DOTNET_BOOL DecryptCipherText(XENOPHYTE_PACKET_CODEC *codec, DOTNET_READ_ONLY_SPAN_BYTE cipherText, DOTNET_INT cipherTextLength) {
+    if (cipherTextLength == 0) {
+        return DOTNET_TRUE;
+    }
+
+    if (cipherTextLength > codec->MaxPacketLength - codec->PacketLength) {
+        return DOTNET_FALSE;
+    }
+
+    if (codec->PacketLength + cipherTextLength > codec->PacketCapacity) {
+        DOTNET_INT capacity = codec->PacketCapacity;
+
+        while (capacity < codec->PacketLength + cipherTextLength) {
+            capacity = capacity > codec->MaxPacketLength / 2 ? codec->MaxPacketLength : capacity * 2;
+        }
+
+        DOTNET_SPAN_BYTE packet = realloc(codec->Packet, capacity);
+
+        if (packet == NULL) {
+            return DOTNET_FALSE;
+        }
+
+        codec->Packet = packet;
+        codec->PacketCapacity = capacity;
+    }
+
+    DOTNET_SPAN_BYTE destination = codec->Packet + codec->PacketLength;
+    codec->PacketLength += cipherTextLength;
+
+    if (!codec->HasDecryptKernel) {
+        DOTNET_INT outputLength;
+        return EVP_DecryptUpdate(codec->DecryptContext, destination, &outputLength, cipherText, cipherTextLength);
+    }
+
+    if (!AesMultiBufferUtility_Decrypt_CFB8(&codec->DecryptKey, codec->CipherTextWindow, cipherText, cipherTextLength, destination)) {
+        return DOTNET_FALSE;
+    }
+
+    if (cipherTextLength >= 16) {
+        memcpy(codec->CipherTextWindow, cipherText + cipherTextLength - 16, 16);
+    } else {
+        memmove(codec->CipherTextWindow, codec->CipherTextWindow + cipherTextLength, 16 - cipherTextLength);
+        memcpy(codec->CipherTextWindow + 16 - cipherTextLength, cipherText, cipherTextLength);
+    }
+
+    return DOTNET_TRUE;
+}
+
+// Only whole groups are decoded, the padded group has to be the last one of the packet.
+DOTNET_PRIVATE DOTNET_BOOL DecodeGroups(XENOPHYTE_PACKET_CODEC *codec, DOTNET_READ_ONLY_SPAN_BYTE characters, DOTNET_INT charactersLength) {
+    if (charactersLength == 0) {
+        return DOTNET_TRUE;
+    }
+
+    if (codec->HasPaddingCharacters) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_BYTE cipherText[XENOPHYTE_PACKET_CHUNK_LENGTH];
+    DOTNET_INT cipherTextLength = Base64Utility_Decode(characters, charactersLength, cipherText);
+
+    if (cipherTextLength < 0) {
+        return DOTNET_FALSE;
+    }
+
+    codec->HasPaddingCharacters = characters[charactersLength - 1] == '=';
+
+    return DecryptCipherText(codec, cipherText, cipherTextLength);
+}
+
+DOTNET_PRIVATE DOTNET_BOOL DecodeCharacters(XENOPHYTE_PACKET_CODEC *codec, DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength) {
+    DOTNET_INT offset = 0;
+
+    if (codec->CharactersLength > 0) {
+        while (codec->CharactersLength < 4 && offset < inputLength) {
+            codec->Characters[codec->CharactersLength++] = input[offset++];
+        }
+
+        if (codec->CharactersLength < 4) {
+            return DOTNET_TRUE;
+        }
+
+        codec->CharactersLength = 0;
+
+        if (!DecodeGroups(codec, codec->Characters, 4)) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    DOTNET_INT groupsLength = (inputLength - offset) / 4 * 4;
+
+    for (DOTNET_INT i = 0; i < groupsLength; i += XENOPHYTE_PACKET_CHUNK_CHARACTERS) {
+        DOTNET_INT length = groupsLength - i < XENOPHYTE_PACKET_CHUNK_CHARACTERS ? groupsLength - i : XENOPHYTE_PACKET_CHUNK_CHARACTERS;
+
+        if (!DecodeGroups(codec, input + offset + i, length)) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    offset += groupsLength;
+    codec->CharactersLength = inputLength - offset;
+    memcpy(codec->Characters, input + offset, codec->CharactersLength);
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_PUBLIC XENOPHYTE_PACKET_CODEC *XenophyteCentralizedPacketCodec_Create(DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT maxPacketLength) {
+    if (aesKey == NULL || aesIv == NULL || maxPacketLength <= 0) {
+        return NULL;
+    }
+
+    const EVP_CIPHER *cipher = CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_256_CFB8);
+
+    if (cipher == NULL) {
+        return NULL;
+    }
+
+    XENOPHYTE_PACKET_CODEC *codec = calloc(1, sizeof(XENOPHYTE_PACKET_CODEC));
+
+    if (codec == NULL) {
+        return NULL;
+    }
+
+    memcpy(codec->AesIv, aesIv, sizeof(codec->AesIv));
+    codec->MaxPacketLength = maxPacketLength;
+    codec->IsPacketComplete = DOTNET_TRUE;
+
+    codec->EncryptContext = SymmetricAlgorithmUtility_CreateEncryptContext_EVP_CIPHER(cipher, aesKey);
+
+    if (codec->EncryptContext == NULL) {
+        XenophyteCentralizedPacketCodec_Free(codec);
+        return NULL;
+    }
+
+    codec->HasDecryptKernel = AesMultiBufferUtility_GetLaneCount() > 0 && AesMultiBufferUtility_ExpandKey(&codec->DecryptKey, 256, aesKey);
+
+    if (!codec->HasDecryptKernel) {
+        codec->DecryptContext = EVP_CIPHER_CTX_new();
+
+        if (codec->DecryptContext == NULL || !EVP_DecryptInit_ex(codec->DecryptContext, cipher, NULL, aesKey, NULL)) {
+            XenophyteCentralizedPacketCodec_Free(codec);
+            return NULL;
+        }
+    }
+
+    codec->PacketCapacity = XENOPHYTE_PACKET_CHUNK_LENGTH < maxPacketLength ? XENOPHYTE_PACKET_CHUNK_LENGTH : maxPacketLength;
+    codec->Packet = malloc(codec->PacketCapacity);
+
+    if (codec->Packet == NULL) {
+        XenophyteCentralizedPacketCodec_Free(codec);
+        return NULL;
+    }
+
+    return codec;
+}
+
+DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedPacketCodec_GetEncodeLength(DOTNET_INT packetLength) {
+    if (packetLength <= 0) {
+        return 0;
+    }
+
+    return Base64Utility_EncodeLength(packetLength + SymmetricAlgorithmUtility_GetPaddedLength(packetLength)) + 1;
+}
+
+DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedPacketCodec_Encode(XENOPHYTE_PACKET_CODEC *codec, DOTNET_READ_ONLY_SPAN_BYTE packet, DOTNET_INT packetLength, DOTNET_SPAN_BYTE output) {
+    if (codec == NULL || packet == NULL || packetLength <= 0 || output == NULL) {
+        return 0;
+    }
+
+    if (!EVP_EncryptInit_ex(codec->EncryptContext, NULL, NULL, NULL, codec->AesIv)) {
+        return 0;
+    }
+
+    DOTNET_INT paddingLength = SymmetricAlgorithmUtility_GetPaddedLength(packetLength);
+    DOTNET_INT paddedLength = packetLength + paddingLength;
+    DOTNET_INT outputLength = 0;
+
+    DOTNET_BYTE padding[16];
+    memset(padding, paddingLength, sizeof(padding));
+
+    // Each piece is encrypted into a stack buffer and Base64 encoded straight into the output while it is still in cache.
+    for (DOTNET_INT offset = 0; offset < paddedLength; offset += XENOPHYTE_PACKET_CHUNK_LENGTH) {
+        DOTNET_BYTE cipherText[XENOPHYTE_PACKET_CHUNK_LENGTH];
+        DOTNET_INT chunkLength = paddedLength - offset < XENOPHYTE_PACKET_CHUNK_LENGTH ? paddedLength - offset : XENOPHYTE_PACKET_CHUNK_LENGTH;
+        DOTNET_INT plainTextLength = packetLength - offset < chunkLength ? (packetLength > offset ? packetLength - offset : 0) : chunkLength;
+        DOTNET_INT cipherTextLength;
+
+        if (plainTextLength > 0 && !EVP_EncryptUpdate(codec->EncryptContext, cipherText, &cipherTextLength, packet + offset, plainTextLength)) {
+            return 0;
+        }
+
+        if (plainTextLength < chunkLength && !EVP_EncryptUpdate(codec->EncryptContext, cipherText + plainTextLength, &cipherTextLength, padding, chunkLength - plainTextLength)) {
+            return 0;
+        }
+
+        outputLength += Base64Utility_Encode(cipherText, chunkLength, output + outputLength);
+    }
+
+    output[outputLength++] = XENOPHYTE_PACKET_TERMINATOR;
+
+    return outputLength;
+}
+
+DOTNET_PUBLIC DOTNET_INT XenophyteCentralizedPacketCodec_Decode(XENOPHYTE_PACKET_CODEC *codec, DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_INT *packetLength) {
+    if (codec == NULL || input == NULL || inputLength < 0 || packetLength == NULL) {
+        return -1;
+    }
+
+    *packetLength = -1;
+
+    if (codec->IsPacketComplete && !StartPacket(codec)) {
+        return -1;
+    }
+
+    DOTNET_READ_ONLY_SPAN_BYTE terminator = memchr(input, XENOPHYTE_PACKET_TERMINATOR, inputLength);
+    DOTNET_INT charactersLength = terminator != NULL ? (DOTNET_INT) (terminator - input) : inputLength;
+
+    // A malformed packet is dropped, the next call starts a new one.
+    if (!DecodeCharacters(codec, input, charactersLength)) {
+        codec->IsPacketComplete = DOTNET_TRUE;
+        return -1;
+    }
+
+    if (terminator == NULL) {
+        return inputLength;
+    }
+
+    codec->IsPacketComplete = DOTNET_TRUE;
+
+    if (codec->CharactersLength != 0 || codec->PacketLength == 0) {
+        return -1;
+    }
+
+    DOTNET_INT paddingLength = codec->Packet[codec->PacketLength - 1];
+
+    if (paddingLength == 0 || paddingLength > 16 || paddingLength > codec->PacketLength) {
+        return -1;
+    }
+
+    *packetLength = codec->PacketLength - paddingLength;
+
+    return charactersLength + 1;
+}
+
+DOTNET_PUBLIC DOTNET_READ_ONLY_SPAN_BYTE XenophyteCentralizedPacketCodec_GetPacket(XENOPHYTE_PACKET_CODEC *codec) {
+    if (codec == NULL) {
+        return NULL;
+    }
+
+    return codec->Packet;
+}
+
+DOTNET_PUBLIC void XenophyteCentralizedPacketCodec_Free(XENOPHYTE_PACKET_CODEC *codec) {
+    if (codec == NULL) {
+        return;
+    }
+
+    EVP_CIPHER_CTX_free(codec->EncryptContext);
+    EVP_CIPHER_CTX_free(codec->DecryptContext);
+    free(codec->Packet);
+    free(codec);
+}
@@ -0,0 +1,21 @@
+#ifndef XENOPHYTECENTRALIZEDPACKETCODEC_H
+#define XENOPHYTECENTRALIZEDPACKETCODEC_H
+
+#include "global.h"
+
+#define XENOPHYTE_PACKET_TERMINATOR '*'
+
+// Solo network packets are AES-256-CFB8 encrypted with PKCS7 padding, Base64 encoded and terminated by '*', every packet restarts from the iv.
+typedef struct XENOPHYTE_PACKET_CODEC XENOPHYTE_PACKET_CODEC;
+
+XENOPHYTE_PACKET_CODEC *XenophyteCentralizedPacketCodec_Create(DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT maxPacketLength);
+DOTNET_INT XenophyteCentralizedPacketCodec_GetEncodeLength(DOTNET_INT packetLength);
+DOTNET_INT XenophyteCentralizedPacketCodec_Encode(XENOPHYTE_PACKET_CODEC *codec, DOTNET_READ_ONLY_SPAN_BYTE packet, DOTNET_INT packetLength, DOTNET_SPAN_BYTE output);
+
+// Consumes input up to and including the first terminator and returns the bytes consumed, or -1 when the packet is malformed.
+// A finished packet sets packetLength, it stays readable through GetPacket until the next Decode call, otherwise packetLength is -1.
+DOTNET_INT XenophyteCentralizedPacketCodec_Decode(XENOPHYTE_PACKET_CODEC *codec, DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_INT *packetLength);
+DOTNET_READ_ONLY_SPAN_BYTE XenophyteCentralizedPacketCodec_GetPacket(XENOPHYTE_PACKET_CODEC *codec);
+void XenophyteCentralizedPacketCodec_Free(XENOPHYTE_PACKET_CODEC *codec);
+
+#endif
@@ -0,0 +1,653 @@
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
+#include "XenophyteCentralizedSearchEngine.h"
+#include "XenophyteCentralizedAlgorithm.h"
+#include "Utilities/RandomNumberGeneratorUtility.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#define XENOPHYTE_SEARCH_EASY_BLOCK_MAX_LENGTH 256
+#define XENOPHYTE_SEARCH_EASY_BLOCK_CLAIM_LENGTH 256
+#define XENOPHYTE_SEARCH_BATCH_SIZE 4096
+#define XENOPHYTE_SEARCH_SOLUTION_QUEUE_LENGTH 16
+#define XENOPHYTE_SEARCH_RANDOM_PAIRS_LENGTH 1024
+
+typedef struct XENOPHYTE_SEARCH_WORKER {
+    XENOPHYTE_SEARCH_ENGINE *Engine;
+    DOTNET_INT Index;
+    XENOPHYTE_SEARCH_THREAD_OPTIONS Options;
+
+    pthread_t Thread;
+    DOTNET_BOOL IsThreadStarted;
+
+    XENOPHYTE_SHARE_CTX *ShareContext;
+    XENOPHYTE_SHARE_CTX *PendingShareContext;
+
+    DOTNET_LONG JobId;
+    DOTNET_LONG BlockMinRange;
+    DOTNET_LONG BlockMaxRange;
+    DOTNET_LONG Timestamp;
+
+    DOTNET_LONG EasyBlockValues[XENOPHYTE_SEARCH_EASY_BLOCK_MAX_LENGTH];
+    DOTNET_LONG ShuffledEasyBlockValues[XENOPHYTE_SEARCH_EASY_BLOCK_MAX_LENGTH];
+    DOTNET_INT EasyBlockValuesLength;
+    DOTNET_LONG NonEasyBlockValuesLength;
+
+    DOTNET_INT EasyBlockPairsLength;
+    DOTNET_INT EasyBlockPairsMultiplier;
+    DOTNET_INT EasyBlockPairsOffset;
+    DOTNET_INT PendingEasyBlockPairs;
+    DOTNET_INT EasyBlockPairsDone;
+
+    XENOPHYTE_SHARE_CANDIDATE Candidates[XENOPHYTE_SEARCH_BATCH_SIZE];
+    DOTNET_INT CandidateJobTypes[XENOPHYTE_SEARCH_BATCH_SIZE];
+    DOTNET_INT CandidatesLength;
+
+    // Random non easy pairs generated ahead in bulk, a new job marks them all as used since the range may have changed.
+    DOTNET_LONG RandomFirstNumbers[XENOPHYTE_SEARCH_RANDOM_PAIRS_LENGTH];
+    DOTNET_LONG RandomSecondNumbers[XENOPHYTE_SEARCH_RANDOM_PAIRS_LENGTH];
+    DOTNET_INT RandomPairsIndex;
+
+    RANDOM_NUMBER_GENERATOR Random;
+    RANDOM_NUMBER_GENERATOR_LANES RandomLanes;
+    DOTNET_LONG HashCount;
+} XENOPHYTE_SEARCH_WORKER;
+
+typedef struct XENOPHYTE_SEARCH_SOLUTION_ENTRY {
+    XENOPHYTE_SEARCH_SOLUTION Solution;
+    DOTNET_BYTE EncryptedShare[64 * 2];
+} XENOPHYTE_SEARCH_SOLUTION_ENTRY;
+
+struct XENOPHYTE_SEARCH_ENGINE {
+    pthread_mutex_t Lock;
+    pthread_cond_t JobAvailable;
+    pthread_cond_t SolutionAvailable;
+    DOTNET_BOOL IsShutdown;
+
+    // Zero while there is nothing to search, workers stop as soon as it no longer matches the job they are running.
+    DOTNET_LONG ActiveJobId;
+    DOTNET_LONG NextJobId;
+
+    DOTNET_LONG BlockMinRange;
+    DOTNET_LONG BlockMaxRange;
+    DOTNET_LONG Timestamp;
+    DOTNET_LONG EasyBlockValues[XENOPHYTE_SEARCH_EASY_BLOCK_MAX_LENGTH];
+    DOTNET_INT EasyBlockValuesLength;
+
+    // Every ordered pair of easy block values is visited once per job: pair index i is the permuted position (i * multiplier + offset) % length.
+    // The cursor keeps the job id in its upper half, so a thread still finishing an older job can never claim pairs of the new one.
+    DOTNET_ULONG EasyBlockPairsCursor;
+    DOTNET_INT EasyBlockPairsLength;
+    DOTNET_INT EasyBlockPairsMultiplier;
+    DOTNET_INT EasyBlockPairsOffset;
+
+    XENOPHYTE_SEARCH_SOLUTION_ENTRY Solutions[XENOPHYTE_SEARCH_SOLUTION_QUEUE_LENGTH];
+    DOTNET_INT SolutionsHead;
+    DOTNET_INT SolutionsLength;
+
+    RANDOM_NUMBER_GENERATOR Random;
+
+    XENOPHYTE_SEARCH_WORKER *Workers;
+    DOTNET_INT WorkerCount;
+};
+
+DOTNET_PRIVATE void SetCurrentThreadPlacement(const XENOPHYTE_SEARCH_THREAD_OPTIONS *options) {
+#ifdef _WIN32
+    if (options->ThreadAffinity != 0) {
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR) options->ThreadAffinity);
+    }
+
+    // System.Threading.ThreadPriority goes from Lowest (0) to Highest (4), the win32 priorities go from -2 to 2.
+    if (options->ThreadPriority >= 0 && options->ThreadPriority <= 4) {
+        SetThreadPriority(GetCurrentThread(), options->ThreadPriority - 2);
+    }
+#elif defined(__linux__)
+    if (options->ThreadAffinity != 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+
+        for (DOTNET_INT i = 0; i < 64; i++) {
+            if (options->ThreadAffinity >> i & 1) {
+                CPU_SET(i, &cpuSet);
+            }
+        }
+
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    }
+#else
+    (void) options;
+#endif
+}
+
+DOTNET_PRIVATE DOTNET_INT GetGreatestCommonDivisor(DOTNET_INT a, DOTNET_INT b) {
+    while (b != 0) {
+        DOTNET_INT temp = a % b;
+        a = b;
+        b = temp;
+    }
+
+    return a;
+}
+
+inline DOTNET_PRIVATE DOTNET_BOOL IsJobActive(const XENOPHYTE_SEARCH_WORKER *worker) {
+    return __atomic_load_n(&worker->Engine->ActiveJobId, __ATOMIC_ACQUIRE) == worker->JobId;
+}
+
+DOTNET_PRIVATE void ReportSolution(XENOPHYTE_SEARCH_WORKER *worker, const XENOPHYTE_SHARE_CANDIDATE *candidate, DOTNET_INT jobType, DOTNET_READ_ONLY_SPAN_BYTE encryptedShare) {
+    XENOPHYTE_SEARCH_ENGINE *engine = worker->Engine;
+
+    pthread_mutex_lock(&engine->Lock);
+
+    // The first solution ends the job for every thread, anything found for the same job afterwards is dropped.
+    if (engine->ActiveJobId == worker->JobId) {
+        if (engine->SolutionsLength == XENOPHYTE_SEARCH_SOLUTION_QUEUE_LENGTH) {
+            engine->SolutionsHead = (engine->SolutionsHead + 1) % XENOPHYTE_SEARCH_SOLUTION_QUEUE_LENGTH;
+            engine->SolutionsLength--;
+        }
+
+        XENOPHYTE_SEARCH_SOLUTION_ENTRY *entry = &engine->Solutions[(engine->SolutionsHead + engine->SolutionsLength) % XENOPHYTE_SEARCH_SOLUTION_QUEUE_LENGTH];
+
+        entry->Solution.JobId = worker->JobId;
+        entry->Solution.FirstNumber = candidate->FirstNumber;
+        entry->Solution.SecondNumber = candidate->SecondNumber;
+        entry->Solution.Solution = candidate->Solution;
+        entry->Solution.Operator = candidate->Operator;
+        entry->Solution.JobType = jobType;
+        entry->Solution.ThreadIndex = worker->Index;
+        memcpy(entry->EncryptedShare, encryptedShare, 64 * 2);
+
+        engine->SolutionsLength++;
+
+        __atomic_store_n(&engine->ActiveJobId, 0, __ATOMIC_RELEASE);
+        pthread_cond_broadcast(&engine->SolutionAvailable);
+    }
+
+    pthread_mutex_unlock(&engine->Lock);
+}
+
+DOTNET_PRIVATE void FlushCandidates(XENOPHYTE_SEARCH_WORKER *worker) {
+    // Whatever is left over from a cancelled or solved job is thrown away.
+    if (!IsJobActive(worker)) {
+        worker->CandidatesLength = 0;
+        worker->PendingEasyBlockPairs = 0;
+        return;
+    }
+
+    if (worker->CandidatesLength > 0) {
+        DOTNET_INT matchIndex;
+        DOTNET_BYTE encryptedShare[64 * 2];
+
+        DOTNET_INT matches = XenophyteCentralizedAlgorithm_MakeEncryptedShareBatch(worker->ShareContext, worker->Candidates, worker->CandidatesLength, worker->Timestamp, &matchIndex, encryptedShare, 1);
+
+        if (matches >= 0) {
+            __atomic_add_fetch(&worker->HashCount, worker->CandidatesLength, __ATOMIC_RELAXED);
+        }
+
+        if (matches > 0) {
+            ReportSolution(worker, &worker->Candidates[matchIndex], worker->CandidateJobTypes[matchIndex], encryptedShare);
+        }
+    }
+
+    // Easy block pairs only count as covered once their candidates went through the batch.
+    if (worker->PendingEasyBlockPairs > 0) {
+        __atomic_add_fetch(&worker->EasyBlockPairsDone, worker->PendingEasyBlockPairs, __ATOMIC_RELAXED);
+    }
+
+    worker->CandidatesLength = 0;
+    worker->PendingEasyBlockPairs = 0;
+}
+
+DOTNET_PRIVATE void AddCandidate(XENOPHYTE_SEARCH_WORKER *worker, DOTNET_LONG firstNumber, DOTNET_CHAR op, DOTNET_LONG secondNumber, DOTNET_LONG solution, DOTNET_INT jobType) {
+    XENOPHYTE_SHARE_CANDIDATE *candidate = &worker->Candidates[worker->CandidatesLength];
+
+    candidate->FirstNumber = firstNumber;
+    candidate->SecondNumber = secondNumber;
+    candidate->Solution = solution;
+    candidate->Operator = op;
+
+    worker->CandidateJobTypes[worker->CandidatesLength] = jobType;
+    worker->CandidatesLength++;
+
+    if (worker->CandidatesLength == XENOPHYTE_SEARCH_BATCH_SIZE) {
+        FlushCandidates(worker);
+    }
+}
+
+DOTNET_PRIVATE void DoMathCalculations(XENOPHYTE_SEARCH_WORKER *worker, DOTNET_LONG firstNumber, DOTNET_LONG secondNumber, DOTNET_INT jobType) {
+    DOTNET_LONG blockMinRange = worker->BlockMinRange;
+    DOTNET_LONG blockMaxRange = worker->BlockMaxRange;
+
+    // Zero can only show up for ranges starting at or below zero, it has no division or modulo result.
+    DOTNET_BOOL canDivide = secondNumber != 0 && !(firstNumber == DOTNET_LONG_MIN && secondNumber == -1);
+
+    if (firstNumber > secondNumber) {
+        // Subtraction Rule:
+        DOTNET_LONG subtractionResult = (DOTNET_LONG) ((DOTNET_ULONG) firstNumber - (DOTNET_ULONG) secondNumber);
+
+        if (subtractionResult >= blockMinRange) {
+            AddCandidate(worker, firstNumber, '-', secondNumber, subtractionResult, jobType);
+        }
+
+        if (canDivide) {
+            DOTNET_LONG integerDivideResult = firstNumber / secondNumber;
+            DOTNET_LONG integerDivideRemainder = firstNumber % secondNumber;
+
+            // Division Rule:
+            if (integerDivideRemainder == 0 && integerDivideResult >= blockMinRange) {
+                AddCandidate(worker, firstNumber, '/', secondNumber, integerDivideResult, jobType);
+            }
+
+            // Modulo Rule:
+            if (integerDivideRemainder >= blockMinRange) {
+                AddCandidate(worker, firstNumber, '%', secondNumber, integerDivideRemainder, jobType);
+            }
+        }
+    } else if (canDivide) {
+        DOTNET_LONG integerDivideRemainder = firstNumber % secondNumber;
+
+        // Modulo Rule:
+        if (integerDivideRemainder >= blockMinRange) {
+            AddCandidate(worker, firstNumber, '%', secondNumber, integerDivideRemainder, jobType);
+        }
+    }
+
+    // Addition Rule:
+    DOTNET_LONG additionResult = (DOTNET_LONG) ((DOTNET_ULONG) firstNumber + (DOTNET_ULONG) secondNumber);
+
+    if (additionResult <= blockMaxRange) {
+        AddCandidate(worker, firstNumber, '+', secondNumber, additionResult, jobType);
+    }
+
+    // Multiplication Rule:
+    DOTNET_LONG multiplicationResult = (DOTNET_LONG) ((DOTNET_ULONG) firstNumber * (DOTNET_ULONG) secondNumber);
+
+    if (multiplicationResult <= blockMaxRange) {
+        AddCandidate(worker, firstNumber, '*', secondNumber, multiplicationResult, jobType);
+    }
+}
+
+DOTNET_PRIVATE DOTNET_BOOL ClaimEasyBlockPairs(XENOPHYTE_SEARCH_WORKER *worker, DOTNET_INT *start, DOTNET_INT *length) {
+    XENOPHYTE_SEARCH_ENGINE *engine = worker->Engine;
+    DOTNET_ULONG jobTag = (DOTNET_ULONG) (DOTNET_UINT) worker->JobId << 32;
+    DOTNET_ULONG cursor = __atomic_load_n(&engine->EasyBlockPairsCursor, __ATOMIC_RELAXED);
+
+    while (DOTNET_TRUE) {
+        DOTNET_INT position = (DOTNET_INT) (DOTNET_UINT) cursor;
+
+        if ((cursor & 0xFFFFFFFF00000000) != jobTag || position >= worker->EasyBlockPairsLength) {
+            return DOTNET_FALSE;
+        }
+
+        DOTNET_INT claimLength = worker->EasyBlockPairsLength - position < XENOPHYTE_SEARCH_EASY_BLOCK_CLAIM_LENGTH ? worker->EasyBlockPairsLength - position : XENOPHYTE_SEARCH_EASY_BLOCK_CLAIM_LENGTH;
+
+        if (__atomic_compare_exchange_n(&engine->EasyBlockPairsCursor, &cursor, jobTag | (DOTNET_UINT) (position + claimLength), DOTNET_TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *start = position;
+            *length = claimLength;
+            return DOTNET_TRUE;
+        }
+    }
+}
+
+DOTNET_PRIVATE void DoEasyBlockCalculations(XENOPHYTE_SEARCH_WORKER *worker, DOTNET_INT start, DOTNET_INT length) {
+    DOTNET_UINT pairsLength = (DOTNET_UINT) worker->EasyBlockPairsLength;
+    DOTNET_UINT easyBlockValuesLength = (DOTNET_UINT) worker->EasyBlockValuesLength;
+
+    for (DOTNET_INT i = start; i < start + length; i++) {
+        // Both factors are below 256 * 256, so the product fits before the modulo.
+        DOTNET_UINT pair = ((DOTNET_UINT) i * (DOTNET_UINT) worker->EasyBlockPairsMultiplier + (DOTNET_UINT) worker->EasyBlockPairsOffset) % pairsLength;
+
+        DoMathCalculations(worker, worker->EasyBlockValues[pair / easyBlockValuesLength], worker->EasyBlockValues[pair % easyBlockValuesLength], XENOPHYTE_SEARCH_JOB_TYPE_EASY);
+    }
+
+    worker->PendingEasyBlockPairs += length;
+}
+
+DOTNET_PRIVATE void DoRandomCalculations(XENOPHYTE_SEARCH_WORKER *worker) {
+    if (worker->RandomPairsIndex == XENOPHYTE_SEARCH_RANDOM_PAIRS_LENGTH) {
+        XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(&worker->RandomLanes, worker->BlockMinRange, worker->BlockMaxRange, worker->Options.UseXenophyteRandomizer, worker->RandomFirstNumbers, worker->RandomSecondNumbers, XENOPHYTE_SEARCH_RANDOM_PAIRS_LENGTH);
+        worker->RandomPairsIndex = 0;
+    }
+
+    DOTNET_LONG choseRandom = worker->RandomFirstNumbers[worker->RandomPairsIndex];
+    DOTNET_LONG choseRandom2 = worker->RandomSecondNumbers[worker->RandomPairsIndex];
+    worker->RandomPairsIndex++;
+
+    DoMathCalculations(worker, choseRandom, choseRandom2, XENOPHYTE_SEARCH_JOB_TYPE_RANDOM);
+    DoMathCalculations(worker, choseRandom2, choseRandom, XENOPHYTE_SEARCH_JOB_TYPE_RANDOM);
+
+    DOTNET_SPAN_LONG easyBlockValues = worker->ShuffledEasyBlockValues;
+
+    for (DOTNET_INT i = worker->EasyBlockValuesLength - 1; i >= 0; i--) {
+        DOTNET_INT choseRandom3 = (DOTNET_INT) RandomNumberGeneratorUtility_GetRandomBetween(&worker->Random, 0, i);
+        DOTNET_LONG easyBlockValue = easyBlockValues[choseRandom3];
+
+        DoMathCalculations(worker, choseRandom, easyBlockValue, XENOPHYTE_SEARCH_JOB_TYPE_SEMI_RANDOM);
+        DoMathCalculations(worker, easyBlockValue, choseRandom, XENOPHYTE_SEARCH_JOB_TYPE_SEMI_RANDOM);
+
+        DoMathCalculations(worker, choseRandom2, easyBlockValue, XENOPHYTE_SEARCH_JOB_TYPE_SEMI_RANDOM);
+        DoMathCalculations(worker, easyBlockValue, choseRandom2, XENOPHYTE_SEARCH_JOB_TYPE_SEMI_RANDOM);
+
+        easyBlockValues[choseRandom3] = easyBlockValues[i];
+        easyBlockValues[i] = easyBlockValue;
+    }
+}
+
+DOTNET_PRIVATE void RunSearchJob(XENOPHYTE_SEARCH_WORKER *worker) {
+    worker->CandidatesLength = 0;
+
+    if (worker->Options.DoEasyBlock) {
+        DOTNET_INT start;
+        DOTNET_INT length;
+
+        while (IsJobActive(worker) && ClaimEasyBlockPairs(worker, &start, &length)) {
+            DoEasyBlockCalculations(worker, start, length);
+        }
+    }
+
+    // Random values have to avoid the easy block values, a range made only of easy block values has none left.
+    if (worker->NonEasyBlockValuesLength > 0) {
+        while (IsJobActive(worker)) {
+            DoRandomCalculations(worker);
+        }
+    }
+
+    FlushCandidates(worker);
+}
+
+DOTNET_PRIVATE void *RunSearchWorker(void *argument) {
+    XENOPHYTE_SEARCH_WORKER *worker = argument;
+    XENOPHYTE_SEARCH_ENGINE *engine = worker->Engine;
+
+    SetCurrentThreadPlacement(&worker->Options);
+
+    DOTNET_LONG lastJobId = 0;
+
+    pthread_mutex_lock(&engine->Lock);
+
+    while (DOTNET_TRUE) {
+        while (!engine->IsShutdown && (engine->ActiveJobId == 0 || engine->ActiveJobId == lastJobId)) {
+            pthread_cond_wait(&engine->JobAvailable, &engine->Lock);
+        }
+
+        if (engine->IsShutdown) {
+            break;
+        }
+
+        lastJobId = engine->ActiveJobId;
+
+        if (worker->PendingShareContext != NULL) {
+            XenophyteCentralizedAlgorithm_FreeShareContext(worker->ShareContext);
+            worker->ShareContext = worker->PendingShareContext;
+            worker->PendingShareContext = NULL;
+        }
+
+        worker->JobId = lastJobId;
+        worker->BlockMinRange = engine->BlockMinRange;
+        worker->BlockMaxRange = engine->BlockMaxRange;
+        worker->Timestamp = engine->Timestamp;
+        worker->EasyBlockValuesLength = engine->EasyBlockValuesLength;
+        worker->NonEasyBlockValuesLength = XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(engine->BlockMinRange, engine->BlockMaxRange);
+        worker->RandomPairsIndex = XENOPHYTE_SEARCH_RANDOM_PAIRS_LENGTH;
+        worker->EasyBlockPairsLength = engine->EasyBlockPairsLength;
+        worker->EasyBlockPairsMultiplier = engine->EasyBlockPairsMultiplier;
+        worker->EasyBlockPairsOffset = engine->EasyBlockPairsOffset;
+        worker->PendingEasyBlockPairs = 0;
+        __atomic_store_n(&worker->EasyBlockPairsDone, 0, __ATOMIC_RELAXED);
+
+        memcpy(worker->EasyBlockValues, engine->EasyBlockValues, sizeof(DOTNET_LONG) * engine->EasyBlockValuesLength);
+        memcpy(worker->ShuffledEasyBlockValues, engine->EasyBlockValues, sizeof(DOTNET_LONG) * engine->EasyBlockValuesLength);
+
+        pthread_mutex_unlock(&engine->Lock);
+
+        RunSearchJob(worker);
+
+        pthread_mutex_lock(&engine->Lock);
+    }
+
+    pthread_mutex_unlock(&engine->Lock);
+
+    return NULL;
+}
+
+DOTNET_PUBLIC XENOPHYTE_SEARCH_ENGINE *XenophyteCentralizedSearchEngine_Create(const XENOPHYTE_SEARCH_THREAD_OPTIONS *threadOptions, DOTNET_INT threadCount) {
+    if (threadOptions == NULL || threadCount <= 0) {
+        return NULL;
+    }
+
+    XENOPHYTE_SEARCH_ENGINE *engine = calloc(1, sizeof(XENOPHYTE_SEARCH_ENGINE));
+
+    if (engine == NULL) {
+        return NULL;
+    }
+
+    engine->Workers = calloc(threadCount, sizeof(XENOPHYTE_SEARCH_WORKER));
+
+    if (engine->Workers == NULL || !RandomNumberGeneratorUtility_Initialize(&engine->Random) ||
+        pthread_mutex_init(&engine->Lock, NULL) != 0 || pthread_cond_init(&engine->JobAvailable, NULL) != 0 || pthread_cond_init(&engine->SolutionAvailable, NULL) != 0) {
+        free(engine->Workers);
+        free(engine);
+        return NULL;
+    }
+
+    for (DOTNET_INT i = 0; i < threadCount; i++) {
+        XENOPHYTE_SEARCH_WORKER *worker = &engine->Workers[i];
+
+        worker->Engine = engine;
+        worker->Index = i;
+        worker->Options = threadOptions[i];
+
+        if (!RandomNumberGeneratorUtility_Initialize(&worker->Random) || !RandomNumberGeneratorUtility_InitializeLanes(&worker->RandomLanes, 0)) {
+            XenophyteCentralizedSearchEngine_Free(engine);
+            return NULL;
+        }
+
+        engine->WorkerCount++;
+    }
+
+    for (DOTNET_INT i = 0; i < threadCount; i++) {
+        XENOPHYTE_SEARCH_WORKER *worker = &engine->Workers[i];
+
+        if (pthread_create(&worker->Thread, NULL, RunSearchWorker, worker) != 0) {
+            XenophyteCentralizedSearchEngine_Free(engine);
+            return NULL;
+        }
+
+        worker->IsThreadStarted = DOTNET_TRUE;
+    }
+
+    return engine;
+}
+
+DOTNET_PUBLIC DOTNET_LONG XenophyteCentralizedSearchEngine_StartJob(XENOPHYTE_SEARCH_ENGINE *engine, DOTNET_LONG blockMinRange, DOTNET_LONG blockMaxRange, DOTNET_LONG timestamp, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound, DOTNET_READ_ONLY_SPAN_BYTE blockIndication, DOTNET_INT blockIndicationLength) {
+    if (engine == NULL || blockMinRange > blockMaxRange) {
+        return 0;
+    }
+
+    XENOPHYTE_SHARE_CTX **shareContexts = calloc(engine->WorkerCount, sizeof(XENOPHYTE_SHARE_CTX *));
+
+    if (shareContexts == NULL) {
+        return 0;
+    }
+
+    // Every thread gets its own context, they are built up front so a bad job never replaces a running one.
+    for (DOTNET_INT i = 0; i < engine->WorkerCount; i++) {
+        shareContexts[i] = XenophyteCentralizedAlgorithm_CreateShareContext(xorKey, xorKeyLength, aesKeySize, aesKey, aesIv, aesRound);
+
+        if (shareContexts[i] == NULL || !XenophyteCentralizedAlgorithm_SetShareContextBlockIndication(shareContexts[i], blockIndication, blockIndicationLength)) {
+            for (DOTNET_INT j = 0; j <= i; j++) {
+                XenophyteCentralizedAlgorithm_FreeShareContext(shareContexts[j]);
+            }
+
+            free(shareContexts);
+            return 0;
+        }
+    }
+
+    pthread_mutex_lock(&engine->Lock);
+
+    DOTNET_LONG jobId = ++engine->NextJobId;
+
+    engine->BlockMinRange = blockMinRange;
+    engine->BlockMaxRange = blockMaxRange;
+    engine->Timestamp = timestamp;
+    engine->EasyBlockValuesLength = XenophyteCentralizedAlgorithm_GenerateEasyBlockNumbers(blockMinRange, blockMaxRange, engine->EasyBlockValues);
+
+    // Any multiplier sharing no factor with the length walks the pairs as a permutation, a fresh one per job spreads the early pairs over the whole space.
+    DOTNET_INT pairsLength = engine->EasyBlockValuesLength * engine->EasyBlockValuesLength;
+    DOTNET_INT multiplier = 1;
+
+    if (pairsLength > 1) {
+        do {
+            multiplier = (DOTNET_INT) RandomNumberGeneratorUtility_GetRandomBetween(&engine->Random, 1, pairsLength - 1);
+        } while (GetGreatestCommonDivisor(multiplier, pairsLength) != 1);
+    }
+
+    engine->EasyBlockPairsLength = pairsLength;
+    engine->EasyBlockPairsMultiplier = multiplier;
+    engine->EasyBlockPairsOffset = (DOTNET_INT) RandomNumberGeneratorUtility_GetRandomBetween(&engine->Random, 0, pairsLength - 1);
+    __atomic_store_n(&engine->EasyBlockPairsCursor, (DOTNET_ULONG) (DOTNET_UINT) jobId << 32, __ATOMIC_RELAXED);
+
+    for (DOTNET_INT i = 0; i < engine->WorkerCount; i++) {
+        XENOPHYTE_SEARCH_WORKER *worker = &engine->Workers[i];
+
+        XenophyteCentralizedAlgorithm_FreeShareContext(worker->PendingShareContext);
+        worker->PendingShareContext = shareContexts[i];
+    }
+
+    __atomic_store_n(&engine->ActiveJobId, jobId, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&engine->JobAvailable);
+
+    pthread_mutex_unlock(&engine->Lock);
+
+    free(shareContexts);
+
+    return jobId;
+}
+
+DOTNET_PUBLIC void XenophyteCentralizedSearchEngine_CancelJob(XENOPHYTE_SEARCH_ENGINE *engine) {
+    if (engine == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&engine->Lock);
+    __atomic_store_n(&engine->ActiveJobId, 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&engine->Lock);
+}
+
+DOTNET_PUBLIC DOTNET_BOOL XenophyteCentralizedSearchEngine_PollSolution(XENOPHYTE_SEARCH_ENGINE *engine, XENOPHYTE_SEARCH_SOLUTION *solution, DOTNET_SPAN_BYTE encryptedShare, DOTNET_INT timeoutMilliseconds) {
+    if (engine == NULL || solution == NULL || encryptedShare == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    pthread_mutex_lock(&engine->Lock);
+
+    if (engine->SolutionsLength == 0 && timeoutMilliseconds > 0) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        deadline.tv_sec += timeoutMilliseconds / 1000;
+        deadline.tv_nsec += (long) (timeoutMilliseconds % 1000) * 1000000;
+
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        while (engine->SolutionsLength == 0 && !engine->IsShutdown) {
+            if (pthread_cond_timedwait(&engine->SolutionAvailable, &engine->Lock, &deadline) == ETIMEDOUT) {
+                break;
+            }
+        }
+    }
+
+    DOTNET_BOOL hasSolution = engine->SolutionsLength > 0;
+
+    if (hasSolution) {
+        XENOPHYTE_SEARCH_SOLUTION_ENTRY *entry = &engine->Solutions[engine->SolutionsHead];
+
+        *solution = entry->Solution;
+        memcpy(encryptedShare, entry->EncryptedShare, 64 * 2);
+
+        engine->SolutionsHead = (engine->SolutionsHead + 1) % XENOPHYTE_SEARCH_SOLUTION_QUEUE_LENGTH;
+        engine->SolutionsLength--;
+    }
+
+    pthread_mutex_unlock(&engine->Lock);
+
+    return hasSolution;
+}
+
+DOTNET_PUBLIC DOTNET_LONG XenophyteCentralizedSearchEngine_TakeHashCount(XENOPHYTE_SEARCH_ENGINE *engine, DOTNET_INT threadIndex) {
+    if (engine == NULL || threadIndex < 0 || threadIndex >= engine->WorkerCount) {
+        return 0;
+    }
+
+    return __atomic_exchange_n(&engine->Workers[threadIndex].HashCount, 0, __ATOMIC_RELAXED);
+}
+
+DOTNET_PUBLIC DOTNET_DOUBLE XenophyteCentralizedSearchEngine_GetEasyBlockProgress(XENOPHYTE_SEARCH_ENGINE *engine) {
+    if (engine == NULL) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&engine->Lock);
+
+    // Threads that have not picked up the latest job yet still hold the count of the previous one.
+    DOTNET_LONG pairsDone = 0;
+
+    for (DOTNET_INT i = 0; i < engine->WorkerCount; i++) {
+        if (engine->Workers[i].JobId == engine->NextJobId) {
+            pairsDone += __atomic_load_n(&engine->Workers[i].EasyBlockPairsDone, __ATOMIC_RELAXED);
+        }
+    }
+
+    DOTNET_INT pairsLength = engine->EasyBlockPairsLength;
+
+    pthread_mutex_unlock(&engine->Lock);
+
+    return pairsLength > 0 ? (DOTNET_DOUBLE) pairsDone / pairsLength : 0;
+}
+
+DOTNET_PUBLIC void XenophyteCentralizedSearchEngine_Free(XENOPHYTE_SEARCH_ENGINE *engine) {
+    if (engine == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&engine->Lock);
+
+    engine->IsShutdown = DOTNET_TRUE;
+    __atomic_store_n(&engine->ActiveJobId, 0, __ATOMIC_RELEASE);
+
+    pthread_cond_broadcast(&engine->JobAvailable);
+    pthread_cond_broadcast(&engine->SolutionAvailable);
+
+    pthread_mutex_unlock(&engine->Lock);
+
+    for (DOTNET_INT i = 0; i < engine->WorkerCount; i++) {
+        XENOPHYTE_SEARCH_WORKER *worker = &engine->Workers[i];
+
+        if (worker->IsThreadStarted) {
+            pthread_join(worker->Thread, NULL);
+        }
+
+        XenophyteCentralizedAlgorithm_FreeShareContext(worker->ShareContext);
+        XenophyteCentralizedAlgorithm_FreeShareContext(worker->PendingShareContext);
+    }
+
+    pthread_cond_destroy(&engine->SolutionAvailable);
+    pthread_cond_destroy(&engine->JobAvailable);
+    pthread_mutex_destroy(&engine->Lock);
+
+    free(engine->Workers);
+    free(engine);
+}
@@ -0,0 +1,39 @@
+#ifndef XENOPHYTECENTRALIZEDSEARCHENGINE_H
+#define XENOPHYTECENTRALIZEDSEARCHENGINE_H
+
+#include "global.h"
+
+#define XENOPHYTE_SEARCH_JOB_TYPE_EASY 0
+#define XENOPHYTE_SEARCH_JOB_TYPE_SEMI_RANDOM 1
+#define XENOPHYTE_SEARCH_JOB_TYPE_RANDOM 2
+
+typedef struct XENOPHYTE_SEARCH_ENGINE XENOPHYTE_SEARCH_ENGINE;
+
+typedef struct XENOPHYTE_SEARCH_THREAD_OPTIONS {
+    DOTNET_ULONG ThreadAffinity; // Zero leaves the thread to the scheduler.
+    DOTNET_INT ThreadPriority; // Same values as System.Threading.ThreadPriority, only applied on Windows.
+    DOTNET_BOOL DoEasyBlock;
+    DOTNET_BOOL UseXenophyteRandomizer;
+} XENOPHYTE_SEARCH_THREAD_OPTIONS;
+
+typedef struct XENOPHYTE_SEARCH_SOLUTION {
+    DOTNET_LONG JobId;
+    DOTNET_LONG FirstNumber;
+    DOTNET_LONG SecondNumber;
+    DOTNET_LONG Solution;
+    DOTNET_INT Operator;
+    DOTNET_INT JobType;
+    DOTNET_INT ThreadIndex;
+} XENOPHYTE_SEARCH_SOLUTION;
+
+XENOPHYTE_SEARCH_ENGINE *XenophyteCentralizedSearchEngine_Create(const XENOPHYTE_SEARCH_THREAD_OPTIONS *threadOptions, DOTNET_INT threadCount);
+DOTNET_LONG XenophyteCentralizedSearchEngine_StartJob(XENOPHYTE_SEARCH_ENGINE *engine, DOTNET_LONG blockMinRange, DOTNET_LONG blockMaxRange, DOTNET_LONG timestamp, DOTNET_READ_ONLY_SPAN_BYTE xorKey, DOTNET_INT xorKeyLength, DOTNET_INT aesKeySize, DOTNET_READ_ONLY_SPAN_BYTE aesKey, DOTNET_READ_ONLY_SPAN_BYTE aesIv, DOTNET_INT aesRound, DOTNET_READ_ONLY_SPAN_BYTE blockIndication, DOTNET_INT blockIndicationLength);
+void XenophyteCentralizedSearchEngine_CancelJob(XENOPHYTE_SEARCH_ENGINE *engine);
+DOTNET_BOOL XenophyteCentralizedSearchEngine_PollSolution(XENOPHYTE_SEARCH_ENGINE *engine, XENOPHYTE_SEARCH_SOLUTION *solution, DOTNET_SPAN_BYTE encryptedShare, DOTNET_INT timeoutMilliseconds);
+DOTNET_LONG XenophyteCentralizedSearchEngine_TakeHashCount(XENOPHYTE_SEARCH_ENGINE *engine, DOTNET_INT threadIndex);
+
+// Share of the easy block pairs of the latest job that went through the share pipeline, from 0 to 1.
+DOTNET_DOUBLE XenophyteCentralizedSearchEngine_GetEasyBlockProgress(XENOPHYTE_SEARCH_ENGINE *engine);
+void XenophyteCentralizedSearchEngine_Free(XENOPHYTE_SEARCH_ENGINE *engine);
+
+#endif
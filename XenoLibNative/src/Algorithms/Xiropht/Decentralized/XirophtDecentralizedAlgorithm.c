@@ -1,278 +1,528 @@
-#include <stdlib.h>
-#include <string.h>
+#include "XirophtDecentralizedAlgorithm.h"
+#include "Utilities/AesMultiBufferUtility.h"
+#include "Utilities/CompressionUtility.h"
+#include "Utilities/CryptographyUtility.h"
+#include "Utilities/KeyDerivationFunctionUtility.h"
+#include "Utilities/MessageDigestUtility.h"
+#include "Utilities/SymmetricAlgorithmUtility.h"
 
-#include "lz4.h"
-#include "openssl/evp.h"
+#define XIROPHT_POC_RANDOM_DATA_HEADER_LENGTH (sizeof(RandomDataShareNumberType) * 2 + sizeof(RandomDataShareTimestampType))
+#define XIROPHT_POC_RANDOM_DATA_FOOTER_LENGTH (sizeof(RandomDataShareBlockHeightType) + sizeof(RandomDataShareNonceType))
 
-#include "XirophtDecentralizedAlgorithm.h"
+// Shorter inputs are written by lz4 as a single literal run without looking for a match, which never comes out smaller than the input.
+#define XIROPHT_LZ4_MIN_INPUT_LENGTH 13
+
+// Nonces that go through the SHA3-512 rounds and the PBKDF2 iterations together, the widest PBKDF2 kernel has this many lanes.
+#define XIROPHT_POC_LANES PBKDF2_SHA1_MAX_LANES
+
+struct XIROPHT_POC_WORKSPACE {
+    XIROPHT_POC_JOB Job;
+
+    // Holds the copied difficulty, previous block hash key and mark key the job spans point to.
+    DOTNET_SPAN_BYTE JobData;
+
+    // Every buffer below has one slot per lane.
+    DOTNET_SPAN_BYTE PocRandomData;
+    DOTNET_INT PocRandomDataLength;
+
+    // Sized for the random data, a SHA3-512 digest and the lz4 frame, whichever is larger.
+    DOTNET_SPAN_BYTE PocShareIv;
+    DOTNET_INT PocShareIvCapacity;
+
+    DOTNET_SPAN_BYTE PocShareWorkToDoBytes;
+    DOTNET_INT PocShareWorkToDoCapacity;
+
+    // The share key is expanded once per job, the EVP context is only set up when there are no AES instructions.
+    AES_MULTI_BUFFER_KEY EncryptKey;
+    DOTNET_BOOL HasEncryptKernel;
+    EVP_CIPHER_CTX *EncryptContext;
+};
+
+// Every 8 bytes of the hashed work are the four corners of a quadrilateral, the nonce comes from the first one that is a square.
+DOTNET_PRIVATE DOTNET_BOOL FindSquareNonce(DOTNET_READ_ONLY_SPAN_BYTE pocShareWorkToDoBytes, DOTNET_LONG *nonce) {
+    for (DOTNET_INT i = 0; i < 64; i += 8) {
+        DOTNET_READ_ONLY_SPAN_BYTE work = pocShareWorkToDoBytes + i;
 
-void XirophtDecentralizedAlgorithm_Solo_GeneratePocRandomData(
-    uint8_t *pocRandomData,
-    const RandomDataShareNumberType randomNumber,
-    const RandomDataShareNumberType randomNumber2,
-    const RandomDataShareTimestampType timestamp,
-    const int32_t checksumSize,
-    const uint8_t *walletAddress,
-    const int32_t walletAddressSize,
-    const RandomDataShareBlockHeightType blockHeight,
-    const RandomDataShareNonceType nonce
-)
-{
-    // randomNumber
-    memcpy(pocRandomData, &randomNumber, sizeof randomNumber);
-
-    // randomNumber2
-    memcpy(pocRandomData + sizeof randomNumber, &randomNumber2, sizeof randomNumber2);
-
-    // timestamp
-    memcpy(pocRandomData + sizeof randomNumber + sizeof randomNumber2, &timestamp, sizeof timestamp);
-
-    // walletAddress
-    memcpy(pocRandomData + sizeof randomNumber + sizeof randomNumber2 + sizeof timestamp + checksumSize, walletAddress, walletAddressSize);
-
-    // blockHeight
-    memcpy(pocRandomData + sizeof randomNumber + sizeof randomNumber2 + sizeof timestamp + checksumSize + walletAddressSize, &blockHeight, sizeof blockHeight);
-
-    // nonce
-    memcpy(pocRandomData + sizeof randomNumber + sizeof randomNumber2 + sizeof timestamp + checksumSize + walletAddressSize + sizeof blockHeight, &nonce, sizeof nonce);
+        DOTNET_INT x1 = work[0] + (work[1] << 8);
+        DOTNET_INT y1 = work[1] + (work[0] << 8);
+
+        DOTNET_INT x2 = work[2] + (work[3] << 8);
+        DOTNET_INT y2 = work[3] + (work[2] << 8);
+
+        DOTNET_INT x3 = work[4] + (work[5] << 8);
+        DOTNET_INT y3 = work[5] + (work[4] << 8);
+
+        DOTNET_INT x4 = work[6] + (work[7] << 8);
+        DOTNET_INT y4 = work[7] + (work[6] << 8);
+
+        if ((abs(y2 - y1) == abs(x3 - x1) && abs(x2 - x1) == abs(y3 - y1) && abs(y2 - y4) == abs(x3 - x4) && abs(x2 - x4) == abs(y3 - y4)) ||
+            (abs(y2 - y1) == abs(x4 - x1) && abs(x2 - x1) == abs(y4 - y3) && abs(y2 - y3) == abs(x4 - x3) && abs(x2 - x3) == abs(y4 - y3)) ||
+            (abs(y3 - y1) == abs(x4 - x1) && abs(x3 - x1) == abs(y4 - y1) && abs(y3 - y2) == abs(x4 - x2) && abs(x3 - x2) == abs(y4 - y2))) {
+            *nonce = (DOTNET_LONG) ((work[0] + work[0]) & 0xFF) + ((DOTNET_LONG) ((work[2] + work[2]) & 0xFF) << 8) + ((DOTNET_LONG) ((work[4] + work[4]) & 0xFF) << 16) + ((DOTNET_LONG) ((work[6] + work[6]) & 0xFF) << 24);
+            return DOTNET_TRUE;
+        }
+    }
+
+    return DOTNET_FALSE;
 }
 
-void XirophtDecentralizedAlgorithm_Solo_UpdatePocRandomData(
-    uint8_t *pocRandomData,
-    const RandomDataShareTimestampType timestamp,
-    const int32_t checksumSize,
-    const int32_t walletAddressSize,
-    const RandomDataShareNonceType nonce
-)
-{
-    // timestamp
-    memcpy(pocRandomData + sizeof(RandomDataShareNumberType) + sizeof(RandomDataShareNumberType), &timestamp, sizeof timestamp);
-
-    // nonce
-    memcpy(pocRandomData + sizeof(RandomDataShareNumberType) + sizeof(RandomDataShareNumberType) + sizeof timestamp + checksumSize + walletAddressSize + sizeof(RandomDataShareBlockHeightType), &nonce, sizeof nonce);
+DOTNET_PRIVATE DOTNET_INT BuildPocShareWorkToDo(DOTNET_SPAN_BYTE pocShareWorkToDoBytes, DOTNET_READ_ONLY_SPAN_BYTE pocShareIv, DOTNET_INT pocShareIvSize, RandomDataShareBlockHeightType blockHeight, DOTNET_READ_ONLY_SPAN_BYTE blockDifficulty, DOTNET_INT blockDifficultyLength, DOTNET_READ_ONLY_SPAN_BYTE previousFinalBlockTransactionHashKey, DOTNET_INT previousFinalBlockTransactionHashKeyLength) {
+    DOTNET_INT length = pocShareIvSize;
+
+    memcpy(pocShareWorkToDoBytes, pocShareIv, pocShareIvSize);
+    memcpy(pocShareWorkToDoBytes + length, blockDifficulty, blockDifficultyLength);
+    length += blockDifficultyLength;
+    memcpy(pocShareWorkToDoBytes + length, &blockHeight, sizeof(blockHeight));
+    length += sizeof(blockHeight);
+    memcpy(pocShareWorkToDoBytes + length, previousFinalBlockTransactionHashKey, previousFinalBlockTransactionHashKeyLength);
+
+    return length + previousFinalBlockTransactionHashKeyLength;
 }
 
-void XirophtDecentralizedAlgorithm_Solo_DoNonceIvMiningInstruction(uint8_t *pocShareIv, int32_t *pocShareIvSize, const int32_t pocRoundShaNonce)
-{
-    for (int32_t i = pocRoundShaNonce - 1; i >= 0; --i)
-    {
-        Sha3Utility_TryComputeSha512Hash(pocShareIv, *pocShareIvSize, pocShareIv, (uint32_t*) pocShareIvSize);
+DOTNET_PRIVATE DOTNET_BOOL EncryptPocShare(EVP_CIPHER_CTX *context, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_INT iterations, DOTNET_SPAN_BYTE data, DOTNET_INT *dataLength) {
+    // Every iteration pads with PKCS7 first, cfb128 does not need it but the share length depends on it.
+    for (DOTNET_INT i = 0; i < iterations; i++) {
+        DOTNET_INT paddingSizeRequired = SymmetricAlgorithmUtility_GetPaddedLength(*dataLength);
+
+        memset(data + *dataLength, paddingSizeRequired, paddingSizeRequired);
+
+        DOTNET_INT encryptedLength = SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER_CTX(context, iv, data, *dataLength + paddingSizeRequired, data);
+
+        if (encryptedLength == 0) {
+            return DOTNET_FALSE;
+        }
+
+        *dataLength = encryptedLength;
     }
+
+    return DOTNET_TRUE;
 }
 
-void XirophtDecentralizedAlgorithm_Solo_DoNonceIvXorMiningInstruction(uint8_t *pocShareIv, const int32_t pocShareIvSize)
-{
-    const div_t divResult = div(pocShareIvSize, 2);
+DOTNET_PUBLIC void XirophtDecentralizedAlgorithm_Solo_GeneratePocRandomData(DOTNET_SPAN_BYTE pocRandomData, RandomDataShareNumberType randomNumber, RandomDataShareNumberType randomNumber2, RandomDataShareTimestampType timestamp, DOTNET_INT checksumSize, DOTNET_READ_ONLY_SPAN_BYTE walletAddress, DOTNET_INT walletAddressSize, RandomDataShareBlockHeightType blockHeight, RandomDataShareNonceType nonce) {
+    memcpy(pocRandomData, &randomNumber, sizeof(randomNumber));
+    memcpy(pocRandomData + sizeof(randomNumber), &randomNumber2, sizeof(randomNumber2));
+    memcpy(pocRandomData + sizeof(randomNumber) + sizeof(randomNumber2), &timestamp, sizeof(timestamp));
+
+    // The checksum bytes between the timestamp and the wallet address are left as they are.
+    DOTNET_SPAN_BYTE walletAddressData = pocRandomData + XIROPHT_POC_RANDOM_DATA_HEADER_LENGTH + checksumSize;
+
+    memcpy(walletAddressData, walletAddress, walletAddressSize);
+    memcpy(walletAddressData + walletAddressSize, &blockHeight, sizeof(blockHeight));
+    memcpy(walletAddressData + walletAddressSize + sizeof(blockHeight), &nonce, sizeof(nonce));
+}
+
+DOTNET_PUBLIC void XirophtDecentralizedAlgorithm_Solo_UpdatePocRandomData(DOTNET_SPAN_BYTE pocRandomData, RandomDataShareTimestampType timestamp, DOTNET_INT checksumSize, DOTNET_INT walletAddressSize, RandomDataShareNonceType nonce) {
+    memcpy(pocRandomData + sizeof(RandomDataShareNumberType) * 2, &timestamp, sizeof(timestamp));
+    memcpy(pocRandomData + XIROPHT_POC_RANDOM_DATA_HEADER_LENGTH + checksumSize + walletAddressSize + sizeof(RandomDataShareBlockHeightType), &nonce, sizeof(nonce));
+}
 
-    for (int32_t i = divResult.quot - 1; i >= 0; --i)
-    {
-        const uint8_t value = *(pocShareIv + i) ^ *(pocShareIv + pocShareIvSize - 1 - i);
+DOTNET_PUBLIC DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoNonceIvMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize, DOTNET_INT pocRoundShaNonce) {
+    for (DOTNET_INT i = 0; i < pocRoundShaNonce; i++) {
+        *pocShareIvSize = MessageDigestUtility_ComputeSha3_512Hash(pocShareIv, *pocShareIvSize, pocShareIv);
 
-        *(pocShareIv + i) = value;
-        *(pocShareIv + pocShareIvSize - 1 - i) = value;
+        if (*pocShareIvSize == 0) {
+            return DOTNET_FALSE;
+        }
     }
 
-    if (divResult.rem != 0)
-    {
-        *(pocShareIv + divResult.quot) = 0;
+    return DOTNET_TRUE;
+}
+
+DOTNET_PUBLIC void XirophtDecentralizedAlgorithm_Solo_DoNonceIvXorMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT pocShareIvSize) {
+    DOTNET_INT half = pocShareIvSize / 2;
+
+    for (DOTNET_INT i = half - 1; i >= 0; i--) {
+        DOTNET_BYTE value = pocShareIv[i] ^ pocShareIv[pocShareIvSize - 1 - i];
+
+        pocShareIv[i] = value;
+        pocShareIv[pocShareIvSize - 1 - i] = value;
+    }
+
+    if (pocShareIvSize % 2 != 0) {
+        pocShareIv[half] = 0;
     }
 }
 
-int32_t XirophtDecentralizedAlgorithm_Solo_DoNonceIvEasySquareMathMiningInstruction(
-    const int32_t pocShareNonceMaxSquareRetry,
-    const int32_t pocShareNonceNoSquareFoundShaRounds,
-    const int64_t pocShareNonceMin,
-    const int64_t pocShareNonceMax,
-    const RandomDataShareBlockHeightType blockHeight,
-    uint8_t *pocShareIv,
-    int32_t *pocShareIvSize,
-    uint8_t *pocShareWorkToDoBytes,
-    const uint8_t *blockDifficulty,
-    const int32_t blockDifficultyLength,
-    const uint8_t *previousFinalBlockTransactionHashKey,
-    const int32_t previousFinalBlockTransactionHashKeyLength
-)
-{
-    int32_t totalRetry = 0;
-    int32_t newNonceGenerated = 0;
-    int64_t newNonce = 0;
-
-    while (totalRetry < pocShareNonceMaxSquareRetry)
-    {
-        memcpy(pocShareWorkToDoBytes, pocShareIv, *pocShareIvSize);
-        memcpy(pocShareWorkToDoBytes + *pocShareIvSize, blockDifficulty, blockDifficultyLength);
-        memcpy(pocShareWorkToDoBytes + *pocShareIvSize + blockDifficultyLength, &blockHeight, sizeof blockHeight);
-        memcpy(pocShareWorkToDoBytes + *pocShareIvSize + blockDifficultyLength + sizeof blockHeight, previousFinalBlockTransactionHashKey, previousFinalBlockTransactionHashKeyLength);
-
-        Sha3Utility_TryComputeSha512Hash(pocShareWorkToDoBytes, *pocShareIvSize + blockDifficultyLength + sizeof blockHeight + previousFinalBlockTransactionHashKeyLength, pocShareWorkToDoBytes, NULL);
-
-        for (int32_t i = 0; i < 64; i += 8)
-        {
-            const int32_t x1 = *(pocShareWorkToDoBytes + i) + (*(pocShareWorkToDoBytes + i + 1) << 8);
-            const int32_t y1 = *(pocShareWorkToDoBytes + i + 1) + (*(pocShareWorkToDoBytes + i) << 8);
-
-            const int32_t x2 = *(pocShareWorkToDoBytes + i + 2) + (*(pocShareWorkToDoBytes + i + 3) << 8);
-            const int32_t y2 = *(pocShareWorkToDoBytes + i + 3) + (*(pocShareWorkToDoBytes + i + 2) << 8);
-
-            const int32_t x3 = *(pocShareWorkToDoBytes + i + 4) + (*(pocShareWorkToDoBytes + i + 5) << 8);
-            const int32_t y3 = *(pocShareWorkToDoBytes + i + 5) + (*(pocShareWorkToDoBytes + i + 4) << 8);
-
-            const int32_t x4 = *(pocShareWorkToDoBytes + i + 6) + (*(pocShareWorkToDoBytes + i + 7) << 8);
-            const int32_t y4 = *(pocShareWorkToDoBytes + i + 7) + (*(pocShareWorkToDoBytes + i + 6) << 8);
-
-            if (abs(y2 - y1) == abs(x3 - x1) && abs(x2 - x1) == abs(y3 - y1) && abs(y2 - y4) == abs(x3 - x4) && abs(x2 - x4) == abs(y3 - y4) ||
-                abs(y2 - y1) == abs(x4 - x1) && abs(x2 - x1) == abs(y4 - y3) && abs(y2 - y3) == abs(x4 - x3) && abs(x2 - x3) == abs(y4 - y3) ||
-                abs(y3 - y1) == abs(x4 - x1) && abs(x3 - x1) == abs(y4 - y1) && abs(y3 - y2) == abs(x4 - x2) && abs(x3 - x2) == abs(y4 - y2))
-            {
-                newNonce = (int64_t) (*(pocShareWorkToDoBytes + i) + *(pocShareWorkToDoBytes + i) & 0xFF) + ((int64_t) (*(pocShareWorkToDoBytes + i + 2) + *(pocShareWorkToDoBytes + i + 2) & 0xFF) << 8) + ((int64_t) (*(pocShareWorkToDoBytes + i + 4) + *(pocShareWorkToDoBytes + i + 4) & 0xFF) << 16) + ((int64_t) (*(pocShareWorkToDoBytes + i + 6) + *(pocShareWorkToDoBytes + i + 6) & 0xFF) << 24);
-                newNonceGenerated = 1;
-                break;
-            }
+DOTNET_PUBLIC DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoNonceIvEasySquareMathMiningInstruction(DOTNET_INT pocShareNonceMaxSquareRetry, DOTNET_INT pocShareNonceNoSquareFoundShaRounds, DOTNET_LONG pocShareNonceMin, DOTNET_LONG pocShareNonceMax, RandomDataShareBlockHeightType blockHeight, DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize, DOTNET_SPAN_BYTE pocShareWorkToDoBytes, DOTNET_READ_ONLY_SPAN_BYTE blockDifficulty, DOTNET_INT blockDifficultyLength, DOTNET_READ_ONLY_SPAN_BYTE previousFinalBlockTransactionHashKey, DOTNET_INT previousFinalBlockTransactionHashKeyLength) {
+    DOTNET_BOOL isNonceGenerated = DOTNET_FALSE;
+    DOTNET_LONG newNonce = 0;
+
+    for (DOTNET_INT retry = 0; retry < pocShareNonceMaxSquareRetry; retry++) {
+        DOTNET_INT workToDoLength = BuildPocShareWorkToDo(pocShareWorkToDoBytes, pocShareIv, *pocShareIvSize, blockHeight, blockDifficulty, blockDifficultyLength, previousFinalBlockTransactionHashKey, previousFinalBlockTransactionHashKeyLength);
+
+        if (!MessageDigestUtility_ComputeSha3_512Hash(pocShareWorkToDoBytes, workToDoLength, pocShareWorkToDoBytes)) {
+            return DOTNET_FALSE;
         }
 
-        if (newNonceGenerated)
-        {
+        isNonceGenerated = FindSquareNonce(pocShareWorkToDoBytes, &newNonce);
+
+        if (isNonceGenerated) {
             break;
         }
 
-        Sha3Utility_TryComputeSha512Hash(pocShareIv, *pocShareIvSize, pocShareIv, (uint32_t*) pocShareIvSize);
-        totalRetry++;
+        *pocShareIvSize = MessageDigestUtility_ComputeSha3_512Hash(pocShareIv, *pocShareIvSize, pocShareIv);
+
+        if (*pocShareIvSize == 0) {
+            return DOTNET_FALSE;
+        }
     }
 
-    if (newNonceGenerated == 0)
-    {
-        for (int32_t i = pocShareNonceNoSquareFoundShaRounds - 1; i >= 0; --i)
-        {
-            Sha3Utility_TryComputeSha512Hash(pocShareIv, *pocShareIvSize, pocShareIv, (uint32_t*) pocShareIvSize);
+    if (!isNonceGenerated) {
+        if (!XirophtDecentralizedAlgorithm_Solo_DoNonceIvMiningInstruction(pocShareIv, pocShareIvSize, pocShareNonceNoSquareFoundShaRounds)) {
+            return DOTNET_FALSE;
         }
 
-        memcpy(&newNonce, pocShareIv, sizeof(uint32_t));
+        memcpy(&newNonce, pocShareIv, sizeof(DOTNET_UINT));
     }
 
-    if (newNonce < pocShareNonceMin || newNonce > pocShareNonceMax)
-    {
-        return 0;
+    if (newNonce < pocShareNonceMin || newNonce > pocShareNonceMax) {
+        return DOTNET_FALSE;
     }
 
-    memcpy(pocShareIv, &newNonce, sizeof(int64_t));
-    *pocShareIvSize = sizeof(int64_t);
+    memcpy(pocShareIv, &newNonce, sizeof(newNonce));
+    *pocShareIvSize = sizeof(newNonce);
 
-    return 1;
+    return DOTNET_TRUE;
 }
 
-void XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(uint8_t *pocShareIv, int32_t *pocShareIvSize)
-{
-    const int32_t compressMaxSize = LZ4_COMPRESSBOUND(*pocShareIvSize);
-    uint8_t *output = pocShareIv + *pocShareIvSize;
-    const int32_t actualCompressSize = LZ4_compress_default((const char*) pocShareIv, (char*) output, *pocShareIvSize, compressMaxSize);
+DOTNET_PUBLIC void XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize) {
+    // The frame is an 8 byte header with the original and the compressed size, then the data, the compressed data is stored when it is smaller.
+    DOTNET_INT size = *pocShareIvSize;
+    DOTNET_INT compressedSize = 0;
 
-    if (actualCompressSize >= *pocShareIvSize || actualCompressSize <= 0)
-    {
-        memcpy(output, pocShareIvSize, sizeof(int32_t));
-        memcpy(output + 4, pocShareIvSize, sizeof(int32_t));
-        memcpy(output + 8, pocShareIv, *pocShareIvSize);
+    // The 8 byte nonce of every share skips lz4, longer ivs are compressed after the space of a header and lz4 gives up once it cannot get smaller.
+    if (size >= XIROPHT_LZ4_MIN_INPUT_LENGTH) {
+        compressedSize = CompressionUtility_Compress_LZ4(pocShareIv, size, pocShareIv + size + 8, size - 1);
+    }
 
-        *pocShareIvSize = *pocShareIvSize + 8;
+    if (compressedSize <= 0 || compressedSize >= size) {
+        memmove(pocShareIv + 8, pocShareIv, size);
+        compressedSize = size;
+    } else {
+        memmove(pocShareIv + 8, pocShareIv + size + 8, compressedSize);
+    }
 
-        memmove(pocShareIv, output, *pocShareIvSize);
-        return;
+    memcpy(pocShareIv, &size, sizeof(DOTNET_INT));
+    memcpy(pocShareIv + 4, &compressedSize, sizeof(DOTNET_INT));
+
+    *pocShareIvSize = compressedSize + 8;
+}
+
+DOTNET_PUBLIC DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoNonceIvIterationsMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize, DOTNET_READ_ONLY_SPAN_BYTE blockchainMarkKey, DOTNET_INT blockchainMarkKeySize, DOTNET_INT pocShareNonceIvIteration, DOTNET_INT keyLength) {
+    // OpenSSL copies the password before deriving, so the key can overwrite it.
+    if (!PKCS5_PBKDF2_HMAC_SHA1((const char *) pocShareIv, *pocShareIvSize, blockchainMarkKey, blockchainMarkKeySize, pocShareNonceIvIteration, keyLength, pocShareIv)) {
+        return DOTNET_FALSE;
     }
 
-    memmove(output + 8, output, actualCompressSize);
-    memcpy(output, pocShareIvSize, sizeof(int32_t));
-    memcpy(output + 4, &actualCompressSize, sizeof(int32_t));
+    *pocShareIvSize = keyLength;
 
-    *pocShareIvSize = actualCompressSize + 8;
-    memmove(pocShareIv, output, *pocShareIvSize);
+    return DOTNET_TRUE;
 }
 
-int32_t XirophtDecentralizedAlgorithm_Solo_DoNonceIvIterationsMiningInstruction(
-    uint8_t *pocShareIv,
-    int32_t *pocShareIvSize,
-    const uint8_t *blockchainMarkKey,
-    const int32_t blockchainMarkKeySize,
-    const int32_t pocShareNonceIvIteration,
-    const int32_t keyLength
-)
-{
-    const int32_t passwordLength = *pocShareIvSize;
+DOTNET_PUBLIC DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoEncryptedPocShareMiningInstruction(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_INT iterations, DOTNET_SPAN_BYTE data, DOTNET_INT *dataLength) {
+    // The share is encrypted into the space right after the data, the kernel reads the data itself for the first iteration.
+    if (AesMultiBufferUtility_GetLaneCount() > 0) {
+        AES_MULTI_BUFFER_KEY expandedKey;
+        DOTNET_SPAN_BYTE pocShare = data + *dataLength;
+
+        if (AesMultiBufferUtility_ExpandKey(&expandedKey, 256, key) && AesMultiBufferUtility_Encrypt_CFB128_Iterations(&expandedKey, &iv, iterations, (const DOTNET_BYTE *const *) &data, &pocShare, dataLength, 1)) {
+            return DOTNET_TRUE;
+        }
+    }
+
+    const EVP_CIPHER *cipher = CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_256_CFB128);
+
+    if (cipher == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    EVP_CIPHER_CTX *context = CryptographyUtility_RentCipherContext();
+
+    if (context == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    // The share is encrypted from a copy placed right after the data.
+    memcpy(data + *dataLength, data, *dataLength);
+
+    DOTNET_BOOL isEncrypted = EVP_EncryptInit_ex(context, cipher, NULL, key, NULL) && EncryptPocShare(context, iv, iterations, data + *dataLength, dataLength);
+
+    CryptographyUtility_ReturnCipherContext(context);
+
+    return isEncrypted;
+}
+
+DOTNET_PUBLIC XIROPHT_POC_WORKSPACE *XirophtDecentralizedAlgorithm_Solo_CreatePocWorkspace(const XIROPHT_POC_JOB *job) {
+    if (job == NULL || job->ChecksumSize < 0 || job->WalletAddressLength < 0 || job->BlockDifficultyLength < 0 || job->PreviousFinalBlockTransactionHashKeyLength < 0 || job->BlockchainMarkKeyLength < 0) {
+        return NULL;
+    }
+
+    if ((job->WalletAddress == NULL && job->WalletAddressLength > 0) || (job->BlockDifficulty == NULL && job->BlockDifficultyLength > 0) || (job->PreviousFinalBlockTransactionHashKey == NULL && job->PreviousFinalBlockTransactionHashKeyLength > 0) || (job->BlockchainMarkKey == NULL && job->BlockchainMarkKeyLength > 0)) {
+        return NULL;
+    }
+
+    if (job->PocRoundShaNonce < 0 || job->PocShareNonceMaxSquareRetry < 0 || job->PocShareNonceNoSquareFoundShaRounds < 0 || job->PocShareNonceIvIteration <= 0 || job->PocShareKey == NULL || job->PocShareIterations < 0) {
+        return NULL;
+    }
+
+    const EVP_CIPHER *cipher = CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_256_CFB128);
+
+    if (cipher == NULL) {
+        return NULL;
+    }
+
+    XIROPHT_POC_WORKSPACE *workspace = calloc(1, sizeof(XIROPHT_POC_WORKSPACE));
+
+    if (workspace == NULL) {
+        return NULL;
+    }
+
+    workspace->Job = *job;
+    workspace->PocRandomDataLength = (DOTNET_INT) (XIROPHT_POC_RANDOM_DATA_HEADER_LENGTH + job->ChecksumSize + job->WalletAddressLength + XIROPHT_POC_RANDOM_DATA_FOOTER_LENGTH);
+    workspace->PocShareIvCapacity = workspace->PocRandomDataLength > SHA512_DIGEST_SIZE ? workspace->PocRandomDataLength : SHA512_DIGEST_SIZE;
+    workspace->PocShareWorkToDoCapacity = (DOTNET_INT) (workspace->PocShareIvCapacity + job->BlockDifficultyLength + sizeof(RandomDataShareBlockHeightType) + job->PreviousFinalBlockTransactionHashKeyLength);
 
-    if (PKCS5_PBKDF2_HMAC_SHA1((const char*) pocShareIv, passwordLength, blockchainMarkKey, blockchainMarkKeySize, pocShareNonceIvIteration, keyLength, pocShareIv) == 1)
-    {
-        *pocShareIvSize = keyLength;
-        return 1;
+    workspace->JobData = malloc(job->BlockDifficultyLength + job->PreviousFinalBlockTransactionHashKeyLength + job->BlockchainMarkKeyLength + 1);
+    workspace->PocRandomData = calloc(XIROPHT_POC_LANES, workspace->PocRandomDataLength);
+    workspace->PocShareIv = malloc(XIROPHT_POC_LANES * workspace->PocShareIvCapacity);
+    workspace->PocShareWorkToDoBytes = malloc(XIROPHT_POC_LANES * workspace->PocShareWorkToDoCapacity);
+    workspace->HasEncryptKernel = AesMultiBufferUtility_GetLaneCount() > 0 && AesMultiBufferUtility_ExpandKey(&workspace->EncryptKey, 256, job->PocShareKey);
+
+    if (!workspace->HasEncryptKernel) {
+        workspace->EncryptContext = SymmetricAlgorithmUtility_CreateEncryptContext_EVP_CIPHER(cipher, job->PocShareKey);
+    }
+
+    if (workspace->JobData == NULL || workspace->PocRandomData == NULL || workspace->PocShareIv == NULL || workspace->PocShareWorkToDoBytes == NULL || (!workspace->HasEncryptKernel && workspace->EncryptContext == NULL)) {
+        XirophtDecentralizedAlgorithm_Solo_FreePocWorkspace(workspace);
+        return NULL;
+    }
+
+    DOTNET_SPAN_BYTE jobData = workspace->JobData;
+
+    memcpy(jobData, job->BlockDifficulty, job->BlockDifficultyLength);
+    workspace->Job.BlockDifficulty = jobData;
+    jobData += job->BlockDifficultyLength;
+
+    memcpy(jobData, job->PreviousFinalBlockTransactionHashKey, job->PreviousFinalBlockTransactionHashKeyLength);
+    workspace->Job.PreviousFinalBlockTransactionHashKey = jobData;
+    jobData += job->PreviousFinalBlockTransactionHashKeyLength;
+
+    memcpy(jobData, job->BlockchainMarkKey, job->BlockchainMarkKeyLength);
+    workspace->Job.BlockchainMarkKey = jobData;
+
+    // Only the timestamp and the nonce change afterwards, the wallet address is not needed past this point.
+    for (DOTNET_INT lane = 0; lane < XIROPHT_POC_LANES; lane++) {
+        XirophtDecentralizedAlgorithm_Solo_GeneratePocRandomData(workspace->PocRandomData + lane * workspace->PocRandomDataLength, job->RandomNumber, job->RandomNumber2, 0, job->ChecksumSize, job->WalletAddress, job->WalletAddressLength, job->BlockHeight, 0);
     }
 
-    return 0;
+    workspace->Job.WalletAddress = NULL;
+    workspace->Job.PocShareKey = NULL;
+
+    return workspace;
 }
 
-int32_t XirophtDecentralizedAlgorithm_Solo_DoEncryptedPocShareMiningInstruction(
-    const uint8_t *key,
-    const uint8_t *iv,
-    const int32_t iterations,
-    uint8_t *data,
-    int32_t *dataLength
-)
-{
-    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
-
-    if (ctx == NULL)
-    {
+DOTNET_PUBLIC DOTNET_INT XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(const XIROPHT_POC_WORKSPACE *workspace) {
+    if (workspace == NULL) {
         return 0;
     }
 
-    memcpy(data + *dataLength, data, *dataLength);
-    uint8_t *newData = data + *dataLength;
-
-    for (int32_t i = iterations - 1; i >= 0; --i)
-    {
-        if (EVP_CIPHER_CTX_set_padding(ctx, 0) == 0)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return 0;
+    DOTNET_INT length = workspace->PocRandomDataLength;
+
+    for (DOTNET_INT i = 0; i < workspace->Job.PocShareIterations; i++) {
+        length += SymmetricAlgorithmUtility_GetPaddedLength(length);
+    }
+
+    return length;
+}
+
+// Hashes the iv of every listed lane in place, the lanes always share the same iv length.
+DOTNET_PRIVATE DOTNET_BOOL HashPocShareIvLanes(XIROPHT_POC_WORKSPACE *workspace, const DOTNET_INT *lanes, DOTNET_INT count, DOTNET_INT *pocShareIvSize, DOTNET_INT rounds) {
+    DOTNET_BYTE *pocShareIvs[XIROPHT_POC_LANES];
+    DOTNET_INT pocShareIvSizes[XIROPHT_POC_LANES];
+
+    if (count == 0 || rounds == 0) {
+        return DOTNET_TRUE;
+    }
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        pocShareIvs[i] = workspace->PocShareIv + lanes[i] * workspace->PocShareIvCapacity;
+        pocShareIvSizes[i] = *pocShareIvSize;
+    }
+
+    *pocShareIvSize = SHA512_DIGEST_SIZE;
+
+    return MessageDigestUtility_ComputeSha3_512HashBatch((const DOTNET_BYTE *const *) pocShareIvs, pocShareIvSizes, pocShareIvs, count, rounds);
+}
+
+DOTNET_PRIVATE DOTNET_BOOL ComputePocShareLanes(XIROPHT_POC_WORKSPACE *workspace, RandomDataShareTimestampType timestamp, const RandomDataShareNonceType *nonces, DOTNET_INT count, DOTNET_SPAN_LONG pocShareNonces, DOTNET_SPAN_BYTE pocShares, DOTNET_SPAN_INT pocShareLengths) {
+    const XIROPHT_POC_JOB *job = &workspace->Job;
+    DOTNET_INT pocShareIvSize = workspace->PocRandomDataLength;
+    DOTNET_INT pocShareLength = XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(workspace);
+
+    DOTNET_INT lanes[XIROPHT_POC_LANES];
+    DOTNET_INT lanesLength = count;
+    DOTNET_LONG newNonces[XIROPHT_POC_LANES];
+
+    for (DOTNET_INT lane = 0; lane < count; lane++) {
+        DOTNET_SPAN_BYTE pocRandomData = workspace->PocRandomData + lane * workspace->PocRandomDataLength;
+
+        XirophtDecentralizedAlgorithm_Solo_UpdatePocRandomData(pocRandomData, timestamp, job->ChecksumSize, job->WalletAddressLength, nonces[lane]);
+        memcpy(workspace->PocShareIv + lane * workspace->PocShareIvCapacity, pocRandomData, pocShareIvSize);
+
+        lanes[lane] = lane;
+    }
+
+    if (!HashPocShareIvLanes(workspace, lanes, lanesLength, &pocShareIvSize, job->PocRoundShaNonce)) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT lane = 0; lane < count; lane++) {
+        XirophtDecentralizedAlgorithm_Solo_DoNonceIvXorMiningInstruction(workspace->PocShareIv + lane * workspace->PocShareIvCapacity, pocShareIvSize);
+    }
+
+    // Lanes drop out once their work shows a square, the others keep hashing their iv together for the next retry.
+    for (DOTNET_INT retry = 0; retry < job->PocShareNonceMaxSquareRetry && lanesLength > 0; retry++) {
+        DOTNET_BYTE *works[XIROPHT_POC_LANES];
+        DOTNET_INT workLengths[XIROPHT_POC_LANES];
+
+        for (DOTNET_INT i = 0; i < lanesLength; i++) {
+            works[i] = workspace->PocShareWorkToDoBytes + lanes[i] * workspace->PocShareWorkToDoCapacity;
+            workLengths[i] = BuildPocShareWorkToDo(works[i], workspace->PocShareIv + lanes[i] * workspace->PocShareIvCapacity, pocShareIvSize, job->BlockHeight, job->BlockDifficulty, job->BlockDifficultyLength, job->PreviousFinalBlockTransactionHashKey, job->PreviousFinalBlockTransactionHashKeyLength);
         }
 
-        if (EVP_EncryptInit_ex(ctx, EVP_aes_256_cfb128(), NULL, key, iv) == 0)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return 0;
+        if (!MessageDigestUtility_ComputeSha3_512HashBatch((const DOTNET_BYTE *const *) works, workLengths, works, lanesLength, 1)) {
+            return DOTNET_FALSE;
+        }
+
+        DOTNET_INT remaining = 0;
+
+        for (DOTNET_INT i = 0; i < lanesLength; i++) {
+            if (!FindSquareNonce(works[i], &newNonces[lanes[i]])) {
+                lanes[remaining++] = lanes[i];
+            }
         }
 
-        const uint8_t paddingSizeRequired = 16 - *dataLength % 16;
+        lanesLength = remaining;
 
-        for (int j = paddingSizeRequired - 1; j >= 0; --j)
-        {
-            *(newData + *dataLength + j) = paddingSizeRequired;
+        if (!HashPocShareIvLanes(workspace, lanes, lanesLength, &pocShareIvSize, 1)) {
+            return DOTNET_FALSE;
         }
+    }
+
+    if (!HashPocShareIvLanes(workspace, lanes, lanesLength, &pocShareIvSize, job->PocShareNonceNoSquareFoundShaRounds)) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT i = 0; i < lanesLength; i++) {
+        DOTNET_UINT nonce;
+
+        memcpy(&nonce, workspace->PocShareIv + lanes[i] * workspace->PocShareIvCapacity, sizeof(nonce));
+        newNonces[lanes[i]] = nonce;
+    }
+
+    DOTNET_BYTE *pocShareIvs[XIROPHT_POC_LANES];
+    DOTNET_INT pocShareIvSizes[XIROPHT_POC_LANES];
+
+    lanesLength = 0;
 
-        *dataLength = *dataLength + paddingSizeRequired;
+    for (DOTNET_INT lane = 0; lane < count; lane++) {
+        DOTNET_SPAN_BYTE pocShareIv = workspace->PocShareIv + lane * workspace->PocShareIvCapacity;
+        DOTNET_INT laneIvSize = sizeof(DOTNET_LONG);
 
-        int32_t updateLength = 0;
+        pocShareLengths[lane] = 0;
 
-        if (EVP_EncryptUpdate(ctx, newData, &updateLength, newData, *dataLength) == 0)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return 0;
+        if (newNonces[lane] < job->PocShareNonceMin || newNonces[lane] > job->PocShareNonceMax) {
+            continue;
         }
 
-        int32_t finalLength = 0;
+        pocShareNonces[lane] = newNonces[lane];
+        memcpy(pocShareIv, &newNonces[lane], sizeof(DOTNET_LONG));
+
+        XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(pocShareIv, &laneIvSize);
+
+        pocShareIvs[lanesLength] = pocShareIv;
+        pocShareIvSizes[lanesLength] = laneIvSize;
+        lanes[lanesLength++] = lane;
+    }
+
+    // The mark key salt and the iterations are the same for every nonce, the lanes only differ by their compressed nonce.
+    if (!KeyDerivationFunctionUtility_ComputePbkdf2Sha1Batch((const DOTNET_BYTE *const *) pocShareIvs, pocShareIvSizes, job->BlockchainMarkKey, job->BlockchainMarkKeyLength, job->PocShareNonceIvIteration, pocShareIvs, XIROPHT_POC_SHARE_IV_LENGTH, lanesLength)) {
+        return DOTNET_FALSE;
+    }
+
+    if (lanesLength == 0) {
+        return DOTNET_TRUE;
+    }
 
-        if (EVP_EncryptFinal_ex(ctx, newData + updateLength, &finalLength) == 0)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return 0;
+    const DOTNET_BYTE *pocRandomDatas[XIROPHT_POC_LANES];
+    DOTNET_BYTE *encryptedPocShares[XIROPHT_POC_LANES];
+    DOTNET_INT encryptedPocShareLengths[XIROPHT_POC_LANES];
+
+    for (DOTNET_INT i = 0; i < lanesLength; i++) {
+        pocRandomDatas[i] = workspace->PocRandomData + lanes[i] * workspace->PocRandomDataLength;
+        encryptedPocShares[i] = pocShares + lanes[i] * pocShareLength;
+        encryptedPocShareLengths[i] = workspace->PocRandomDataLength;
+    }
+
+    // The first iteration reads the random data directly, the shares are encrypted side by side from their own nonce iv.
+    if (workspace->HasEncryptKernel) {
+        if (!AesMultiBufferUtility_Encrypt_CFB128_Iterations(&workspace->EncryptKey, (const DOTNET_BYTE *const *) pocShareIvs, job->PocShareIterations, pocRandomDatas, encryptedPocShares, encryptedPocShareLengths, lanesLength)) {
+            return DOTNET_FALSE;
         }
+    } else {
+        for (DOTNET_INT i = 0; i < lanesLength; i++) {
+            memcpy(encryptedPocShares[i], pocRandomDatas[i], encryptedPocShareLengths[i]);
 
-        *dataLength = updateLength + finalLength;
+            if (!EncryptPocShare(workspace->EncryptContext, pocShareIvs[i], job->PocShareIterations, encryptedPocShares[i], &encryptedPocShareLengths[i])) {
+                return DOTNET_FALSE;
+            }
+        }
+    }
+
+    for (DOTNET_INT i = 0; i < lanesLength; i++) {
+        pocShareLengths[lanes[i]] = encryptedPocShareLengths[i];
+    }
+
+    return DOTNET_TRUE;
+}
 
-        if (EVP_CIPHER_CTX_reset(ctx) == 0)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return 0;
+DOTNET_PUBLIC DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_ComputePocShares(XIROPHT_POC_WORKSPACE *workspace, RandomDataShareTimestampType timestamp, const RandomDataShareNonceType *nonces, DOTNET_INT count, DOTNET_SPAN_LONG pocShareNonces, DOTNET_SPAN_BYTE pocShares, DOTNET_SPAN_INT pocShareLengths) {
+    if (workspace == NULL || nonces == NULL || count < 0 || pocShareNonces == NULL || pocShares == NULL || pocShareLengths == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_INT pocShareLength = XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(workspace);
+
+    for (DOTNET_INT i = 0; i < count; i += XIROPHT_POC_LANES) {
+        DOTNET_INT lanes = count - i < XIROPHT_POC_LANES ? count - i : XIROPHT_POC_LANES;
+
+        if (!ComputePocShareLanes(workspace, timestamp, nonces + i, lanes, pocShareNonces + i, pocShares + i * pocShareLength, pocShareLengths + i)) {
+            return DOTNET_FALSE;
         }
     }
 
-    EVP_CIPHER_CTX_free(ctx);
+    return DOTNET_TRUE;
+}
+
+DOTNET_PUBLIC DOTNET_INT XirophtDecentralizedAlgorithm_Solo_ComputePocShare(XIROPHT_POC_WORKSPACE *workspace, RandomDataShareTimestampType timestamp, RandomDataShareNonceType nonce, DOTNET_LONG *pocShareNonce, DOTNET_SPAN_BYTE pocShare) {
+    DOTNET_INT pocShareLength;
+
+    if (!XirophtDecentralizedAlgorithm_Solo_ComputePocShares(workspace, timestamp, &nonce, 1, pocShareNonce, pocShare, &pocShareLength)) {
+        return 0;
+    }
+
+    return pocShareLength;
+}
+
+DOTNET_PUBLIC void XirophtDecentralizedAlgorithm_Solo_FreePocWorkspace(XIROPHT_POC_WORKSPACE *workspace) {
+    if (workspace == NULL) {
+        return;
+    }
 
-    return 1;
+    EVP_CIPHER_CTX_free(workspace->EncryptContext);
+    free(workspace->JobData);
+    free(workspace->PocRandomData);
+    free(workspace->PocShareIv);
+    free(workspace->PocShareWorkToDoBytes);
+    free(workspace);
 }
@@ -1,70 +1,66 @@
-#pragma once
+#ifndef XIROPHTDECENTRALIZEDALGORITHM_H
+#define XIROPHTDECENTRALIZEDALGORITHM_H
 
 #include "global.h"
 
+// The derived nonce iv is the aes iv of the encrypted share, so the PBKDF2 step always asks for one aes block.
+#define XIROPHT_POC_SHARE_IV_LENGTH 16
+
 typedef int32_t RandomDataShareNumberType;
 typedef int64_t RandomDataShareTimestampType;
 typedef int64_t RandomDataShareBlockHeightType;
 typedef int64_t RandomDataShareNonceType;
 
-XENO_NATIVE_EXPORT void XirophtDecentralizedAlgorithm_Solo_GeneratePocRandomData(
-    uint8_t *pocRandomData,
-    RandomDataShareNumberType randomNumber,
-    RandomDataShareNumberType randomNumber2,
-    RandomDataShareTimestampType timestamp,
-    int32_t checksumSize,
-    const uint8_t *walletAddress,
-    int32_t walletAddressSize,
-    RandomDataShareBlockHeightType blockHeight,
-    RandomDataShareNonceType nonce
-);
+// Everything a block template fixes for every nonce, the spans are copied by CreatePocWorkspace.
+typedef struct XIROPHT_POC_JOB {
+    RandomDataShareNumberType RandomNumber;
+    RandomDataShareNumberType RandomNumber2;
+    DOTNET_INT ChecksumSize;
+    DOTNET_READ_ONLY_SPAN_BYTE WalletAddress;
+    DOTNET_INT WalletAddressLength;
+    RandomDataShareBlockHeightType BlockHeight;
+
+    DOTNET_INT PocRoundShaNonce;
+    DOTNET_INT PocShareNonceMaxSquareRetry;
+    DOTNET_INT PocShareNonceNoSquareFoundShaRounds;
+    DOTNET_LONG PocShareNonceMin;
+    DOTNET_LONG PocShareNonceMax;
+    DOTNET_READ_ONLY_SPAN_BYTE BlockDifficulty;
+    DOTNET_INT BlockDifficultyLength;
+    DOTNET_READ_ONLY_SPAN_BYTE PreviousFinalBlockTransactionHashKey;
+    DOTNET_INT PreviousFinalBlockTransactionHashKeyLength;
+
+    DOTNET_READ_ONLY_SPAN_BYTE BlockchainMarkKey;
+    DOTNET_INT BlockchainMarkKeyLength;
+    DOTNET_INT PocShareNonceIvIteration;
+
+    DOTNET_READ_ONLY_SPAN_BYTE PocShareKey; // 32 bytes, aes-256-cfb128.
+    DOTNET_INT PocShareIterations;
+} XIROPHT_POC_JOB;
 
-XENO_NATIVE_EXPORT void XirophtDecentralizedAlgorithm_Solo_UpdatePocRandomData(
-    uint8_t *pocRandomData,
-    RandomDataShareTimestampType timestamp,
-    int32_t checksumSize,
-    int32_t walletAddressSize,
-    RandomDataShareNonceType nonce
-);
+typedef struct XIROPHT_POC_WORKSPACE XIROPHT_POC_WORKSPACE;
 
-XENO_NATIVE_EXPORT void XirophtDecentralizedAlgorithm_Solo_DoNonceIvMiningInstruction(
-    uint8_t *pocShareIv,
-    int32_t *pocShareIvSize,
-    int32_t pocRoundShaNonce
-);
+void XirophtDecentralizedAlgorithm_Solo_GeneratePocRandomData(DOTNET_SPAN_BYTE pocRandomData, RandomDataShareNumberType randomNumber, RandomDataShareNumberType randomNumber2, RandomDataShareTimestampType timestamp, DOTNET_INT checksumSize, DOTNET_READ_ONLY_SPAN_BYTE walletAddress, DOTNET_INT walletAddressSize, RandomDataShareBlockHeightType blockHeight, RandomDataShareNonceType nonce);
+void XirophtDecentralizedAlgorithm_Solo_UpdatePocRandomData(DOTNET_SPAN_BYTE pocRandomData, RandomDataShareTimestampType timestamp, DOTNET_INT checksumSize, DOTNET_INT walletAddressSize, RandomDataShareNonceType nonce);
 
-XENO_NATIVE_EXPORT void XirophtDecentralizedAlgorithm_Solo_DoNonceIvXorMiningInstruction(uint8_t *pocShareIv, int32_t pocShareIvSize);
+DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoNonceIvMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize, DOTNET_INT pocRoundShaNonce);
+void XirophtDecentralizedAlgorithm_Solo_DoNonceIvXorMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT pocShareIvSize);
+DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoNonceIvEasySquareMathMiningInstruction(DOTNET_INT pocShareNonceMaxSquareRetry, DOTNET_INT pocShareNonceNoSquareFoundShaRounds, DOTNET_LONG pocShareNonceMin, DOTNET_LONG pocShareNonceMax, RandomDataShareBlockHeightType blockHeight, DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize, DOTNET_SPAN_BYTE pocShareWorkToDoBytes, DOTNET_READ_ONLY_SPAN_BYTE blockDifficulty, DOTNET_INT blockDifficultyLength, DOTNET_READ_ONLY_SPAN_BYTE previousFinalBlockTransactionHashKey, DOTNET_INT previousFinalBlockTransactionHashKeyLength);
+void XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize);
+DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoNonceIvIterationsMiningInstruction(DOTNET_SPAN_BYTE pocShareIv, DOTNET_INT *pocShareIvSize, DOTNET_READ_ONLY_SPAN_BYTE blockchainMarkKey, DOTNET_INT blockchainMarkKeySize, DOTNET_INT pocShareNonceIvIteration, DOTNET_INT keyLength);
+DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_DoEncryptedPocShareMiningInstruction(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_INT iterations, DOTNET_SPAN_BYTE data, DOTNET_INT *dataLength);
 
-XENO_NATIVE_EXPORT int32_t XirophtDecentralizedAlgorithm_Solo_DoNonceIvEasySquareMathMiningInstruction(
-    int32_t pocShareNonceMaxSquareRetry,
-    int32_t pocShareNonceNoSquareFoundShaRounds,
-    int64_t pocShareNonceMin,
-    int64_t pocShareNonceMax,
-    RandomDataShareBlockHeightType blockHeight,
-    uint8_t *pocShareIv,
-    int32_t *pocShareIvSize,
-    uint8_t *pocShareWorkToDoBytes,
-    const uint8_t *blockDifficulty,
-    int32_t blockDifficultyLength,
-    const uint8_t *previousFinalBlockTransactionHashKey,
-    int32_t previousFinalBlockTransactionHashKeyLength
-);
+// Runs every instruction above for one nonce without a round trip between them, the buffers and the share cipher are set up once per job.
+XIROPHT_POC_WORKSPACE *XirophtDecentralizedAlgorithm_Solo_CreatePocWorkspace(const XIROPHT_POC_JOB *job);
+DOTNET_INT XirophtDecentralizedAlgorithm_Solo_GetPocShareLength(const XIROPHT_POC_WORKSPACE *workspace);
 
-XENO_NATIVE_EXPORT void XirophtDecentralizedAlgorithm_Solo_DoLz4CompressNonceIvMiningInstruction(uint8_t *pocShareIv, int32_t *pocShareIvSize);
+// Returns the length of the encrypted share, or 0 when the nonce derived by the square math is outside the job range.
+// The share is the PoC random data encrypted with the job key and the derived nonce iv, pocShare needs GetPocShareLength bytes.
+DOTNET_INT XirophtDecentralizedAlgorithm_Solo_ComputePocShare(XIROPHT_POC_WORKSPACE *workspace, RandomDataShareTimestampType timestamp, RandomDataShareNonceType nonce, DOTNET_LONG *pocShareNonce, DOTNET_SPAN_BYTE pocShare);
 
-XENO_NATIVE_EXPORT int32_t XirophtDecentralizedAlgorithm_Solo_DoNonceIvIterationsMiningInstruction(
-    uint8_t *pocShareIv, 
-    int32_t *pocShareIvSize, 
-    const uint8_t *blockchainMarkKey, 
-    int32_t blockchainMarkKeySize, 
-    int32_t pocShareNonceIvIteration, 
-    int32_t keyLength
-);
+// Same as ComputePocShare for many nonces, their SHA3-512 rounds run side by side in the Keccak lanes.
+// Share i starts at pocShares + i * GetPocShareLength, a nonce outside the job range gets a share length of 0.
+DOTNET_BOOL XirophtDecentralizedAlgorithm_Solo_ComputePocShares(XIROPHT_POC_WORKSPACE *workspace, RandomDataShareTimestampType timestamp, const RandomDataShareNonceType *nonces, DOTNET_INT count, DOTNET_SPAN_LONG pocShareNonces, DOTNET_SPAN_BYTE pocShares, DOTNET_SPAN_INT pocShareLengths);
+void XirophtDecentralizedAlgorithm_Solo_FreePocWorkspace(XIROPHT_POC_WORKSPACE *workspace);
 
-XENO_NATIVE_EXPORT int32_t XirophtDecentralizedAlgorithm_Solo_DoEncryptedPocShareMiningInstruction(
-    const uint8_t *key, 
-    const uint8_t *iv,
-    int32_t iterations,
-    uint8_t *data,
-    int32_t *dataLength
-);
+#endif
@@ -0,0 +1,661 @@
+#include "AesMultiBufferUtility.h"
+#include "CpuDispatchUtility.h"
+
+#ifdef XENO_NATIVE_X86
+#include <immintrin.h>
+#endif
+
+DOTNET_PRIVATE const DOTNET_BYTE SBox[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16};
+
+DOTNET_PRIVATE const DOTNET_BYTE RoundConstants[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+DOTNET_INT AesMultiBufferUtility_GetLaneCount() {
+#ifdef XENO_NATIVE_X86
+    if (!CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AES)) {
+        return 0;
+    }
+
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_VAES | CPU_DISPATCH_FEATURE_AVX512F)) {
+        return 16;
+    }
+
+    return 8;
+#else
+    return 0;
+#endif
+}
+
+DOTNET_STRING AesMultiBufferUtility_GetKernelName() {
+    switch (AesMultiBufferUtility_GetLaneCount()) {
+        case 16:
+            return "vaes-avx512";
+
+        case 8:
+            return "aesni";
+
+        default:
+            // Callers fall back to OpenSSL when there are no lanes.
+            return "openssl";
+    }
+}
+
+DOTNET_BOOL AesMultiBufferUtility_ExpandKey(AES_MULTI_BUFFER_KEY *key, DOTNET_INT keySize, DOTNET_READ_ONLY_SPAN_BYTE keyBytes) {
+    if (key == NULL || keyBytes == NULL || (keySize != 128 && keySize != 192 && keySize != 256)) {
+        return DOTNET_FALSE;
+    }
+
+    // Standard FIPS-197 expansion, the encryption round keys are used as is by aesenc.
+    DOTNET_INT keyWords = keySize / 32;
+    DOTNET_INT rounds = keyWords + 6;
+    DOTNET_INT totalWords = 4 * (rounds + 1);
+
+    DOTNET_SPAN_BYTE words = key->RoundKeys;
+    memcpy(words, keyBytes, keyWords * 4);
+
+    for (DOTNET_INT i = keyWords; i < totalWords; i++) {
+        DOTNET_BYTE temp[4];
+        memcpy(temp, words + (i - 1) * 4, 4);
+
+        if (i % keyWords == 0) {
+            DOTNET_BYTE first = temp[0];
+
+            temp[0] = SBox[temp[1]] ^ RoundConstants[i / keyWords - 1];
+            temp[1] = SBox[temp[2]];
+            temp[2] = SBox[temp[3]];
+            temp[3] = SBox[first];
+        } else if (keyWords > 6 && i % keyWords == 4) {
+            temp[0] = SBox[temp[0]];
+            temp[1] = SBox[temp[1]];
+            temp[2] = SBox[temp[2]];
+            temp[3] = SBox[temp[3]];
+        }
+
+        for (DOTNET_INT j = 0; j < 4; j++) {
+            words[i * 4 + j] = words[(i - keyWords) * 4 + j] ^ temp[j];
+        }
+    }
+
+    key->Rounds = rounds;
+
+    return DOTNET_TRUE;
+}
+
+#ifdef XENO_NATIVE_X86
+
+// One cfb128 iteration of a lane, the block after the full ones is the padded tail and anything past it goes to the spare block.
+typedef struct CFB128_LANE {
+    DOTNET_READ_ONLY_SPAN_BYTE Iv;
+    DOTNET_READ_ONLY_SPAN_BYTE Source;
+    DOTNET_SPAN_BYTE Destination;
+    DOTNET_INT FullBlocks;
+    DOTNET_BYTE Tail[16];
+    DOTNET_BYTE Spare[16];
+} CFB128_LANE;
+
+inline DOTNET_PRIVATE DOTNET_READ_ONLY_SPAN_BYTE GetCfb128Source(const CFB128_LANE *lane, DOTNET_INT block) {
+    if (block < lane->FullBlocks) {
+        return lane->Source + block * 16;
+    }
+
+    return block == lane->FullBlocks ? lane->Tail : lane->Spare;
+}
+
+inline DOTNET_PRIVATE DOTNET_SPAN_BYTE GetCfb128Destination(CFB128_LANE *lane, DOTNET_INT block) {
+    return block <= lane->FullBlocks ? lane->Destination + block * 16 : lane->Spare;
+}
+
+// Every lane carries its own chaining value, it holds the last ciphertext block once the call returns.
+XENO_NATIVE_TARGET("aes,sse2")
+DOTNET_PRIVATE void EncryptCbc8_AESNI(const __m128i *roundKeys, DOTNET_INT rounds, DOTNET_BYTE *const *chains, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_BYTE *const *destinations) {
+    DOTNET_INT blocks = sourceLength / 16;
+
+    __m128i state[8];
+
+    for (DOTNET_INT lane = 0; lane < 8; lane++) {
+        state[lane] = _mm_loadu_si128((const __m128i *) chains[lane]);
+    }
+
+    for (DOTNET_INT block = 0; block < blocks; block++) {
+        for (DOTNET_INT lane = 0; lane < 8; lane++) {
+            state[lane] = _mm_xor_si128(state[lane], _mm_xor_si128(_mm_loadu_si128((const __m128i *) (sources[lane] + block * 16)), roundKeys[0]));
+        }
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            __m128i roundKey = roundKeys[round];
+
+            state[0] = _mm_aesenc_si128(state[0], roundKey);
+            state[1] = _mm_aesenc_si128(state[1], roundKey);
+            state[2] = _mm_aesenc_si128(state[2], roundKey);
+            state[3] = _mm_aesenc_si128(state[3], roundKey);
+            state[4] = _mm_aesenc_si128(state[4], roundKey);
+            state[5] = _mm_aesenc_si128(state[5], roundKey);
+            state[6] = _mm_aesenc_si128(state[6], roundKey);
+            state[7] = _mm_aesenc_si128(state[7], roundKey);
+        }
+
+        for (DOTNET_INT lane = 0; lane < 8; lane++) {
+            state[lane] = _mm_aesenclast_si128(state[lane], roundKeys[rounds]);
+            _mm_storeu_si128((__m128i *) (destinations[lane] + block * 16), state[lane]);
+        }
+    }
+
+    for (DOTNET_INT lane = 0; lane < 8; lane++) {
+        _mm_storeu_si128((__m128i *) chains[lane], state[lane]);
+    }
+}
+
+XENO_NATIVE_TARGET("aes,sse2")
+DOTNET_PRIVATE void EncryptCbc_AESNI(const AES_MULTI_BUFFER_KEY *key, DOTNET_BYTE *const *chains, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_BYTE *const *destinations, DOTNET_INT lanes) {
+    __m128i roundKeys[15];
+
+    for (DOTNET_INT round = 0; round <= key->Rounds; round++) {
+        roundKeys[round] = _mm_loadu_si128((const __m128i *) (key->RoundKeys + round * 16));
+    }
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane += 8) {
+        DOTNET_BYTE *groupChains[8];
+        const DOTNET_BYTE *groupSources[8];
+        DOTNET_BYTE *groupDestinations[8];
+
+        // A partial group repeats its last lane, the duplicates compute and store exactly the same blocks.
+        for (DOTNET_INT i = 0; i < 8; i++) {
+            DOTNET_INT index = lane + i < lanes ? lane + i : lanes - 1;
+
+            groupChains[i] = chains[index];
+            groupSources[i] = sources[index];
+            groupDestinations[i] = destinations[index];
+        }
+
+        EncryptCbc8_AESNI(roundKeys, key->Rounds, groupChains, groupSources, sourceLength, groupDestinations);
+    }
+}
+
+XENO_NATIVE_TARGET("vaes,avx512f")
+DOTNET_PRIVATE __m512i LoadLanes_VAES512(const DOTNET_BYTE *const *inputs, DOTNET_INT offset) {
+    __m512i value = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *) (inputs[0] + offset)));
+    value = _mm512_inserti32x4(value, _mm_loadu_si128((const __m128i *) (inputs[1] + offset)), 1);
+    value = _mm512_inserti32x4(value, _mm_loadu_si128((const __m128i *) (inputs[2] + offset)), 2);
+    value = _mm512_inserti32x4(value, _mm_loadu_si128((const __m128i *) (inputs[3] + offset)), 3);
+    return value;
+}
+
+XENO_NATIVE_TARGET("vaes,avx512f")
+DOTNET_PRIVATE void StoreLanes_VAES512(__m512i value, DOTNET_BYTE *const *outputs, DOTNET_INT offset) {
+    _mm_storeu_si128((__m128i *) (outputs[0] + offset), _mm512_castsi512_si128(value));
+    _mm_storeu_si128((__m128i *) (outputs[1] + offset), _mm512_extracti32x4_epi32(value, 1));
+    _mm_storeu_si128((__m128i *) (outputs[2] + offset), _mm512_extracti32x4_epi32(value, 2));
+    _mm_storeu_si128((__m128i *) (outputs[3] + offset), _mm512_extracti32x4_epi32(value, 3));
+}
+
+XENO_NATIVE_TARGET("vaes,avx512f")
+DOTNET_PRIVATE void EncryptCbc16_VAES512(const AES_MULTI_BUFFER_KEY *key, DOTNET_BYTE *const *chains, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_BYTE *const *destinations) {
+    DOTNET_INT rounds = key->Rounds;
+    DOTNET_INT blocks = sourceLength / 16;
+
+    __m512i roundKeys[15];
+
+    for (DOTNET_INT round = 0; round <= rounds; round++) {
+        roundKeys[round] = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *) (key->RoundKeys + round * 16)));
+    }
+
+    // Each register carries four lanes, lane n lives in register n / 4 at position n % 4.
+    __m512i state[4];
+
+    for (DOTNET_INT i = 0; i < 4; i++) {
+        state[i] = LoadLanes_VAES512((const DOTNET_BYTE *const *) chains + i * 4, 0);
+    }
+
+    for (DOTNET_INT block = 0; block < blocks; block++) {
+        for (DOTNET_INT i = 0; i < 4; i++) {
+            state[i] = _mm512_xor_si512(state[i], _mm512_xor_si512(LoadLanes_VAES512(sources + i * 4, block * 16), roundKeys[0]));
+        }
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            __m512i roundKey = roundKeys[round];
+
+            state[0] = _mm512_aesenc_epi128(state[0], roundKey);
+            state[1] = _mm512_aesenc_epi128(state[1], roundKey);
+            state[2] = _mm512_aesenc_epi128(state[2], roundKey);
+            state[3] = _mm512_aesenc_epi128(state[3], roundKey);
+        }
+
+        for (DOTNET_INT i = 0; i < 4; i++) {
+            state[i] = _mm512_aesenclast_epi128(state[i], roundKeys[rounds]);
+            StoreLanes_VAES512(state[i], destinations + i * 4, block * 16);
+        }
+    }
+
+    for (DOTNET_INT i = 0; i < 4; i++) {
+        StoreLanes_VAES512(state[i], chains + i * 4, 0);
+    }
+}
+
+// Byte i of a cfb8 stream is decrypted with the encryption of the 16 cipher text bytes before it, window i starts at windows + i.
+XENO_NATIVE_TARGET("aes,sse2")
+DOTNET_PRIVATE void DecryptCfb8_AESNI(const AES_MULTI_BUFFER_KEY *key, DOTNET_READ_ONLY_SPAN_BYTE windows, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    DOTNET_INT rounds = key->Rounds;
+    __m128i roundKeys[15];
+
+    for (DOTNET_INT round = 0; round <= rounds; round++) {
+        roundKeys[round] = _mm_loadu_si128((const __m128i *) (key->RoundKeys + round * 16));
+    }
+
+    DOTNET_INT i = 0;
+
+    for (; i + 8 <= sourceLength; i += 8) {
+        __m128i state[8];
+
+        for (DOTNET_INT lane = 0; lane < 8; lane++) {
+            state[lane] = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (windows + i + lane)), roundKeys[0]);
+        }
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            __m128i roundKey = roundKeys[round];
+
+            state[0] = _mm_aesenc_si128(state[0], roundKey);
+            state[1] = _mm_aesenc_si128(state[1], roundKey);
+            state[2] = _mm_aesenc_si128(state[2], roundKey);
+            state[3] = _mm_aesenc_si128(state[3], roundKey);
+            state[4] = _mm_aesenc_si128(state[4], roundKey);
+            state[5] = _mm_aesenc_si128(state[5], roundKey);
+            state[6] = _mm_aesenc_si128(state[6], roundKey);
+            state[7] = _mm_aesenc_si128(state[7], roundKey);
+        }
+
+        for (DOTNET_INT lane = 0; lane < 8; lane++) {
+            state[lane] = _mm_aesenclast_si128(state[lane], roundKeys[rounds]);
+            destination[i + lane] = source[i + lane] ^ (DOTNET_BYTE) _mm_cvtsi128_si32(state[lane]);
+        }
+    }
+
+    for (; i < sourceLength; i++) {
+        __m128i state = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (windows + i)), roundKeys[0]);
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            state = _mm_aesenc_si128(state, roundKeys[round]);
+        }
+
+        state = _mm_aesenclast_si128(state, roundKeys[rounds]);
+        destination[i] = source[i] ^ (DOTNET_BYTE) _mm_cvtsi128_si32(state);
+    }
+}
+
+XENO_NATIVE_TARGET("vaes,avx512f")
+DOTNET_PRIVATE __m512i LoadWindows_VAES512(DOTNET_READ_ONLY_SPAN_BYTE windows) {
+    __m512i value = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *) windows));
+    value = _mm512_inserti32x4(value, _mm_loadu_si128((const __m128i *) (windows + 1)), 1);
+    value = _mm512_inserti32x4(value, _mm_loadu_si128((const __m128i *) (windows + 2)), 2);
+    value = _mm512_inserti32x4(value, _mm_loadu_si128((const __m128i *) (windows + 3)), 3);
+    return value;
+}
+
+XENO_NATIVE_TARGET("vaes,avx512f")
+DOTNET_PRIVATE DOTNET_INT DecryptCfb8_VAES512(const AES_MULTI_BUFFER_KEY *key, DOTNET_READ_ONLY_SPAN_BYTE windows, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    DOTNET_INT rounds = key->Rounds;
+
+    __m512i roundKeys[15];
+
+    for (DOTNET_INT round = 0; round <= rounds; round++) {
+        roundKeys[round] = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *) (key->RoundKeys + round * 16)));
+    }
+
+    DOTNET_INT i = 0;
+
+    // Sixteen windows are in flight, register n holds windows 4n to 4n + 3.
+    for (; i + 16 <= sourceLength; i += 16) {
+        __m512i state[4];
+
+        for (DOTNET_INT n = 0; n < 4; n++) {
+            state[n] = _mm512_xor_si512(LoadWindows_VAES512(windows + i + n * 4), roundKeys[0]);
+        }
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            __m512i roundKey = roundKeys[round];
+
+            state[0] = _mm512_aesenc_epi128(state[0], roundKey);
+            state[1] = _mm512_aesenc_epi128(state[1], roundKey);
+            state[2] = _mm512_aesenc_epi128(state[2], roundKey);
+            state[3] = _mm512_aesenc_epi128(state[3], roundKey);
+        }
+
+        DOTNET_BYTE keyStream[4][64];
+
+        for (DOTNET_INT n = 0; n < 4; n++) {
+            _mm512_storeu_si512(keyStream[n], _mm512_aesenclast_epi128(state[n], roundKeys[rounds]));
+        }
+
+        for (DOTNET_INT n = 0; n < 16; n++) {
+            destination[i + n] = source[i + n] ^ keyStream[n / 4][n % 4 * 16];
+        }
+    }
+
+    return i;
+}
+
+// Cfb128 encryption feeds every cipher text block into the next one, so only independent lanes can be interleaved.
+XENO_NATIVE_TARGET("aes,sse2")
+DOTNET_PRIVATE void EncryptCfb128_8_AESNI(const __m128i *roundKeys, DOTNET_INT rounds, CFB128_LANE *const *lanes, DOTNET_INT blocks) {
+    __m128i state[8];
+
+    for (DOTNET_INT lane = 0; lane < 8; lane++) {
+        state[lane] = _mm_loadu_si128((const __m128i *) lanes[lane]->Iv);
+    }
+
+    for (DOTNET_INT block = 0; block < blocks; block++) {
+        for (DOTNET_INT lane = 0; lane < 8; lane++) {
+            state[lane] = _mm_xor_si128(state[lane], roundKeys[0]);
+        }
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            __m128i roundKey = roundKeys[round];
+
+            state[0] = _mm_aesenc_si128(state[0], roundKey);
+            state[1] = _mm_aesenc_si128(state[1], roundKey);
+            state[2] = _mm_aesenc_si128(state[2], roundKey);
+            state[3] = _mm_aesenc_si128(state[3], roundKey);
+            state[4] = _mm_aesenc_si128(state[4], roundKey);
+            state[5] = _mm_aesenc_si128(state[5], roundKey);
+            state[6] = _mm_aesenc_si128(state[6], roundKey);
+            state[7] = _mm_aesenc_si128(state[7], roundKey);
+        }
+
+        for (DOTNET_INT lane = 0; lane < 8; lane++) {
+            state[lane] = _mm_xor_si128(_mm_aesenclast_si128(state[lane], roundKeys[rounds]), _mm_loadu_si128((const __m128i *) GetCfb128Source(lanes[lane], block)));
+        }
+
+        // Every lane loads its block before any lane stores, a repeated lane then writes the same block twice.
+        for (DOTNET_INT lane = 0; lane < 8; lane++) {
+            _mm_storeu_si128((__m128i *) GetCfb128Destination(lanes[lane], block), state[lane]);
+        }
+    }
+}
+
+XENO_NATIVE_TARGET("aes,sse2")
+DOTNET_PRIVATE void EncryptCfb128_1_AESNI(const __m128i *roundKeys, DOTNET_INT rounds, CFB128_LANE *lane, DOTNET_INT blocks) {
+    __m128i state = _mm_loadu_si128((const __m128i *) lane->Iv);
+
+    for (DOTNET_INT block = 0; block < blocks; block++) {
+        state = _mm_xor_si128(state, roundKeys[0]);
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            state = _mm_aesenc_si128(state, roundKeys[round]);
+        }
+
+        state = _mm_xor_si128(_mm_aesenclast_si128(state, roundKeys[rounds]), _mm_loadu_si128((const __m128i *) GetCfb128Source(lane, block)));
+        _mm_storeu_si128((__m128i *) GetCfb128Destination(lane, block), state);
+    }
+}
+
+XENO_NATIVE_TARGET("aes,sse2")
+DOTNET_PRIVATE void EncryptCfb128_AESNI(const AES_MULTI_BUFFER_KEY *key, CFB128_LANE *const *lanes, DOTNET_INT lanesLength, DOTNET_INT blocks) {
+    __m128i roundKeys[15];
+
+    for (DOTNET_INT round = 0; round <= key->Rounds; round++) {
+        roundKeys[round] = _mm_loadu_si128((const __m128i *) (key->RoundKeys + round * 16));
+    }
+
+    // A single lane would only repeat itself in the wide kernel, which then runs out of aes units instead of waiting on them.
+    if (lanesLength == 1) {
+        EncryptCfb128_1_AESNI(roundKeys, key->Rounds, lanes[0], blocks);
+        return;
+    }
+
+    for (DOTNET_INT lane = 0; lane < lanesLength; lane += 8) {
+        CFB128_LANE *group[8];
+
+        for (DOTNET_INT i = 0; i < 8; i++) {
+            group[i] = lanes[lane + i < lanesLength ? lane + i : lanesLength - 1];
+        }
+
+        EncryptCfb128_8_AESNI(roundKeys, key->Rounds, group, blocks);
+    }
+}
+
+XENO_NATIVE_TARGET("vaes,avx512f")
+DOTNET_PRIVATE void EncryptCfb128_16_VAES512(const AES_MULTI_BUFFER_KEY *key, CFB128_LANE *const *lanes, DOTNET_INT blocks) {
+    DOTNET_INT rounds = key->Rounds;
+
+    __m512i roundKeys[15];
+
+    for (DOTNET_INT round = 0; round <= rounds; round++) {
+        roundKeys[round] = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *) (key->RoundKeys + round * 16)));
+    }
+
+    DOTNET_READ_ONLY_SPAN_BYTE sources[16];
+    DOTNET_SPAN_BYTE destinations[16];
+
+    for (DOTNET_INT lane = 0; lane < 16; lane++) {
+        sources[lane] = lanes[lane]->Iv;
+    }
+
+    // Lane n lives in register n / 4 at position n % 4, as in the cbc kernel.
+    __m512i state[4];
+
+    for (DOTNET_INT i = 0; i < 4; i++) {
+        state[i] = LoadLanes_VAES512(sources + i * 4, 0);
+    }
+
+    for (DOTNET_INT block = 0; block < blocks; block++) {
+        for (DOTNET_INT lane = 0; lane < 16; lane++) {
+            sources[lane] = GetCfb128Source(lanes[lane], block);
+            destinations[lane] = GetCfb128Destination(lanes[lane], block);
+        }
+
+        for (DOTNET_INT i = 0; i < 4; i++) {
+            state[i] = _mm512_xor_si512(state[i], roundKeys[0]);
+        }
+
+        for (DOTNET_INT round = 1; round < rounds; round++) {
+            __m512i roundKey = roundKeys[round];
+
+            state[0] = _mm512_aesenc_epi128(state[0], roundKey);
+            state[1] = _mm512_aesenc_epi128(state[1], roundKey);
+            state[2] = _mm512_aesenc_epi128(state[2], roundKey);
+            state[3] = _mm512_aesenc_epi128(state[3], roundKey);
+        }
+
+        for (DOTNET_INT i = 0; i < 4; i++) {
+            state[i] = _mm512_xor_si512(_mm512_aesenclast_epi128(state[i], roundKeys[rounds]), LoadLanes_VAES512(sources + i * 4, 0));
+        }
+
+        for (DOTNET_INT i = 0; i < 4; i++) {
+            StoreLanes_VAES512(state[i], destinations + i * 4, 0);
+        }
+    }
+}
+
+#endif
+
+DOTNET_BOOL AesMultiBufferUtility_Encrypt_CBC_Blocks(const AES_MULTI_BUFFER_KEY *key, DOTNET_BYTE *const *chains, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_BYTE *const *destinations, DOTNET_INT lanes) {
+    if (key == NULL || chains == NULL || sources == NULL || sourceLength < 0 || sourceLength % 16 != 0 || destinations == NULL || lanes <= 0) {
+        return DOTNET_FALSE;
+    }
+
+#ifdef XENO_NATIVE_X86
+    if (!CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AES)) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_INT lane = 0;
+
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_VAES | CPU_DISPATCH_FEATURE_AVX512F)) {
+        for (; lane + 16 <= lanes; lane += 16) {
+            EncryptCbc16_VAES512(key, chains + lane, sources + lane, sourceLength, destinations + lane);
+        }
+    }
+
+    if (lane < lanes) {
+        EncryptCbc_AESNI(key, chains + lane, sources + lane, sourceLength, destinations + lane, lanes - lane);
+    }
+
+    return DOTNET_TRUE;
+#else
+    return DOTNET_FALSE;
+#endif
+}
+
+DOTNET_INT AesMultiBufferUtility_Encrypt_CBC(const AES_MULTI_BUFFER_KEY *key, DOTNET_READ_ONLY_SPAN_BYTE iv, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_BYTE *const *destinations, DOTNET_INT lanes) {
+    if (key == NULL || iv == NULL || sources == NULL || sourceLength < 0 || destinations == NULL || lanes <= 0) {
+        return 0;
+    }
+
+    DOTNET_INT fullLength = sourceLength / 16 * 16;
+    DOTNET_INT remaining = sourceLength - fullLength;
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane += AES_MULTI_BUFFER_MAX_LANES) {
+        DOTNET_INT groupLanes = lanes - lane < AES_MULTI_BUFFER_MAX_LANES ? lanes - lane : AES_MULTI_BUFFER_MAX_LANES;
+
+        DOTNET_BYTE chains[AES_MULTI_BUFFER_MAX_LANES][16];
+        DOTNET_BYTE lastBlocks[AES_MULTI_BUFFER_MAX_LANES][16];
+        DOTNET_BYTE *chainPointers[AES_MULTI_BUFFER_MAX_LANES];
+        DOTNET_BYTE *lastBlockPointers[AES_MULTI_BUFFER_MAX_LANES];
+        DOTNET_BYTE *lastDestinations[AES_MULTI_BUFFER_MAX_LANES];
+
+        // The final block of each lane carries the PKCS7 padding.
+        for (DOTNET_INT i = 0; i < groupLanes; i++) {
+            memcpy(chains[i], iv, 16);
+            memcpy(lastBlocks[i], sources[lane + i] + fullLength, remaining);
+            memset(lastBlocks[i] + remaining, 16 - remaining, 16 - remaining);
+
+            chainPointers[i] = chains[i];
+            lastBlockPointers[i] = lastBlocks[i];
+            lastDestinations[i] = destinations[lane + i] + fullLength;
+        }
+
+        if (fullLength > 0 && !AesMultiBufferUtility_Encrypt_CBC_Blocks(key, chainPointers, sources + lane, fullLength, destinations + lane, groupLanes)) {
+            return 0;
+        }
+
+        if (!AesMultiBufferUtility_Encrypt_CBC_Blocks(key, chainPointers, (const DOTNET_BYTE *const *) lastBlockPointers, 16, lastDestinations, groupLanes)) {
+            return 0;
+        }
+    }
+
+    return fullLength + 16;
+}
+
+DOTNET_BOOL AesMultiBufferUtility_Encrypt_CFB128_Iterations(const AES_MULTI_BUFFER_KEY *key, const DOTNET_BYTE *const *ivs, DOTNET_INT iterations, const DOTNET_BYTE *const *sources, DOTNET_BYTE *const *destinations, DOTNET_SPAN_INT lengths, DOTNET_INT lanes) {
+    if (key == NULL || ivs == NULL || iterations < 0 || sources == NULL || destinations == NULL || lengths == NULL || lanes <= 0) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        if (ivs[lane] == NULL || sources[lane] == NULL || destinations[lane] == NULL || lengths[lane] < 0) {
+            return DOTNET_FALSE;
+        }
+    }
+
+#ifdef XENO_NATIVE_X86
+    if (!CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AES)) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_BOOL hasVaes = CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_VAES | CPU_DISPATCH_FEATURE_AVX512F);
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane += AES_MULTI_BUFFER_MAX_LANES) {
+        DOTNET_INT groupLanes = lanes - lane < AES_MULTI_BUFFER_MAX_LANES ? lanes - lane : AES_MULTI_BUFFER_MAX_LANES;
+
+        CFB128_LANE cfbLanes[AES_MULTI_BUFFER_MAX_LANES];
+        CFB128_LANE *cfbLanePointers[AES_MULTI_BUFFER_MAX_LANES];
+
+        for (DOTNET_INT i = 0; i < groupLanes; i++) {
+            cfbLanes[i].Iv = ivs[lane + i];
+            cfbLanes[i].Source = sources[lane + i];
+            cfbLanes[i].Destination = destinations[lane + i];
+            cfbLanePointers[i] = &cfbLanes[i];
+        }
+
+        // A partial group repeats its last lane, the duplicates compute and store exactly the same blocks.
+        for (DOTNET_INT i = groupLanes; i < AES_MULTI_BUFFER_MAX_LANES; i++) {
+            cfbLanePointers[i] = &cfbLanes[groupLanes - 1];
+        }
+
+        for (DOTNET_INT iteration = 0; iteration < iterations; iteration++) {
+            DOTNET_INT blocks = 0;
+
+            // The padding never touches the lane buffer, it is encrypted from the tail block.
+            for (DOTNET_INT i = 0; i < groupLanes; i++) {
+                DOTNET_INT remaining = lengths[lane + i] % 16;
+
+                cfbLanes[i].FullBlocks = lengths[lane + i] / 16;
+                memcpy(cfbLanes[i].Tail, cfbLanes[i].Source + cfbLanes[i].FullBlocks * 16, remaining);
+                memset(cfbLanes[i].Tail + remaining, 16 - remaining, 16 - remaining);
+
+                if (cfbLanes[i].FullBlocks + 1 > blocks) {
+                    blocks = cfbLanes[i].FullBlocks + 1;
+                }
+            }
+
+            if (hasVaes && groupLanes > 8) {
+                EncryptCfb128_16_VAES512(key, cfbLanePointers, blocks);
+            } else {
+                EncryptCfb128_AESNI(key, cfbLanePointers, groupLanes, blocks);
+            }
+
+            for (DOTNET_INT i = 0; i < groupLanes; i++) {
+                lengths[lane + i] = (cfbLanes[i].FullBlocks + 1) * 16;
+                cfbLanes[i].Source = cfbLanes[i].Destination;
+            }
+        }
+
+        if (iterations == 0) {
+            for (DOTNET_INT i = 0; i < groupLanes; i++) {
+                memmove(destinations[lane + i], sources[lane + i], lengths[lane + i]);
+            }
+        }
+    }
+
+    return DOTNET_TRUE;
+#else
+    return DOTNET_FALSE;
+#endif
+}
+
+DOTNET_BOOL AesMultiBufferUtility_Decrypt_CFB8(const AES_MULTI_BUFFER_KEY *key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    if (key == NULL || iv == NULL || source == NULL || sourceLength < 0 || destination == NULL) {
+        return DOTNET_FALSE;
+    }
+
+#ifdef XENO_NATIVE_X86
+    if (!CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AES)) {
+        return DOTNET_FALSE;
+    }
+
+    // The first 16 windows reach back into the iv, every later window lies inside the cipher text.
+    DOTNET_INT headLength = sourceLength < 16 ? sourceLength : 16;
+    DOTNET_BYTE head[32] = {0};
+
+    memcpy(head, iv, 16);
+    memcpy(head + 16, source, headLength);
+
+    DecryptCfb8_AESNI(key, head, source, headLength, destination);
+
+    DOTNET_INT offset = headLength;
+
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_VAES | CPU_DISPATCH_FEATURE_AVX512F)) {
+        offset += DecryptCfb8_VAES512(key, source + offset - 16, source + offset, sourceLength - offset, destination + offset);
+    }
+
+    DecryptCfb8_AESNI(key, source + offset - 16, source + offset, sourceLength - offset, destination + offset);
+
+    return DOTNET_TRUE;
+#else
+    return DOTNET_FALSE;
+#endif
+}
@@ -0,0 +1,26 @@
+#ifndef AESMULTIBUFFERUTILITY_H
+#define AESMULTIBUFFERUTILITY_H
+
+#include "global.h"
+
+#define AES_MULTI_BUFFER_MAX_LANES 16
+
+typedef struct AES_MULTI_BUFFER_KEY {
+    DOTNET_BYTE RoundKeys[15 * 16];
+    DOTNET_INT Rounds;
+} AES_MULTI_BUFFER_KEY;
+
+DOTNET_INT AesMultiBufferUtility_GetLaneCount(void);
+DOTNET_STRING AesMultiBufferUtility_GetKernelName(void);
+DOTNET_BOOL AesMultiBufferUtility_ExpandKey(AES_MULTI_BUFFER_KEY *key, DOTNET_INT keySize, DOTNET_READ_ONLY_SPAN_BYTE keyBytes);
+DOTNET_BOOL AesMultiBufferUtility_Encrypt_CBC_Blocks(const AES_MULTI_BUFFER_KEY *key, DOTNET_BYTE *const *chains, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_BYTE *const *destinations, DOTNET_INT lanes);
+DOTNET_INT AesMultiBufferUtility_Encrypt_CBC(const AES_MULTI_BUFFER_KEY *key, DOTNET_READ_ONLY_SPAN_BYTE iv, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength, DOTNET_BYTE *const *destinations, DOTNET_INT lanes);
+
+// Lane n is padded with PKCS7 and encrypted with cfb128 from ivs[n], iterations times, every iteration encrypting the previous one in place.
+// The first iteration reads sources, which are either the destinations or do not overlap them, a lane grows by 1 to 16 bytes per iteration.
+DOTNET_BOOL AesMultiBufferUtility_Encrypt_CFB128_Iterations(const AES_MULTI_BUFFER_KEY *key, const DOTNET_BYTE *const *ivs, DOTNET_INT iterations, const DOTNET_BYTE *const *sources, DOTNET_BYTE *const *destinations, DOTNET_SPAN_INT lengths, DOTNET_INT lanes);
+
+// Source and destination must not overlap, every output byte is computed from cipher text up to 16 bytes behind it.
+DOTNET_BOOL AesMultiBufferUtility_Decrypt_CFB8(const AES_MULTI_BUFFER_KEY *key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
+
+#endif
@@ -1,7 +1,271 @@
 #include "Base58Utility.h"
+#include "CryptographyUtility.h"
+#include "MessageDigestUtility.h"
 
-DOTNET_PRIVATE DOTNET_BYTE Base58Characters[] = {
+// 58^5 is the largest power of 58 below 2^32, every limb then holds 5 digits and a limb shifted by 32 bits still fits in 64.
+#define BASE58_LIMB_BASE 656356768ULL
+#define BASE58_LIMB_DIGITS 5
+#define BASE58_ENCODE_LIMBS (BASE58_MAX_DECODE_LENGTH * 8 / 29 + 2)
+#define BASE58_DECODE_LIMBS (BASE58_MAX_DECODE_LENGTH / 4 + 1)
+
+DOTNET_PRIVATE const DOTNET_BYTE Base58Characters[] = {
     '1', '2', '3', '4', '5', '6', '7', '8', '9',
     'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'J', 'K', 'L', 'M', 'N', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
     'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'};
 
+DOTNET_PRIVATE const DOTNET_BYTE DecodeTable[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0xff, 0x11, 0x12, 0x13, 0x14, 0x15, 0xff,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0xff, 0x2c, 0x2d, 0x2e,
+    0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+// Multiplies the base 58^5 number by 2^shift and adds value.
+DOTNET_PRIVATE DOTNET_INT ShiftAddBase58Limbs(DOTNET_UINT *limbs, DOTNET_INT limbsLength, DOTNET_INT shift, DOTNET_ULONG value) {
+    DOTNET_ULONG carry = value;
+
+    for (DOTNET_INT i = 0; i < limbsLength; i++) {
+        carry += (DOTNET_ULONG) limbs[i] << shift;
+        limbs[i] = (DOTNET_UINT) (carry % BASE58_LIMB_BASE);
+        carry /= BASE58_LIMB_BASE;
+    }
+
+    while (carry > 0) {
+        limbs[limbsLength++] = (DOTNET_UINT) (carry % BASE58_LIMB_BASE);
+        carry /= BASE58_LIMB_BASE;
+    }
+
+    return limbsLength;
+}
+
+DOTNET_PUBLIC DOTNET_INT Base58Utility_EncodeLength(DOTNET_INT inputLength) {
+    return inputLength * 138 / 100 + 1;
+}
+
+DOTNET_PUBLIC DOTNET_INT Base58Utility_DecodeLength(DOTNET_INT inputLength) {
+    // Every leading '1' is a whole byte, so only the character count itself is a bound.
+    return inputLength;
+}
+
+DOTNET_PUBLIC DOTNET_INT Base58Utility_Encode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    if (input == NULL || inputLength <= 0 || inputLength > BASE58_MAX_DECODE_LENGTH || output == NULL) {
+        return 0;
+    }
+
+    DOTNET_INT zeros = 0;
+
+    while (zeros < inputLength && input[zeros] == 0) {
+        zeros++;
+    }
+
+    // The input is consumed 32 bits at a time instead of byte by byte, a partial word goes first.
+    DOTNET_UINT limbs[BASE58_ENCODE_LIMBS];
+    DOTNET_INT limbsLength = 0;
+    DOTNET_INT i = zeros;
+    DOTNET_INT headLength = (inputLength - zeros) % 4;
+
+    if (headLength > 0) {
+        DOTNET_ULONG value = 0;
+
+        for (; i < zeros + headLength; i++) {
+            value = value << 8 | input[i];
+        }
+
+        limbsLength = ShiftAddBase58Limbs(limbs, limbsLength, 8 * headLength, value);
+    }
+
+    for (; i < inputLength; i += 4) {
+        DOTNET_ULONG value = (DOTNET_ULONG) input[i] << 24 | (DOTNET_ULONG) input[i + 1] << 16 | (DOTNET_ULONG) input[i + 2] << 8 | input[i + 3];
+        limbsLength = ShiftAddBase58Limbs(limbs, limbsLength, 32, value);
+    }
+
+    DOTNET_INT outputLength = 0;
+
+    for (; outputLength < zeros; outputLength++) {
+        output[outputLength] = Base58Characters[0];
+    }
+
+    if (limbsLength == 0) {
+        return outputLength;
+    }
+
+    // The most significant limb drops its leading zero digits, every other limb writes all 5.
+    DOTNET_BYTE digits[BASE58_LIMB_DIGITS];
+    DOTNET_INT digitsLength = 0;
+
+    for (DOTNET_UINT value = limbs[limbsLength - 1]; value > 0; value /= 58) {
+        digits[digitsLength++] = Base58Characters[value % 58];
+    }
+
+    while (digitsLength > 0) {
+        output[outputLength++] = digits[--digitsLength];
+    }
+
+    for (DOTNET_INT j = limbsLength - 2; j >= 0; j--) {
+        DOTNET_UINT value = limbs[j];
+
+        for (DOTNET_INT k = BASE58_LIMB_DIGITS - 1; k >= 0; k--) {
+            output[outputLength + k] = Base58Characters[value % 58];
+            value /= 58;
+        }
+
+        outputLength += BASE58_LIMB_DIGITS;
+    }
+
+    return outputLength;
+}
+
+DOTNET_PUBLIC DOTNET_INT Base58Utility_Decode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    if (input == NULL || inputLength < 0 || output == NULL) {
+        return -1;
+    }
+
+    DOTNET_INT zeros = 0;
+
+    while (zeros < inputLength && input[zeros] == Base58Characters[0]) {
+        zeros++;
+    }
+
+    // Up to 5 digits are folded into one multiply add over 32 bit limbs, a partial group goes first.
+    DOTNET_UINT limbs[BASE58_DECODE_LIMBS];
+    DOTNET_INT limbsLength = 0;
+    DOTNET_INT groupLength = (inputLength - zeros) % BASE58_LIMB_DIGITS;
+
+    if (groupLength == 0) {
+        groupLength = BASE58_LIMB_DIGITS;
+    }
+
+    for (DOTNET_INT i = zeros; i < inputLength; i += groupLength, groupLength = BASE58_LIMB_DIGITS) {
+        DOTNET_ULONG value = 0, multiplier = 1;
+
+        for (DOTNET_INT j = i; j < i + groupLength; j++) {
+            DOTNET_BYTE digit = DecodeTable[input[j]];
+
+            if (digit & 0x80) {
+                return -1;
+            }
+
+            value = value * 58 + digit;
+            multiplier *= 58;
+        }
+
+        DOTNET_ULONG carry = value;
+
+        for (DOTNET_INT j = 0; j < limbsLength; j++) {
+            carry += limbs[j] * multiplier;
+            limbs[j] = (DOTNET_UINT) carry;
+            carry >>= 32;
+        }
+
+        if (carry > 0) {
+            if (limbsLength == BASE58_DECODE_LIMBS) {
+                return -1;
+            }
+
+            limbs[limbsLength++] = (DOTNET_UINT) carry;
+        }
+    }
+
+    DOTNET_INT topLength = 0;
+
+    if (limbsLength > 0) {
+        for (DOTNET_UINT value = limbs[limbsLength - 1]; value > 0; value >>= 8) {
+            topLength++;
+        }
+    }
+
+    DOTNET_INT outputLength = zeros + (limbsLength > 0 ? 4 * (limbsLength - 1) + topLength : 0);
+
+    if (outputLength > BASE58_MAX_DECODE_LENGTH) {
+        return -1;
+    }
+
+    memset(output, 0, zeros);
+
+    DOTNET_SPAN_BYTE destination = output + outputLength;
+
+    for (DOTNET_INT j = 0; j < limbsLength; j++) {
+        DOTNET_UINT value = limbs[j];
+        DOTNET_INT bytes = j == limbsLength - 1 ? topLength : 4;
+
+        for (DOTNET_INT k = 0; k < bytes; k++) {
+            *--destination = (DOTNET_BYTE) value;
+            value >>= 8;
+        }
+    }
+
+    return outputLength;
+}
+
+DOTNET_PUBLIC DOTNET_INT Base58Utility_ValidateWalletAddresses(DOTNET_READ_ONLY_SPAN_BYTE addresses, DOTNET_READ_ONLY_SPAN_INT addressLengths, DOTNET_INT addressCount, DOTNET_INT minLength, DOTNET_INT maxLength, DOTNET_BOOL requireChecksum, DOTNET_BOOL *results) {
+    if (addresses == NULL || addressLengths == NULL || addressCount < 0 || results == NULL) {
+        return 0;
+    }
+
+    const EVP_MD *sha256 = NULL;
+    EVP_MD_CTX *context = NULL;
+
+    if (requireChecksum) {
+        sha256 = CryptographyUtility_GetMessageDigest(CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_256);
+        context = CryptographyUtility_RentMessageDigestContext();
+
+        if (sha256 == NULL || context == NULL) {
+            CryptographyUtility_ReturnMessageDigestContext(context);
+            memset(results, 0, sizeof(DOTNET_BOOL) * addressCount);
+            return 0;
+        }
+    }
+
+    DOTNET_INT validCount = 0;
+    DOTNET_INT offset = 0;
+
+    for (DOTNET_INT i = 0; i < addressCount; offset += addressLengths[i], i++) {
+        results[i] = DOTNET_FALSE;
+
+        // Length and alphabet are checked before any arithmetic so junk is turned away cheaply.
+        if (addressLengths[i] < minLength || addressLengths[i] > maxLength) {
+            continue;
+        }
+
+        DOTNET_BYTE payload[BASE58_MAX_DECODE_LENGTH];
+        DOTNET_INT payloadLength = Base58Utility_Decode(addresses + offset, addressLengths[i], payload);
+
+        if (payloadLength <= 0) {
+            continue;
+        }
+
+        if (requireChecksum) {
+            DOTNET_BYTE hash[32];
+
+            if (payloadLength <= BASE58_CHECKSUM_LENGTH) {
+                continue;
+            }
+
+            if (MessageDigestUtility_ComputeHash_EVP_MD_CTX(context, sha256, payload, payloadLength - BASE58_CHECKSUM_LENGTH, hash) != 32 || MessageDigestUtility_ComputeHash_EVP_MD_CTX(context, sha256, hash, 32, hash) != 32) {
+                continue;
+            }
+
+            if (memcmp(hash, payload + payloadLength - BASE58_CHECKSUM_LENGTH, BASE58_CHECKSUM_LENGTH) != 0) {
+                continue;
+            }
+        }
+
+        results[i] = DOTNET_TRUE;
+        validCount++;
+    }
+
+    CryptographyUtility_ReturnMessageDigestContext(context);
+
+    return validCount;
+}
@@ -3,4 +3,23 @@
 
 #include "global.h"
 
+#define BASE58_MAX_DECODE_LENGTH 1024
+#define BASE58_CHECKSUM_LENGTH 4
+
+// Standard Base58, each leading zero byte is a leading '1'. The managed Encode and Decode pad to a fixed width with '1' and 0 instead, so the two only agree
+// on values that fill that width. Wallet validation without a checksum only looks at the length and the alphabet, where both accept the same strings.
+
+// Upper bounds of the output length.
+DOTNET_INT Base58Utility_EncodeLength(DOTNET_INT inputLength);
+DOTNET_INT Base58Utility_DecodeLength(DOTNET_INT inputLength);
+
+// Returns the characters written, 0 when the input is empty or longer than BASE58_MAX_DECODE_LENGTH.
+DOTNET_INT Base58Utility_Encode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output);
+
+// Returns the bytes written, -1 at the first character outside the alphabet or when the result would exceed BASE58_MAX_DECODE_LENGTH.
+DOTNET_INT Base58Utility_Decode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output);
+
+// Addresses are packed back to back, results[i] is TRUE when address i has between minLength and maxLength characters, decodes and, with requireChecksum, ends with the first 4 bytes of the double SHA-256 of the rest. Returns the number of valid addresses.
+DOTNET_INT Base58Utility_ValidateWalletAddresses(DOTNET_READ_ONLY_SPAN_BYTE addresses, DOTNET_READ_ONLY_SPAN_INT addressLengths, DOTNET_INT addressCount, DOTNET_INT minLength, DOTNET_INT maxLength, DOTNET_BOOL requireChecksum, DOTNET_BOOL *results);
+
 #endif
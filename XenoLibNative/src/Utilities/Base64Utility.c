@@ -1,53 +1,39 @@
 #include "Base64Utility.h"
+#include "CpuDispatchUtility.h"
 
-DOTNET_PRIVATE DOTNET_BYTE Base64Characters[] = {
+#if defined(XENO_NATIVE_X86)
+#include <immintrin.h>
+#elif defined(XENO_NATIVE_ARM64)
+#include <arm_neon.h>
+#endif
+
+DOTNET_PRIVATE const DOTNET_BYTE Base64Characters[] = {
     'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
     'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
     'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
     'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/', '='};
 
-DOTNET_PRIVATE DOTNET_BYTE DecodeByte(DOTNET_BYTE value) {
-    if (value >= 'A' && value <= 'Z') {
-        return value - 'A';
-    } else if (value >= 'a' && value <= 'z') {
-        return value - 'a' + 26;
-    } else if (value >= '0' && value <= '9') {
-        return value - '0' + 52;
-    } else if (value == '+') {
-        return 62;
-    } else {
-        return 63;
-    }
-}
-
-DOTNET_PUBLIC DOTNET_INT Base64Utility_EncodeLength(DOTNET_INT inputLength) {
-    return 4 * ((inputLength + 3 - 1) / 3);
-}
-
-DOTNET_PUBLIC DOTNET_INT Base64Utility_DecodeLength(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength) {
-    if (input == NULL || inputLength % 4 != 0) {
-        return 0;
-    }
-
-    DOTNET_INT paddingLength = 0;
-
-    for (DOTNET_INT i = inputLength - 1; i >= 0; i--) {
-        if (input[i] != '=') {
-            break;
-        }
-
-        paddingLength++;
-    }
-
-    return 3 * (inputLength / 4) - paddingLength;
-}
-
-DOTNET_PUBLIC DOTNET_INT Base64Utility_Encode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
-    if (input == NULL || inputLength == 0 || output == NULL) {
-        return 0;
-    }
+// Characters outside the alphabet map to 0xff so a whole group can be checked with one or.
+DOTNET_PRIVATE const DOTNET_BYTE DecodeTable[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
 
+DOTNET_INT Base64Utility_Encode_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
     DOTNET_INT paddingLength = inputLength % 3;
     DOTNET_INT noPaddingLength = inputLength - paddingLength;
     DOTNET_INT encodeLength = 0;
@@ -81,43 +67,354 @@ DOTNET_PUBLIC DOTNET_INT Base64Utility_Encode(DOTNET_READ_ONLY_SPAN_BYTE input,
     return encodeLength;
 }
 
-DOTNET_PUBLIC DOTNET_INT Base64Utility_Decode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
-    if (input == NULL || inputLength % 4 != 0 || output == NULL) {
+DOTNET_INT Base64Utility_Decode_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    if (inputLength == 0) {
         return 0;
     }
 
-    DOTNET_INT paddingLength = 0;
+    // Only the last group may be padded and never with more than two characters, any other '=' fails the table lookup.
+    DOTNET_INT paddingLength = input[inputLength - 1] == '=' ? (input[inputLength - 2] == '=' ? 2 : 1) : 0;
+    DOTNET_INT noPaddingLength = paddingLength > 0 ? inputLength - 4 : inputLength;
+    DOTNET_INT decodeLength = 0;
 
-    for (DOTNET_INT i = inputLength - 1; i >= 0; i--) {
-        if (input[i] != '=') {
+    for (DOTNET_INT i = 0; i < noPaddingLength; i += 4) {
+        DOTNET_BYTE a = DecodeTable[input[i]], b = DecodeTable[input[i + 1]], c = DecodeTable[input[i + 2]], d = DecodeTable[input[i + 3]];
+
+        if ((a | b | c | d) & 0x80) {
+            return -1;
+        }
+
+        output[decodeLength++] = (DOTNET_BYTE) ((a << 2) | (b >> 4));
+        output[decodeLength++] = (DOTNET_BYTE) ((b << 4) | (c >> 2));
+        output[decodeLength++] = (DOTNET_BYTE) ((c << 6) | d);
+    }
+
+    if (paddingLength == 0) {
+        return decodeLength;
+    }
+
+    DOTNET_BYTE a = DecodeTable[input[noPaddingLength]], b = DecodeTable[input[noPaddingLength + 1]];
+    DOTNET_BYTE c = paddingLength == 1 ? DecodeTable[input[noPaddingLength + 2]] : 0;
+
+    if ((a | b | c) & 0x80) {
+        return -1;
+    }
+
+    output[decodeLength++] = (DOTNET_BYTE) ((a << 2) | (b >> 4));
+
+    if (paddingLength == 1) {
+        output[decodeLength++] = (DOTNET_BYTE) ((b << 4) | (c >> 2));
+    }
+
+    return decodeLength;
+}
+
+#if defined(XENO_NATIVE_X86)
+
+// Spreads every 3 input bytes over 4 bytes holding one 6 bit index each, the multiplies move the fields into place.
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE __m128i EncodeReshuffle_SSSE3(__m128i value) {
+    value = _mm_shuffle_epi8(value, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    const __m128i high = _mm_mulhi_epu16(_mm_and_si128(value, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const __m128i low = _mm_mullo_epi16(_mm_and_si128(value, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+
+    return _mm_or_si128(high, low);
+}
+
+// Every alphabet range is a constant offset from its index, the range selects the offset.
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE __m128i EncodeTranslate_SSSE3(__m128i indices) {
+    const __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    range = _mm_sub_epi8(range, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+// Classifies each character by its nibbles, returns FALSE when the block holds anything outside the alphabet.
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE DOTNET_BOOL DecodeTranslate_SSSE3(__m128i *value) {
+    const __m128i lowLookup = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i highLookup = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i rollLookup = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i slash = _mm_set1_epi8(0x2f);
+
+    const __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(*value, 4), slash);
+    const __m128i lowNibbles = _mm_and_si128(*value, slash);
+    const __m128i classes = _mm_and_si128(_mm_shuffle_epi8(lowLookup, lowNibbles), _mm_shuffle_epi8(highLookup, highNibbles));
+
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(classes, _mm_setzero_si128())) != 0) {
+        return DOTNET_FALSE;
+    }
+
+    const __m128i roll = _mm_shuffle_epi8(rollLookup, _mm_add_epi8(_mm_cmpeq_epi8(*value, slash), highNibbles));
+    *value = _mm_add_epi8(*value, roll);
+
+    return DOTNET_TRUE;
+}
+
+// Packs the 6 bit values back into 3 bytes per group, the last 4 bytes of every lane are left over.
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE __m128i DecodeReshuffle_SSSE3(__m128i value) {
+    const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(value, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE DOTNET_INT Encode_SSSE3(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    DOTNET_INT i = 0, o = 0;
+
+    // 12 bytes are consumed per block but 16 are loaded.
+    for (; i + 16 <= inputLength; i += 12, o += 16) {
+        const __m128i value = _mm_loadu_si128((const __m128i *) (input + i));
+        _mm_storeu_si128((__m128i *) (output + o), EncodeTranslate_SSSE3(EncodeReshuffle_SSSE3(value)));
+    }
+
+    return o + Base64Utility_Encode_Scalar(input + i, inputLength - i, output + o);
+}
+
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE DOTNET_INT Decode_SSSE3(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    DOTNET_INT i = 0, o = 0;
+
+    // Every store writes 4 bytes past its 12, the margin keeps them inside the decoded length. A block with padding or an invalid character is left to the scalar decoder.
+    for (; i + 24 <= inputLength; i += 16, o += 12) {
+        __m128i value = _mm_loadu_si128((const __m128i *) (input + i));
+
+        if (!DecodeTranslate_SSSE3(&value)) {
             break;
         }
 
-        paddingLength++;
+        _mm_storeu_si128((__m128i *) (output + o), DecodeReshuffle_SSSE3(value));
     }
 
-    DOTNET_INT noPaddingLength = 4 * ((inputLength - paddingLength) / 4);
-    DOTNET_INT decodeLength = 0;
+    DOTNET_INT decodeLength = Base64Utility_Decode_Scalar(input + i, inputLength - i, output + o);
 
-    for (DOTNET_INT i = 0; i < noPaddingLength; i += 4) {
-        output[decodeLength++] = (DecodeByte(input[i]) << 2) + (DecodeByte(input[i + 1]) >> 4);
-        output[decodeLength++] = ((DecodeByte(input[i + 1]) & 0x0f) << 4) + (DecodeByte(input[i + 2]) >> 2);
-        output[decodeLength++] = ((DecodeByte(input[i + 2]) & 0x03) << 6) + DecodeByte(input[i + 3]);
+    return decodeLength < 0 ? -1 : o + decodeLength;
+}
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE DOTNET_INT Encode_AVX2(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    const __m256i reshuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0, 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+    DOTNET_INT i = 0, o = 0;
+
+    // Each lane takes 12 of the 24 bytes consumed per block, the second load reads 4 bytes past them.
+    for (; i + 28 <= inputLength; i += 24, o += 32) {
+        __m256i value = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (input + i))), _mm_loadu_si128((const __m128i *) (input + i + 12)), 1);
+        value = _mm256_shuffle_epi8(value, reshuffle);
+
+        const __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(value, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        const __m256i low = _mm256_mullo_epi16(_mm256_and_si256(value, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(high, low);
+
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+
+        _mm256_storeu_si256((__m256i *) (output + o), _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range)));
     }
 
-    switch (paddingLength) {
-        case 1:
-            output[decodeLength++] = (DecodeByte(input[noPaddingLength]) << 2) + (DecodeByte(input[noPaddingLength + 1]) >> 4);
-            output[decodeLength++] = ((DecodeByte(input[noPaddingLength + 1]) & 0x0f) << 4) + (DecodeByte(input[noPaddingLength + 2]) >> 2);
+    // The tail stays scalar, handing it to the SSE encoded kernels costs a state transition per call.
+    return o + Base64Utility_Encode_Scalar(input + i, inputLength - i, output + o);
+}
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE DOTNET_INT Decode_AVX2(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    const __m256i lowLookup = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m256i highLookup = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i rollLookup = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i slash = _mm256_set1_epi8(0x2f);
+
+    DOTNET_INT i = 0, o = 0;
+
+    for (; i + 48 <= inputLength; i += 32, o += 24) {
+        __m256i value = _mm256_loadu_si256((const __m256i *) (input + i));
+
+        const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(value, 4), slash);
+        const __m256i lowNibbles = _mm256_and_si256(value, slash);
+        const __m256i classes = _mm256_and_si256(_mm256_shuffle_epi8(lowLookup, lowNibbles), _mm256_shuffle_epi8(highLookup, highNibbles));
+
+        if (!_mm256_testz_si256(classes, classes)) {
             break;
+        }
 
-        case 2:
-            output[decodeLength++] = (DecodeByte(input[noPaddingLength]) << 2) + (DecodeByte(input[noPaddingLength + 1]) >> 4);
+        value = _mm256_add_epi8(value, _mm256_shuffle_epi8(rollLookup, _mm256_add_epi8(_mm256_cmpeq_epi8(value, slash), highNibbles)));
+
+        __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(value, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        merged = _mm256_shuffle_epi8(merged, pack);
+
+        // Closes the gap between the 12 bytes of each lane.
+        _mm256_storeu_si256((__m256i *) (output + o), _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)));
+    }
+
+    DOTNET_INT decodeLength = Base64Utility_Decode_Scalar(input + i, inputLength - i, output + o);
+
+    return decodeLength < 0 ? -1 : o + decodeLength;
+}
+
+#elif defined(XENO_NATIVE_ARM64)
+
+DOTNET_PRIVATE DOTNET_INT Encode_NEON(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    uint8x16x4_t characters;
+    characters.val[0] = vld1q_u8(Base64Characters);
+    characters.val[1] = vld1q_u8(Base64Characters + 16);
+    characters.val[2] = vld1q_u8(Base64Characters + 32);
+    characters.val[3] = vld1q_u8(Base64Characters + 48);
+
+    const uint8x16_t indexMask = vdupq_n_u8(0x3f);
+
+    DOTNET_INT i = 0, o = 0;
+
+    // The deinterleaving load hands out the first, second and third byte of 16 groups.
+    for (; i + 48 <= inputLength; i += 48, o += 64) {
+        const uint8x16x3_t value = vld3q_u8(input + i);
+        uint8x16x4_t result;
+
+        result.val[0] = vshrq_n_u8(value.val[0], 2);
+        result.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(value.val[0], 4), vshrq_n_u8(value.val[1], 4)), indexMask);
+        result.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(value.val[1], 2), vshrq_n_u8(value.val[2], 6)), indexMask);
+        result.val[3] = vandq_u8(value.val[2], indexMask);
+
+        result.val[0] = vqtbl4q_u8(characters, result.val[0]);
+        result.val[1] = vqtbl4q_u8(characters, result.val[1]);
+        result.val[2] = vqtbl4q_u8(characters, result.val[2]);
+        result.val[3] = vqtbl4q_u8(characters, result.val[3]);
+
+        vst4q_u8(output + o, result);
+    }
+
+    return o + Base64Utility_Encode_Scalar(input + i, inputLength - i, output + o);
+}
+
+DOTNET_PRIVATE DOTNET_INT Decode_NEON(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    uint8x16x4_t lowTable, highTable;
+
+    for (DOTNET_INT i = 0; i < 4; i++) {
+        lowTable.val[i] = vld1q_u8(DecodeTable + 16 * i);
+        highTable.val[i] = vld1q_u8(DecodeTable + 64 + 16 * i);
+    }
+
+    const uint8x16_t highOffset = vdupq_n_u8(64);
+
+    DOTNET_INT i = 0, o = 0;
+
+    // Characters from 64 go through the second table, anything above 127 keeps its top bit and fails like the 0xff entries.
+    for (; i + 64 < inputLength; i += 64, o += 48) {
+        const uint8x16x4_t value = vld4q_u8(input + i);
+        uint8x16x4_t decoded;
+        uint8x16_t invalid = vdupq_n_u8(0);
+
+        for (DOTNET_INT j = 0; j < 4; j++) {
+            decoded.val[j] = vqtbx4q_u8(vqtbl4q_u8(lowTable, value.val[j]), highTable, vsubq_u8(value.val[j], highOffset));
+            invalid = vorrq_u8(invalid, vorrq_u8(decoded.val[j], value.val[j]));
+        }
+
+        if (vmaxvq_u8(invalid) & 0x80) {
             break;
+        }
 
-        default:
+        uint8x16x3_t result;
+        result.val[0] = vorrq_u8(vshlq_n_u8(decoded.val[0], 2), vshrq_n_u8(decoded.val[1], 4));
+        result.val[1] = vorrq_u8(vshlq_n_u8(decoded.val[1], 4), vshrq_n_u8(decoded.val[2], 2));
+        result.val[2] = vorrq_u8(vshlq_n_u8(decoded.val[2], 6), decoded.val[3]);
+
+        vst3q_u8(output + o, result);
+    }
+
+    DOTNET_INT decodeLength = Base64Utility_Decode_Scalar(input + i, inputLength - i, output + o);
+
+    return decodeLength < 0 ? -1 : o + decodeLength;
+}
+
+#endif
+
+typedef DOTNET_INT (*BASE64_CODER)(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output);
+
+typedef struct BASE64_KERNELS {
+    DOTNET_STRING Name;
+    BASE64_CODER Encode;
+    BASE64_CODER Decode;
+} BASE64_KERNELS;
+
+DOTNET_PRIVATE const BASE64_KERNELS ScalarKernels = {"scalar", Base64Utility_Encode_Scalar, Base64Utility_Decode_Scalar};
+
+#if defined(XENO_NATIVE_X86)
+DOTNET_PRIVATE const BASE64_KERNELS Ssse3Kernels = {"ssse3", Encode_SSSE3, Decode_SSSE3};
+DOTNET_PRIVATE const BASE64_KERNELS Avx2Kernels = {"avx2", Encode_AVX2, Decode_AVX2};
+#elif defined(XENO_NATIVE_ARM64)
+DOTNET_PRIVATE const BASE64_KERNELS NeonKernels = {"neon", Encode_NEON, Decode_NEON};
+#endif
+
+DOTNET_PRIVATE const BASE64_KERNELS *Kernels = NULL;
+
+DOTNET_PRIVATE const BASE64_KERNELS *GetKernels() {
+    const BASE64_KERNELS *kernels = __atomic_load_n(&Kernels, __ATOMIC_ACQUIRE);
+
+    if (kernels != NULL) {
+        return kernels;
+    }
+
+    kernels = &ScalarKernels;
+
+#if defined(XENO_NATIVE_X86)
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX2)) {
+        kernels = &Avx2Kernels;
+    } else if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_SSSE3)) {
+        kernels = &Ssse3Kernels;
+    }
+#elif defined(XENO_NATIVE_ARM64)
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_NEON)) {
+        kernels = &NeonKernels;
+    }
+#endif
+
+    __atomic_store_n(&Kernels, kernels, __ATOMIC_RELEASE);
+
+    return kernels;
+}
+
+DOTNET_STRING Base64Utility_GetKernelName() {
+    return GetKernels()->Name;
+}
+
+DOTNET_PUBLIC DOTNET_INT Base64Utility_EncodeLength(DOTNET_INT inputLength) {
+    return 4 * ((inputLength + 3 - 1) / 3);
+}
+
+DOTNET_PUBLIC DOTNET_INT Base64Utility_DecodeLength(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength) {
+    if (input == NULL || inputLength % 4 != 0) {
+        return 0;
+    }
+
+    DOTNET_INT paddingLength = 0;
+
+    for (DOTNET_INT i = inputLength - 1; i >= 0; i--) {
+        if (input[i] != '=') {
             break;
+        }
+
+        paddingLength++;
     }
 
-    return decodeLength;
+    return 3 * (inputLength / 4) - paddingLength;
+}
+
+DOTNET_PUBLIC DOTNET_INT Base64Utility_Encode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    if (input == NULL || inputLength == 0 || output == NULL) {
+        return 0;
+    }
+
+    return GetKernels()->Encode(input, inputLength, output);
+}
+
+DOTNET_PUBLIC DOTNET_INT Base64Utility_Decode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output) {
+    if (input == NULL || inputLength % 4 != 0 || output == NULL) {
+        return -1;
+    }
+
+    return GetKernels()->Decode(input, inputLength, output);
 }
@@ -3,9 +3,15 @@
 
 #include "global.h"
 
+DOTNET_INT Base64Utility_Encode_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output);
+DOTNET_INT Base64Utility_Decode_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output);
+
+DOTNET_STRING Base64Utility_GetKernelName(void);
 DOTNET_INT Base64Utility_EncodeLength(DOTNET_INT inputLength);
 DOTNET_INT Base64Utility_DecodeLength(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength);
 DOTNET_INT Base64Utility_Encode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output);
+
+// Returns -1 as soon as a character outside the alphabet, a misplaced '=' or a length that is not a multiple of 4 is found.
 DOTNET_INT Base64Utility_Decode(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_SPAN_BYTE output);
 
 #endif
@@ -0,0 +1,57 @@
+#include "CompressionUtility.h"
+
+// Every target links lz4 statically, which is what the fast reset entry point asks for.
+#define LZ4_STATIC_LINKING_ONLY
+#include "lz4.h"
+
+#include <pthread.h>
+
+DOTNET_PRIVATE pthread_once_t StreamKeyOnce = PTHREAD_ONCE_INIT;
+DOTNET_PRIVATE pthread_key_t StreamKey;
+DOTNET_PRIVATE DOTNET_BOOL StreamKeyCreated;
+
+DOTNET_PRIVATE void CreateStreamKey(void) {
+    StreamKeyCreated = pthread_key_create(&StreamKey, free) == 0;
+}
+
+// The stream is cleared once when the thread first compresses, LZ4_compress_default clears a fresh one on the stack every call.
+DOTNET_PRIVATE LZ4_stream_t *GetStream(void) {
+    pthread_once(&StreamKeyOnce, CreateStreamKey);
+
+    if (!StreamKeyCreated) {
+        return NULL;
+    }
+
+    LZ4_stream_t *stream = pthread_getspecific(StreamKey);
+
+    if (stream != NULL) {
+        return stream;
+    }
+
+    stream = LZ4_initStream(malloc(sizeof(LZ4_stream_t)), sizeof(LZ4_stream_t));
+
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    if (pthread_setspecific(StreamKey, stream) != 0) {
+        free(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+DOTNET_PUBLIC DOTNET_INT CompressionUtility_Compress_LZ4(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination, DOTNET_INT destinationCapacity) {
+    if (source == NULL || sourceLength < 0 || destination == NULL || destinationCapacity < 0) {
+        return 0;
+    }
+
+    LZ4_stream_t *stream = GetStream();
+
+    if (stream == NULL) {
+        return LZ4_compress_default((const char *) source, (char *) destination, sourceLength, destinationCapacity);
+    }
+
+    return LZ4_compress_fast_extState_fastReset(stream, (const char *) source, (char *) destination, sourceLength, destinationCapacity, 1);
+}
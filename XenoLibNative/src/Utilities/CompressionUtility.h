@@ -0,0 +1,10 @@
+#ifndef COMPRESSIONUTILITY_H
+#define COMPRESSIONUTILITY_H
+
+#include "global.h"
+
+// Same output as LZ4_compress_default, the hash table lives in a stream owned by the calling thread and is only fast reset between calls.
+// Source and destination must not overlap, returns 0 when the destination is too small.
+DOTNET_INT CompressionUtility_Compress_LZ4(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination, DOTNET_INT destinationCapacity);
+
+#endif
@@ -0,0 +1,157 @@
+#include "CpuDispatchUtility.h"
+#include "AesMultiBufferUtility.h"
+#include "Base64Utility.h"
+#include "HexUtility.h"
+#include "KeyDerivationFunctionUtility.h"
+#include "MessageDigestUtility.h"
+#include "RandomNumberGeneratorUtility.h"
+#include "cpuinfo.h"
+
+#include <stdio.h>
+
+typedef struct CPU_DISPATCH_TIER {
+    DOTNET_STRING Name;
+    DOTNET_UINT RequiredFeatures;
+    DOTNET_UINT AllowedFeatures;
+} CPU_DISPATCH_TIER;
+
+#define CPU_DISPATCH_TIER_AESNI_FEATURES (CPU_DISPATCH_FEATURE_SSSE3 | CPU_DISPATCH_FEATURE_SSE41 | CPU_DISPATCH_FEATURE_AES | CPU_DISPATCH_FEATURE_PCLMUL | CPU_DISPATCH_FEATURE_SHA)
+#define CPU_DISPATCH_TIER_AVX2_FEATURES (CPU_DISPATCH_TIER_AESNI_FEATURES | CPU_DISPATCH_FEATURE_AVX2)
+#define CPU_DISPATCH_TIER_AVX512_FEATURES (CPU_DISPATCH_TIER_AVX2_FEATURES | CPU_DISPATCH_FEATURE_AVX512F | CPU_DISPATCH_FEATURE_AVX512BW | CPU_DISPATCH_FEATURE_AVX512VBMI | CPU_DISPATCH_FEATURE_VAES | CPU_DISPATCH_FEATURE_VPCLMUL)
+#define CPU_DISPATCH_TIER_ARMV8_FEATURES (CPU_DISPATCH_FEATURE_NEON | CPU_DISPATCH_FEATURE_ARM_AES | CPU_DISPATCH_FEATURE_ARM_PMULL | CPU_DISPATCH_FEATURE_ARM_SHA2)
+
+// Ordered from the lowest to the highest tier, the reported tier is the last one whose required features are all present.
+DOTNET_PRIVATE const CPU_DISPATCH_TIER Tiers[] = {
+    {"scalar", 0, 0},
+    {"ssse3", CPU_DISPATCH_FEATURE_SSSE3, CPU_DISPATCH_FEATURE_SSSE3},
+    {"aesni", CPU_DISPATCH_FEATURE_SSSE3 | CPU_DISPATCH_FEATURE_SSE41 | CPU_DISPATCH_FEATURE_AES, CPU_DISPATCH_TIER_AESNI_FEATURES},
+    {"avx2", CPU_DISPATCH_FEATURE_SSSE3 | CPU_DISPATCH_FEATURE_SSE41 | CPU_DISPATCH_FEATURE_AES | CPU_DISPATCH_FEATURE_AVX2, CPU_DISPATCH_TIER_AVX2_FEATURES},
+    {"avx512", CPU_DISPATCH_FEATURE_SSSE3 | CPU_DISPATCH_FEATURE_SSE41 | CPU_DISPATCH_FEATURE_AES | CPU_DISPATCH_FEATURE_AVX2 | CPU_DISPATCH_FEATURE_AVX512F | CPU_DISPATCH_FEATURE_AVX512BW, CPU_DISPATCH_TIER_AVX512_FEATURES},
+    {"neon", CPU_DISPATCH_FEATURE_NEON, CPU_DISPATCH_FEATURE_NEON},
+    {"armv8-crypto", CPU_DISPATCH_FEATURE_NEON | CPU_DISPATCH_FEATURE_ARM_AES, CPU_DISPATCH_TIER_ARMV8_FEATURES}};
+
+DOTNET_PRIVATE const DOTNET_STRING PrimitiveNames[CPU_DISPATCH_PRIMITIVE_COUNT] = {"hex", "aes-cbc", "aes-cfb", "sha2-512", "sha3-512", "base64", "random", "pbkdf2-sha1"};
+
+DOTNET_PRIVATE DOTNET_INT Features = -1;
+
+DOTNET_PRIVATE DOTNET_UINT DetectFeatures() {
+    DOTNET_UINT features = 0;
+
+    if (!cpuinfo_initialize()) {
+        return features;
+    }
+
+#if defined(XENO_NATIVE_X86)
+    if (cpuinfo_has_x86_ssse3()) features |= CPU_DISPATCH_FEATURE_SSSE3;
+    if (cpuinfo_has_x86_sse4_1()) features |= CPU_DISPATCH_FEATURE_SSE41;
+    if (cpuinfo_has_x86_aes()) features |= CPU_DISPATCH_FEATURE_AES;
+    if (cpuinfo_has_x86_pclmulqdq()) features |= CPU_DISPATCH_FEATURE_PCLMUL;
+    if (cpuinfo_has_x86_sha()) features |= CPU_DISPATCH_FEATURE_SHA;
+    if (cpuinfo_has_x86_avx2()) features |= CPU_DISPATCH_FEATURE_AVX2;
+    if (cpuinfo_has_x86_avx512f()) features |= CPU_DISPATCH_FEATURE_AVX512F;
+    if (cpuinfo_has_x86_avx512bw()) features |= CPU_DISPATCH_FEATURE_AVX512BW;
+    if (cpuinfo_has_x86_avx512vbmi()) features |= CPU_DISPATCH_FEATURE_AVX512VBMI;
+    if (cpuinfo_has_x86_vaes()) features |= CPU_DISPATCH_FEATURE_VAES;
+    if (cpuinfo_has_x86_vpclmulqdq()) features |= CPU_DISPATCH_FEATURE_VPCLMUL;
+#elif defined(XENO_NATIVE_ARM64)
+    if (cpuinfo_has_arm_neon()) features |= CPU_DISPATCH_FEATURE_NEON;
+    if (cpuinfo_has_arm_aes()) features |= CPU_DISPATCH_FEATURE_ARM_AES;
+    if (cpuinfo_has_arm_pmull()) features |= CPU_DISPATCH_FEATURE_ARM_PMULL;
+    if (cpuinfo_has_arm_sha2()) features |= CPU_DISPATCH_FEATURE_ARM_SHA2;
+#endif
+
+    const char *tierOverride = getenv("XENO_NATIVE_CPU_TIER");
+
+    if (tierOverride != NULL && tierOverride[0] != '\0') {
+        DOTNET_INT i = 0;
+
+        for (; i < (DOTNET_INT) (sizeof(Tiers) / sizeof(Tiers[0])); i++) {
+            if (strcmp(tierOverride, Tiers[i].Name) == 0) {
+                features &= Tiers[i].AllowedFeatures;
+                break;
+            }
+        }
+
+        // A mistyped tier would otherwise compare the detected kernels against themselves without notice.
+        if (i == (DOTNET_INT) (sizeof(Tiers) / sizeof(Tiers[0]))) {
+            fprintf(stderr, "XENO_NATIVE_CPU_TIER=%s is not a known tier (scalar, ssse3, aesni, avx2, avx512, neon, armv8-crypto), using the detected features.\n", tierOverride);
+        }
+    }
+
+    return features;
+}
+
+DOTNET_PUBLIC DOTNET_UINT CpuDispatchUtility_GetFeatures() {
+    DOTNET_INT features = __atomic_load_n(&Features, __ATOMIC_ACQUIRE);
+
+    if (features >= 0) {
+        return (DOTNET_UINT) features;
+    }
+
+    features = (DOTNET_INT) DetectFeatures();
+
+    __atomic_store_n(&Features, features, __ATOMIC_RELEASE);
+
+    return (DOTNET_UINT) features;
+}
+
+DOTNET_PUBLIC DOTNET_BOOL CpuDispatchUtility_HasFeatures(DOTNET_UINT features) {
+    return (CpuDispatchUtility_GetFeatures() & features) == features;
+}
+
+DOTNET_PUBLIC DOTNET_STRING CpuDispatchUtility_GetTierName() {
+    DOTNET_STRING name = Tiers[0].Name;
+
+    for (DOTNET_INT i = 1; i < (DOTNET_INT) (sizeof(Tiers) / sizeof(Tiers[0])); i++) {
+        if (CpuDispatchUtility_HasFeatures(Tiers[i].RequiredFeatures)) {
+            name = Tiers[i].Name;
+        }
+    }
+
+    return name;
+}
+
+DOTNET_PUBLIC DOTNET_INT CpuDispatchUtility_GetPrimitiveCount() {
+    return CPU_DISPATCH_PRIMITIVE_COUNT;
+}
+
+DOTNET_PUBLIC DOTNET_STRING CpuDispatchUtility_GetPrimitiveName(DOTNET_INT primitive) {
+    if (primitive < 0 || primitive >= CPU_DISPATCH_PRIMITIVE_COUNT) {
+        return "";
+    }
+
+    return PrimitiveNames[primitive];
+}
+
+DOTNET_PUBLIC DOTNET_STRING CpuDispatchUtility_GetKernelName(DOTNET_INT primitive) {
+    switch (primitive) {
+        case CPU_DISPATCH_PRIMITIVE_HEX:
+            return HexUtility_GetKernelName();
+
+        case CPU_DISPATCH_PRIMITIVE_AES_CBC:
+            return AesMultiBufferUtility_GetKernelName();
+
+        case CPU_DISPATCH_PRIMITIVE_AES_CFB:
+            // Cfb8 decryption and the iterated cfb128 share encryption share the multi buffer kernels, cfb8 encryption stays on OpenSSL.
+            return AesMultiBufferUtility_GetKernelName();
+
+        case CPU_DISPATCH_PRIMITIVE_SHA2_512:
+            return MessageDigestUtility_GetSha2_512KernelName();
+
+        case CPU_DISPATCH_PRIMITIVE_SHA3_512:
+            // Single messages still go through OpenSSL, only the batch and the iterated rounds use the lanes.
+            return MessageDigestUtility_GetSha3_512KernelName();
+
+        case CPU_DISPATCH_PRIMITIVE_BASE64:
+            return Base64Utility_GetKernelName();
+
+        case CPU_DISPATCH_PRIMITIVE_RANDOM:
+            return RandomNumberGeneratorUtility_GetKernelName();
+
+        case CPU_DISPATCH_PRIMITIVE_PBKDF2_SHA1:
+            return KeyDerivationFunctionUtility_GetPbkdf2Sha1KernelName();
+
+        default:
+            return "";
+    }
+}
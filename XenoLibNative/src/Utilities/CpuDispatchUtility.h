@@ -0,0 +1,40 @@
+#ifndef CPUDISPATCHUTILITY_H
+#define CPUDISPATCHUTILITY_H
+
+#include "global.h"
+
+#define CPU_DISPATCH_FEATURE_SSSE3 0x0001
+#define CPU_DISPATCH_FEATURE_SSE41 0x0002
+#define CPU_DISPATCH_FEATURE_AES 0x0004
+#define CPU_DISPATCH_FEATURE_PCLMUL 0x0008
+#define CPU_DISPATCH_FEATURE_SHA 0x0010
+#define CPU_DISPATCH_FEATURE_AVX2 0x0020
+#define CPU_DISPATCH_FEATURE_AVX512F 0x0040
+#define CPU_DISPATCH_FEATURE_AVX512BW 0x0080
+#define CPU_DISPATCH_FEATURE_AVX512VBMI 0x0100
+#define CPU_DISPATCH_FEATURE_VAES 0x0200
+#define CPU_DISPATCH_FEATURE_VPCLMUL 0x0400
+#define CPU_DISPATCH_FEATURE_NEON 0x1000
+#define CPU_DISPATCH_FEATURE_ARM_AES 0x2000
+#define CPU_DISPATCH_FEATURE_ARM_PMULL 0x4000
+#define CPU_DISPATCH_FEATURE_ARM_SHA2 0x8000
+
+#define CPU_DISPATCH_PRIMITIVE_HEX 0
+#define CPU_DISPATCH_PRIMITIVE_AES_CBC 1
+#define CPU_DISPATCH_PRIMITIVE_AES_CFB 2
+#define CPU_DISPATCH_PRIMITIVE_SHA2_512 3
+#define CPU_DISPATCH_PRIMITIVE_SHA3_512 4
+#define CPU_DISPATCH_PRIMITIVE_BASE64 5
+#define CPU_DISPATCH_PRIMITIVE_RANDOM 6
+#define CPU_DISPATCH_PRIMITIVE_PBKDF2_SHA1 7
+#define CPU_DISPATCH_PRIMITIVE_COUNT 8
+
+// Features are detected once, XENO_NATIVE_CPU_TIER (scalar, ssse3, aesni, avx2, avx512, neon, armv8-crypto) caps them for comparisons.
+DOTNET_UINT CpuDispatchUtility_GetFeatures(void);
+DOTNET_BOOL CpuDispatchUtility_HasFeatures(DOTNET_UINT features);
+DOTNET_STRING CpuDispatchUtility_GetTierName(void);
+DOTNET_INT CpuDispatchUtility_GetPrimitiveCount(void);
+DOTNET_STRING CpuDispatchUtility_GetPrimitiveName(DOTNET_INT primitive);
+DOTNET_STRING CpuDispatchUtility_GetKernelName(DOTNET_INT primitive);
+
+#endif
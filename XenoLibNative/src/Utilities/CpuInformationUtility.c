@@ -50,3 +50,167 @@ DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetProcessorCoreCount() {
 
     return cpuinfo_get_cores_count();
 }
+
+DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetProcessorCount() {
+    if (!cpuinfo_initialize()) {
+        return 0;
+    }
+
+    return cpuinfo_get_processors_count();
+}
+
+DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetProcessorClusterCount() {
+    if (!cpuinfo_initialize()) {
+        return 0;
+    }
+
+    return cpuinfo_get_clusters_count();
+}
+
+DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetProcessorPackageCount() {
+    if (!cpuinfo_initialize()) {
+        return 0;
+    }
+
+    return cpuinfo_get_packages_count();
+}
+
+DOTNET_PRIVATE DOTNET_INT GetSystemProcessorId(const struct cpuinfo_processor *processor) {
+#if defined(__linux__)
+    return processor->linux_id;
+#elif defined(_WIN32)
+    return processor->windows_group_id * 64 + processor->windows_processor_id;
+#else
+    return (DOTNET_INT) (processor - cpuinfo_get_processors());
+#endif
+}
+
+DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetProcessorTopology(CPU_PROCESSOR_TOPOLOGY *output, DOTNET_INT outputLength) {
+    if (!cpuinfo_initialize()) {
+        return -1;
+    }
+
+    DOTNET_INT processorsCount = cpuinfo_get_processors_count();
+
+    if (output == NULL || outputLength < processorsCount) {
+        return -1;
+    }
+
+    for (DOTNET_INT i = 0; i < processorsCount; i++) {
+        const struct cpuinfo_processor *processor = cpuinfo_get_processor(i);
+
+        output[i].SystemProcessorId = GetSystemProcessorId(processor);
+        output[i].SmtId = processor->smt_id;
+        output[i].CoreIndex = (DOTNET_INT) (processor->core - cpuinfo_get_cores());
+        output[i].ClusterIndex = (DOTNET_INT) (processor->cluster - cpuinfo_get_clusters());
+        output[i].PackageIndex = (DOTNET_INT) (processor->package - cpuinfo_get_packages());
+        output[i].L2CacheIndex = processor->cache.l2 == NULL ? -1 : (DOTNET_INT) (processor->cache.l2 - cpuinfo_get_l2_caches());
+        output[i].L3CacheIndex = processor->cache.l3 == NULL ? -1 : (DOTNET_INT) (processor->cache.l3 - cpuinfo_get_l3_caches());
+    }
+
+    return processorsCount;
+}
+
+DOTNET_PRIVATE DOTNET_INT GetCacheTopology(const struct cpuinfo_cache *caches, DOTNET_INT cachesCount, CPU_CACHE_TOPOLOGY *output, DOTNET_INT outputLength) {
+    if (output == NULL || outputLength < cachesCount) {
+        return -1;
+    }
+
+    for (DOTNET_INT i = 0; i < cachesCount; i++) {
+        output[i].Size = caches[i].size;
+        output[i].ProcessorStart = caches[i].processor_start;
+        output[i].ProcessorCount = caches[i].processor_count;
+    }
+
+    return cachesCount;
+}
+
+DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetL2CacheTopology(CPU_CACHE_TOPOLOGY *output, DOTNET_INT outputLength) {
+    if (!cpuinfo_initialize()) {
+        return -1;
+    }
+
+    return GetCacheTopology(cpuinfo_get_l2_caches(), cpuinfo_get_l2_caches_count(), output, outputLength);
+}
+
+DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetL3CacheTopology(CPU_CACHE_TOPOLOGY *output, DOTNET_INT outputLength) {
+    if (!cpuinfo_initialize()) {
+        return -1;
+    }
+
+    return GetCacheTopology(cpuinfo_get_l3_caches(), cpuinfo_get_l3_caches_count(), output, outputLength);
+}
+
+typedef struct CPU_PLACEMENT_ORDER {
+    DOTNET_INT SmtId;
+    DOTNET_INT CoreRank; // Position of the core inside its last level cache domain.
+    DOTNET_INT Domain;
+    DOTNET_INT ProcessorIndex;
+} CPU_PLACEMENT_ORDER;
+
+DOTNET_PRIVATE int ComparePlacementOrder(const void *left, const void *right) {
+    const CPU_PLACEMENT_ORDER *a = left;
+    const CPU_PLACEMENT_ORDER *b = right;
+
+    if (a->SmtId != b->SmtId) return a->SmtId < b->SmtId ? -1 : 1;
+    if (a->CoreRank != b->CoreRank) return a->CoreRank < b->CoreRank ? -1 : 1;
+    if (a->Domain != b->Domain) return a->Domain < b->Domain ? -1 : 1;
+    return a->ProcessorIndex < b->ProcessorIndex ? -1 : a->ProcessorIndex > b->ProcessorIndex;
+}
+
+DOTNET_PUBLIC DOTNET_INT CpuInformationUtility_GetThreadPlacement(DOTNET_INT threadCount, DOTNET_SPAN_INT systemProcessorIds) {
+    if (threadCount <= 0 || systemProcessorIds == NULL || !cpuinfo_initialize()) {
+        return -1;
+    }
+
+    DOTNET_INT processorsCount = cpuinfo_get_processors_count();
+    DOTNET_INT coresCount = cpuinfo_get_cores_count();
+    DOTNET_INT l3CachesCount = cpuinfo_get_l3_caches_count();
+    DOTNET_INT domainsCount = l3CachesCount + cpuinfo_get_packages_count();
+
+    if (processorsCount == 0) {
+        return -1;
+    }
+
+    CPU_PLACEMENT_ORDER *order = malloc(sizeof(CPU_PLACEMENT_ORDER) * processorsCount);
+    DOTNET_INT *coreRanks = malloc(sizeof(DOTNET_INT) * coresCount);
+    DOTNET_INT *domainCoresCount = calloc(domainsCount, sizeof(DOTNET_INT));
+
+    if (order == NULL || coreRanks == NULL || domainCoresCount == NULL) {
+        free(order);
+        free(coreRanks);
+        free(domainCoresCount);
+        return -1;
+    }
+
+    // Cores are grouped by the last level cache they share, falling back to the package when there is no L3.
+    for (DOTNET_INT i = 0; i < coresCount; i++) {
+        const struct cpuinfo_processor *processor = cpuinfo_get_processor(cpuinfo_get_core(i)->processor_start);
+        DOTNET_INT domain = processor->cache.l3 != NULL ? (DOTNET_INT) (processor->cache.l3 - cpuinfo_get_l3_caches()) : l3CachesCount + (DOTNET_INT) (processor->package - cpuinfo_get_packages());
+
+        coreRanks[i] = domainCoresCount[domain]++;
+    }
+
+    for (DOTNET_INT i = 0; i < processorsCount; i++) {
+        const struct cpuinfo_processor *processor = cpuinfo_get_processor(i);
+        DOTNET_INT coreIndex = (DOTNET_INT) (processor->core - cpuinfo_get_cores());
+
+        order[i].SmtId = processor->smt_id;
+        order[i].CoreRank = coreRanks[coreIndex];
+        order[i].Domain = processor->cache.l3 != NULL ? (DOTNET_INT) (processor->cache.l3 - cpuinfo_get_l3_caches()) : l3CachesCount + (DOTNET_INT) (processor->package - cpuinfo_get_packages());
+        order[i].ProcessorIndex = i;
+    }
+
+    // One thread per physical core first, taking one core from every L3 domain in turn, then the SMT siblings in the same order.
+    qsort(order, processorsCount, sizeof(CPU_PLACEMENT_ORDER), ComparePlacementOrder);
+
+    for (DOTNET_INT i = 0; i < threadCount; i++) {
+        systemProcessorIds[i] = GetSystemProcessorId(cpuinfo_get_processor(order[i % processorsCount].ProcessorIndex));
+    }
+
+    free(order);
+    free(coreRanks);
+    free(domainCoresCount);
+
+    return threadCount;
+}
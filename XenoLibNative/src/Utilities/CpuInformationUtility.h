@@ -3,9 +3,33 @@
 
 #include "global.h"
 
+typedef struct CPU_PROCESSOR_TOPOLOGY {
+    DOTNET_INT SystemProcessorId; // Bit index used by the operating system affinity mask.
+    DOTNET_INT SmtId;
+    DOTNET_INT CoreIndex;
+    DOTNET_INT ClusterIndex;
+    DOTNET_INT PackageIndex;
+    DOTNET_INT L2CacheIndex; // -1 when the processor has no such cache.
+    DOTNET_INT L3CacheIndex;
+} CPU_PROCESSOR_TOPOLOGY;
+
+typedef struct CPU_CACHE_TOPOLOGY {
+    DOTNET_INT Size;
+    DOTNET_INT ProcessorStart; // Processors sharing the cache, as indices into the processor topology.
+    DOTNET_INT ProcessorCount;
+} CPU_CACHE_TOPOLOGY;
+
 DOTNET_STRING CpuInformationUtility_GetProcessorName(void);
 DOTNET_INT CpuInformationUtility_GetProcessorL2Cache(void);
 DOTNET_INT CpuInformationUtility_GetProcessorL3Cache(void);
 DOTNET_INT CpuInformationUtility_GetProcessorCoreCount(void);
 
+DOTNET_INT CpuInformationUtility_GetProcessorCount(void);
+DOTNET_INT CpuInformationUtility_GetProcessorClusterCount(void);
+DOTNET_INT CpuInformationUtility_GetProcessorPackageCount(void);
+DOTNET_INT CpuInformationUtility_GetProcessorTopology(CPU_PROCESSOR_TOPOLOGY *output, DOTNET_INT outputLength);
+DOTNET_INT CpuInformationUtility_GetL2CacheTopology(CPU_CACHE_TOPOLOGY *output, DOTNET_INT outputLength);
+DOTNET_INT CpuInformationUtility_GetL3CacheTopology(CPU_CACHE_TOPOLOGY *output, DOTNET_INT outputLength);
+DOTNET_INT CpuInformationUtility_GetThreadPlacement(DOTNET_INT threadCount, DOTNET_SPAN_INT systemProcessorIds);
+
 #endif
@@ -0,0 +1,249 @@
+#include "CryptographyUtility.h"
+
+#include <ctype.h>
+#include <pthread.h>
+
+#define CRYPTOGRAPHY_CONTEXT_POOL_SIZE 4
+
+// Pooled contexts keep their provider state, initializing them again with the same cached algorithm skips the reallocation.
+typedef struct CRYPTOGRAPHY_CONTEXT_POOL {
+    EVP_MD_CTX *MessageDigestContexts[CRYPTOGRAPHY_CONTEXT_POOL_SIZE];
+    DOTNET_INT MessageDigestContextCount;
+    EVP_CIPHER_CTX *CipherContexts[CRYPTOGRAPHY_CONTEXT_POOL_SIZE];
+    DOTNET_INT CipherContextCount;
+} CRYPTOGRAPHY_CONTEXT_POOL;
+
+typedef struct CRYPTOGRAPHY_MESSAGE_DIGEST_ALIAS {
+    DOTNET_STRING Name;
+    DOTNET_INT MessageDigest;
+} CRYPTOGRAPHY_MESSAGE_DIGEST_ALIAS;
+
+DOTNET_PRIVATE const DOTNET_STRING MessageDigestNames[CRYPTOGRAPHY_MESSAGE_DIGEST_COUNT] = {"SHA1", "SHA2-256", "SHA2-512", "SHA3-512"};
+DOTNET_PRIVATE const DOTNET_STRING CipherNames[CRYPTOGRAPHY_CIPHER_COUNT] = {"AES-128-CBC", "AES-192-CBC", "AES-256-CBC", "AES-256-CFB8", "AES-256-CFB"};
+
+DOTNET_PRIVATE const CRYPTOGRAPHY_MESSAGE_DIGEST_ALIAS MessageDigestAliases[] = {
+    {"SHA1", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA1},
+    {"SHA-1", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA1},
+    {"SHA256", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_256},
+    {"SHA-256", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_256},
+    {"SHA2-256", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_256},
+    {"SHA512", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_512},
+    {"SHA-512", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_512},
+    {"SHA2-512", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_512},
+    {"SHA3-512", CRYPTOGRAPHY_MESSAGE_DIGEST_SHA3_512}};
+
+DOTNET_PRIVATE EVP_MD *MessageDigests[CRYPTOGRAPHY_MESSAGE_DIGEST_COUNT];
+DOTNET_PRIVATE EVP_CIPHER *Ciphers[CRYPTOGRAPHY_CIPHER_COUNT];
+
+DOTNET_PRIVATE pthread_once_t ContextPoolKeyOnce = PTHREAD_ONCE_INIT;
+DOTNET_PRIVATE pthread_key_t ContextPoolKey;
+DOTNET_PRIVATE DOTNET_BOOL ContextPoolKeyCreated;
+
+DOTNET_PRIVATE void FreeContextPool(void *value) {
+    CRYPTOGRAPHY_CONTEXT_POOL *pool = value;
+
+    for (DOTNET_INT i = 0; i < pool->MessageDigestContextCount; i++) {
+        EVP_MD_CTX_free(pool->MessageDigestContexts[i]);
+    }
+
+    for (DOTNET_INT i = 0; i < pool->CipherContextCount; i++) {
+        EVP_CIPHER_CTX_free(pool->CipherContexts[i]);
+    }
+
+    free(pool);
+}
+
+DOTNET_PRIVATE void CreateContextPoolKey(void) {
+    ContextPoolKeyCreated = pthread_key_create(&ContextPoolKey, FreeContextPool) == 0;
+}
+
+DOTNET_PRIVATE CRYPTOGRAPHY_CONTEXT_POOL *GetContextPool(void) {
+    pthread_once(&ContextPoolKeyOnce, CreateContextPoolKey);
+
+    if (!ContextPoolKeyCreated) {
+        return NULL;
+    }
+
+    CRYPTOGRAPHY_CONTEXT_POOL *pool = pthread_getspecific(ContextPoolKey);
+
+    if (pool != NULL) {
+        return pool;
+    }
+
+    pool = calloc(1, sizeof(CRYPTOGRAPHY_CONTEXT_POOL));
+
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    if (pthread_setspecific(ContextPoolKey, pool) != 0) {
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+DOTNET_PRIVATE DOTNET_BOOL NameEquals(DOTNET_STRING left, DOTNET_STRING right) {
+    while (*left != '\0' && toupper((unsigned char) *left) == toupper((unsigned char) *right)) {
+        left++;
+        right++;
+    }
+
+    return *left == *right;
+}
+
+DOTNET_PUBLIC DOTNET_BOOL CryptographyUtility_Initialize() {
+    for (DOTNET_INT i = 0; i < CRYPTOGRAPHY_MESSAGE_DIGEST_COUNT; i++) {
+        if (CryptographyUtility_GetMessageDigest(i) == NULL) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    for (DOTNET_INT i = 0; i < CRYPTOGRAPHY_CIPHER_COUNT; i++) {
+        if (CryptographyUtility_GetCipher(i) == NULL) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    return GetContextPool() != NULL;
+}
+
+DOTNET_PUBLIC void CryptographyUtility_Shutdown() {
+    // Contexts still pooled by other threads hold their own references and are freed when those threads exit.
+    if (ContextPoolKeyCreated) {
+        CRYPTOGRAPHY_CONTEXT_POOL *pool = pthread_getspecific(ContextPoolKey);
+
+        if (pool != NULL) {
+            pthread_setspecific(ContextPoolKey, NULL);
+            FreeContextPool(pool);
+        }
+    }
+
+    for (DOTNET_INT i = 0; i < CRYPTOGRAPHY_MESSAGE_DIGEST_COUNT; i++) {
+        EVP_MD_free(__atomic_exchange_n(&MessageDigests[i], NULL, __ATOMIC_ACQ_REL));
+    }
+
+    for (DOTNET_INT i = 0; i < CRYPTOGRAPHY_CIPHER_COUNT; i++) {
+        EVP_CIPHER_free(__atomic_exchange_n(&Ciphers[i], NULL, __ATOMIC_ACQ_REL));
+    }
+}
+
+const EVP_MD *CryptographyUtility_GetMessageDigest(DOTNET_INT messageDigest) {
+    if (messageDigest < 0 || messageDigest >= CRYPTOGRAPHY_MESSAGE_DIGEST_COUNT) {
+        return NULL;
+    }
+
+    EVP_MD *cached = __atomic_load_n(&MessageDigests[messageDigest], __ATOMIC_ACQUIRE);
+
+    if (cached != NULL) {
+        return cached;
+    }
+
+    EVP_MD *fetched = EVP_MD_fetch(NULL, MessageDigestNames[messageDigest], NULL);
+
+    if (fetched == NULL) {
+        return NULL;
+    }
+
+    // Threads racing on the first use keep whichever fetch was published first.
+    if (!__atomic_compare_exchange_n(&MessageDigests[messageDigest], &cached, fetched, DOTNET_FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        EVP_MD_free(fetched);
+        return cached;
+    }
+
+    return fetched;
+}
+
+const EVP_CIPHER *CryptographyUtility_GetCipher(DOTNET_INT cipher) {
+    if (cipher < 0 || cipher >= CRYPTOGRAPHY_CIPHER_COUNT) {
+        return NULL;
+    }
+
+    EVP_CIPHER *cached = __atomic_load_n(&Ciphers[cipher], __ATOMIC_ACQUIRE);
+
+    if (cached != NULL) {
+        return cached;
+    }
+
+    EVP_CIPHER *fetched = EVP_CIPHER_fetch(NULL, CipherNames[cipher], NULL);
+
+    if (fetched == NULL) {
+        return NULL;
+    }
+
+    if (!__atomic_compare_exchange_n(&Ciphers[cipher], &cached, fetched, DOTNET_FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        EVP_CIPHER_free(fetched);
+        return cached;
+    }
+
+    return fetched;
+}
+
+EVP_MD *CryptographyUtility_FetchMessageDigest(DOTNET_STRING name) {
+    for (size_t i = 0; i < sizeof(MessageDigestAliases) / sizeof(MessageDigestAliases[0]); i++) {
+        if (!NameEquals(MessageDigestAliases[i].Name, name)) {
+            continue;
+        }
+
+        EVP_MD *messageDigest = (EVP_MD *) CryptographyUtility_GetMessageDigest(MessageDigestAliases[i].MessageDigest);
+
+        if (messageDigest != NULL && EVP_MD_up_ref(messageDigest)) {
+            return messageDigest;
+        }
+
+        break;
+    }
+
+    return EVP_MD_fetch(NULL, name, NULL);
+}
+
+EVP_MD_CTX *CryptographyUtility_RentMessageDigestContext() {
+    CRYPTOGRAPHY_CONTEXT_POOL *pool = GetContextPool();
+
+    if (pool != NULL && pool->MessageDigestContextCount > 0) {
+        return pool->MessageDigestContexts[--pool->MessageDigestContextCount];
+    }
+
+    return EVP_MD_CTX_new();
+}
+
+void CryptographyUtility_ReturnMessageDigestContext(EVP_MD_CTX *context) {
+    if (context == NULL) {
+        return;
+    }
+
+    CRYPTOGRAPHY_CONTEXT_POOL *pool = GetContextPool();
+
+    if (pool != NULL && pool->MessageDigestContextCount < CRYPTOGRAPHY_CONTEXT_POOL_SIZE) {
+        pool->MessageDigestContexts[pool->MessageDigestContextCount++] = context;
+        return;
+    }
+
+    EVP_MD_CTX_free(context);
+}
+
+EVP_CIPHER_CTX *CryptographyUtility_RentCipherContext() {
+    CRYPTOGRAPHY_CONTEXT_POOL *pool = GetContextPool();
+
+    if (pool != NULL && pool->CipherContextCount > 0) {
+        return pool->CipherContexts[--pool->CipherContextCount];
+    }
+
+    return EVP_CIPHER_CTX_new();
+}
+
+void CryptographyUtility_ReturnCipherContext(EVP_CIPHER_CTX *context) {
+    if (context == NULL) {
+        return;
+    }
+
+    CRYPTOGRAPHY_CONTEXT_POOL *pool = GetContextPool();
+
+    if (pool != NULL && pool->CipherContextCount < CRYPTOGRAPHY_CONTEXT_POOL_SIZE) {
+        pool->CipherContexts[pool->CipherContextCount++] = context;
+        return;
+    }
+
+    EVP_CIPHER_CTX_free(context);
+}
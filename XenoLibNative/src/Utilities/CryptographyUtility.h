@@ -0,0 +1,36 @@
+#ifndef CRYPTOGRAPHYUTILITY_H
+#define CRYPTOGRAPHYUTILITY_H
+
+#include "global.h"
+#include "openssl/evp.h"
+
+#define CRYPTOGRAPHY_MESSAGE_DIGEST_SHA1 0
+#define CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_256 1
+#define CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_512 2
+#define CRYPTOGRAPHY_MESSAGE_DIGEST_SHA3_512 3
+#define CRYPTOGRAPHY_MESSAGE_DIGEST_COUNT 4
+
+#define CRYPTOGRAPHY_CIPHER_AES_128_CBC 0
+#define CRYPTOGRAPHY_CIPHER_AES_192_CBC 1
+#define CRYPTOGRAPHY_CIPHER_AES_256_CBC 2
+#define CRYPTOGRAPHY_CIPHER_AES_256_CFB8 3
+#define CRYPTOGRAPHY_CIPHER_AES_256_CFB128 4
+#define CRYPTOGRAPHY_CIPHER_COUNT 5
+
+// Fetches every algorithm up front, without it each one is fetched on first use. Shutdown must not race any other native call.
+DOTNET_BOOL CryptographyUtility_Initialize(void);
+void CryptographyUtility_Shutdown(void);
+
+const EVP_MD *CryptographyUtility_GetMessageDigest(DOTNET_INT messageDigest);
+const EVP_CIPHER *CryptographyUtility_GetCipher(DOTNET_INT cipher);
+
+// Returns a reference the caller releases with EVP_MD_free, known names come from the cache instead of the providers.
+EVP_MD *CryptographyUtility_FetchMessageDigest(DOTNET_STRING name);
+
+// Contexts come from a pool owned by the calling thread and have to be returned on that same thread.
+EVP_MD_CTX *CryptographyUtility_RentMessageDigestContext(void);
+void CryptographyUtility_ReturnMessageDigestContext(EVP_MD_CTX *context);
+EVP_CIPHER_CTX *CryptographyUtility_RentCipherContext(void);
+void CryptographyUtility_ReturnCipherContext(EVP_CIPHER_CTX *context);
+
+#endif
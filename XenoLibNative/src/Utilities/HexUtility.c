@@ -0,0 +1,317 @@
+#include "HexUtility.h"
+#include "CpuDispatchUtility.h"
+
+#if defined(XENO_NATIVE_X86)
+#include <immintrin.h>
+#elif defined(XENO_NATIVE_ARM64)
+#include <arm_neon.h>
+#endif
+
+DOTNET_PRIVATE const DOTNET_BYTE UpperHexCharacters[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+// Output byte j of the dash format belongs to input byte j / 3: the high nibble, the low nibble, then the dash.
+// The shuffles below pick the high and low characters for each of the three 16 byte output registers, 0x80 yields zero.
+DOTNET_PRIVATE const DOTNET_BYTE DashHighShuffle[3][16] = {
+    {0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x05},
+    {0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x0A, 0x80},
+    {0x80, 0x0B, 0x80, 0x80, 0x0C, 0x80, 0x80, 0x0D, 0x80, 0x80, 0x0E, 0x80, 0x80, 0x0F, 0x80, 0x80}};
+
+DOTNET_PRIVATE const DOTNET_BYTE DashLowShuffle[3][16] = {
+    {0x80, 0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80},
+    {0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x0A},
+    {0x80, 0x80, 0x0B, 0x80, 0x80, 0x0C, 0x80, 0x80, 0x0D, 0x80, 0x80, 0x0E, 0x80, 0x80, 0x0F, 0x80}};
+
+DOTNET_PRIVATE const DOTNET_BYTE DashPattern[3][16] = {
+    {0, 0, '-', 0, 0, '-', 0, 0, '-', 0, 0, '-', 0, 0, '-', 0},
+    {0, '-', 0, 0, '-', 0, 0, '-', 0, 0, '-', 0, 0, '-', 0, 0},
+    {'-', 0, 0, '-', 0, 0, '-', 0, 0, '-', 0, 0, '-', 0, 0, '-'}};
+
+void HexUtility_ToUpperHex_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    for (DOTNET_INT i = 0; i < inputLength; i++) {
+        DOTNET_INT index = 2 * i;
+
+        output[index] = UpperHexCharacters[input[i] >> 4];
+        output[index + 1] = UpperHexCharacters[input[i] & 15];
+
+        if (keyStream != NULL) {
+            output[index] ^= keyStream[index];
+            output[index + 1] ^= keyStream[index + 1];
+        }
+    }
+}
+
+void HexUtility_ToUpperHexWithDash_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    for (DOTNET_INT i = 0; i < inputLength; i++) {
+        DOTNET_INT index = 3 * i;
+
+        output[index] = UpperHexCharacters[input[i] >> 4];
+        output[index + 1] = UpperHexCharacters[input[i] & 15];
+        output[index + 2] = '-';
+
+        if (keyStream != NULL) {
+            output[index] ^= keyStream[index];
+            output[index + 1] ^= keyStream[index + 1];
+            output[index + 2] ^= keyStream[index + 2];
+        }
+    }
+}
+
+#if defined(XENO_NATIVE_X86)
+
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE void ToUpperHex_SSSE3(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    const __m128i characters = _mm_loadu_si128((const __m128i *) UpperHexCharacters);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    DOTNET_INT i = 0;
+
+    for (; i + 16 <= inputLength; i += 16) {
+        __m128i value = _mm_loadu_si128((const __m128i *) (input + i));
+        __m128i high = _mm_shuffle_epi8(characters, _mm_and_si128(_mm_srli_epi16(value, 4), nibbleMask));
+        __m128i low = _mm_shuffle_epi8(characters, _mm_and_si128(value, nibbleMask));
+
+        __m128i first = _mm_unpacklo_epi8(high, low);
+        __m128i second = _mm_unpackhi_epi8(high, low);
+
+        if (keyStream != NULL) {
+            first = _mm_xor_si128(first, _mm_loadu_si128((const __m128i *) (keyStream + i * 2)));
+            second = _mm_xor_si128(second, _mm_loadu_si128((const __m128i *) (keyStream + i * 2 + 16)));
+        }
+
+        _mm_storeu_si128((__m128i *) (output + i * 2), first);
+        _mm_storeu_si128((__m128i *) (output + i * 2 + 16), second);
+    }
+
+    HexUtility_ToUpperHex_Scalar(input + i, inputLength - i, keyStream != NULL ? keyStream + i * 2 : NULL, output + i * 2);
+}
+
+XENO_NATIVE_TARGET("ssse3")
+DOTNET_PRIVATE void ToUpperHexWithDash_SSSE3(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    const __m128i characters = _mm_loadu_si128((const __m128i *) UpperHexCharacters);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    DOTNET_INT i = 0;
+
+    for (; i + 16 <= inputLength; i += 16) {
+        __m128i value = _mm_loadu_si128((const __m128i *) (input + i));
+        __m128i high = _mm_shuffle_epi8(characters, _mm_and_si128(_mm_srli_epi16(value, 4), nibbleMask));
+        __m128i low = _mm_shuffle_epi8(characters, _mm_and_si128(value, nibbleMask));
+
+        for (DOTNET_INT k = 0; k < 3; k++) {
+            __m128i result = _mm_or_si128(_mm_shuffle_epi8(high, _mm_loadu_si128((const __m128i *) DashHighShuffle[k])), _mm_shuffle_epi8(low, _mm_loadu_si128((const __m128i *) DashLowShuffle[k])));
+            result = _mm_or_si128(result, _mm_loadu_si128((const __m128i *) DashPattern[k]));
+
+            if (keyStream != NULL) {
+                result = _mm_xor_si128(result, _mm_loadu_si128((const __m128i *) (keyStream + i * 3 + k * 16)));
+            }
+
+            _mm_storeu_si128((__m128i *) (output + i * 3 + k * 16), result);
+        }
+    }
+
+    HexUtility_ToUpperHexWithDash_Scalar(input + i, inputLength - i, keyStream != NULL ? keyStream + i * 3 : NULL, output + i * 3);
+}
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE void ToUpperHex_AVX2(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    const __m256i characters = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) UpperHexCharacters));
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+    DOTNET_INT i = 0;
+
+    for (; i + 32 <= inputLength; i += 32) {
+        __m256i value = _mm256_loadu_si256((const __m256i *) (input + i));
+        __m256i high = _mm256_shuffle_epi8(characters, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibbleMask));
+        __m256i low = _mm256_shuffle_epi8(characters, _mm256_and_si256(value, nibbleMask));
+
+        // The unpacks work within each 128-bit half, the permutes put the four 16 byte pieces back in order.
+        __m256i interleavedLow = _mm256_unpacklo_epi8(high, low);
+        __m256i interleavedHigh = _mm256_unpackhi_epi8(high, low);
+
+        __m256i first = _mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x20);
+        __m256i second = _mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x31);
+
+        if (keyStream != NULL) {
+            first = _mm256_xor_si256(first, _mm256_loadu_si256((const __m256i *) (keyStream + i * 2)));
+            second = _mm256_xor_si256(second, _mm256_loadu_si256((const __m256i *) (keyStream + i * 2 + 32)));
+        }
+
+        _mm256_storeu_si256((__m256i *) (output + i * 2), first);
+        _mm256_storeu_si256((__m256i *) (output + i * 2 + 32), second);
+    }
+
+    // Leave the upper halves clean before handing the tail to the legacy encoded SSSE3 code.
+    _mm256_zeroupper();
+
+    ToUpperHex_SSSE3(input + i, inputLength - i, keyStream != NULL ? keyStream + i * 2 : NULL, output + i * 2);
+}
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE __m256i LoadDashShuffle_AVX2(const DOTNET_BYTE (*shuffle)[16], DOTNET_INT low, DOTNET_INT high) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) shuffle[low])), _mm_loadu_si128((const __m128i *) shuffle[high]), 1);
+}
+
+XENO_NATIVE_TARGET("avx2")
+inline DOTNET_PRIVATE void StoreDashPiece_AVX2(__m256i high, __m256i low, __m256i highShuffle, __m256i lowShuffle, __m256i pattern, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    __m256i result = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(high, highShuffle), _mm256_shuffle_epi8(low, lowShuffle)), pattern);
+
+    if (keyStream != NULL) {
+        result = _mm256_xor_si256(result, _mm256_loadu_si256((const __m256i *) keyStream));
+    }
+
+    _mm256_storeu_si256((__m256i *) output, result);
+}
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE void ToUpperHexWithDash_AVX2(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    const __m256i characters = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) UpperHexCharacters));
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+    // 32 input bytes become six 16 byte output pieces, the first three come from input bytes 0-15 and the last three from 16-31.
+    // Each output register pairs two pieces, so its halves use the shuffles of those pieces on the matching input half.
+    const __m256i highShuffle0 = LoadDashShuffle_AVX2(DashHighShuffle, 0, 1);
+    const __m256i highShuffle1 = LoadDashShuffle_AVX2(DashHighShuffle, 2, 0);
+    const __m256i highShuffle2 = LoadDashShuffle_AVX2(DashHighShuffle, 1, 2);
+    const __m256i lowShuffle0 = LoadDashShuffle_AVX2(DashLowShuffle, 0, 1);
+    const __m256i lowShuffle1 = LoadDashShuffle_AVX2(DashLowShuffle, 2, 0);
+    const __m256i lowShuffle2 = LoadDashShuffle_AVX2(DashLowShuffle, 1, 2);
+    const __m256i pattern0 = LoadDashShuffle_AVX2(DashPattern, 0, 1);
+    const __m256i pattern1 = LoadDashShuffle_AVX2(DashPattern, 2, 0);
+    const __m256i pattern2 = LoadDashShuffle_AVX2(DashPattern, 1, 2);
+
+    DOTNET_INT i = 0;
+
+    for (; i + 32 <= inputLength; i += 32) {
+        __m256i value = _mm256_loadu_si256((const __m256i *) (input + i));
+        __m256i high = _mm256_shuffle_epi8(characters, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibbleMask));
+        __m256i low = _mm256_shuffle_epi8(characters, _mm256_and_si256(value, nibbleMask));
+
+        DOTNET_READ_ONLY_SPAN_BYTE pieceKeyStream = keyStream != NULL ? keyStream + i * 3 : NULL;
+
+        // Input halves for each output register: (first, first), (first, second), (second, second).
+        StoreDashPiece_AVX2(_mm256_permute4x64_epi64(high, 0x44), _mm256_permute4x64_epi64(low, 0x44), highShuffle0, lowShuffle0, pattern0, pieceKeyStream, output + i * 3);
+        StoreDashPiece_AVX2(high, low, highShuffle1, lowShuffle1, pattern1, pieceKeyStream != NULL ? pieceKeyStream + 32 : NULL, output + i * 3 + 32);
+        StoreDashPiece_AVX2(_mm256_permute4x64_epi64(high, 0xEE), _mm256_permute4x64_epi64(low, 0xEE), highShuffle2, lowShuffle2, pattern2, pieceKeyStream != NULL ? pieceKeyStream + 64 : NULL, output + i * 3 + 64);
+    }
+
+    _mm256_zeroupper();
+
+    ToUpperHexWithDash_SSSE3(input + i, inputLength - i, keyStream != NULL ? keyStream + i * 3 : NULL, output + i * 3);
+}
+
+#elif defined(XENO_NATIVE_ARM64)
+
+DOTNET_PRIVATE void ToUpperHex_NEON(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    const uint8x16_t characters = vld1q_u8(UpperHexCharacters);
+    const uint8x16_t nibbleMask = vdupq_n_u8(0x0F);
+
+    DOTNET_INT i = 0;
+
+    for (; i + 16 <= inputLength; i += 16) {
+        uint8x16_t value = vld1q_u8(input + i);
+        uint8x16x2_t result;
+
+        result.val[0] = vqtbl1q_u8(characters, vshrq_n_u8(value, 4));
+        result.val[1] = vqtbl1q_u8(characters, vandq_u8(value, nibbleMask));
+
+        if (keyStream != NULL) {
+            uint8x16x2_t key = vld2q_u8(keyStream + i * 2);
+
+            result.val[0] = veorq_u8(result.val[0], key.val[0]);
+            result.val[1] = veorq_u8(result.val[1], key.val[1]);
+        }
+
+        // The interleaving store writes high, low, high, low...
+        vst2q_u8(output + i * 2, result);
+    }
+
+    HexUtility_ToUpperHex_Scalar(input + i, inputLength - i, keyStream != NULL ? keyStream + i * 2 : NULL, output + i * 2);
+}
+
+DOTNET_PRIVATE void ToUpperHexWithDash_NEON(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    const uint8x16_t characters = vld1q_u8(UpperHexCharacters);
+    const uint8x16_t nibbleMask = vdupq_n_u8(0x0F);
+    const uint8x16_t dash = vdupq_n_u8('-');
+
+    DOTNET_INT i = 0;
+
+    for (; i + 16 <= inputLength; i += 16) {
+        uint8x16_t value = vld1q_u8(input + i);
+        uint8x16x3_t result;
+
+        result.val[0] = vqtbl1q_u8(characters, vshrq_n_u8(value, 4));
+        result.val[1] = vqtbl1q_u8(characters, vandq_u8(value, nibbleMask));
+        result.val[2] = dash;
+
+        if (keyStream != NULL) {
+            uint8x16x3_t key = vld3q_u8(keyStream + i * 3);
+
+            result.val[0] = veorq_u8(result.val[0], key.val[0]);
+            result.val[1] = veorq_u8(result.val[1], key.val[1]);
+            result.val[2] = veorq_u8(result.val[2], key.val[2]);
+        }
+
+        vst3q_u8(output + i * 3, result);
+    }
+
+    HexUtility_ToUpperHexWithDash_Scalar(input + i, inputLength - i, keyStream != NULL ? keyStream + i * 3 : NULL, output + i * 3);
+}
+
+#endif
+
+typedef void (*HEX_ENCODER)(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output);
+
+typedef struct HEX_ENCODER_KERNELS {
+    DOTNET_STRING Name;
+    HEX_ENCODER ToUpperHex;
+    HEX_ENCODER ToUpperHexWithDash;
+} HEX_ENCODER_KERNELS;
+
+DOTNET_PRIVATE const HEX_ENCODER_KERNELS ScalarKernels = {"scalar", HexUtility_ToUpperHex_Scalar, HexUtility_ToUpperHexWithDash_Scalar};
+
+#if defined(XENO_NATIVE_X86)
+DOTNET_PRIVATE const HEX_ENCODER_KERNELS Ssse3Kernels = {"ssse3", ToUpperHex_SSSE3, ToUpperHexWithDash_SSSE3};
+DOTNET_PRIVATE const HEX_ENCODER_KERNELS Avx2Kernels = {"avx2", ToUpperHex_AVX2, ToUpperHexWithDash_AVX2};
+#elif defined(XENO_NATIVE_ARM64)
+DOTNET_PRIVATE const HEX_ENCODER_KERNELS NeonKernels = {"neon", ToUpperHex_NEON, ToUpperHexWithDash_NEON};
+#endif
+
+DOTNET_PRIVATE const HEX_ENCODER_KERNELS *Kernels = NULL;
+
+DOTNET_PRIVATE const HEX_ENCODER_KERNELS *GetKernels() {
+    const HEX_ENCODER_KERNELS *kernels = __atomic_load_n(&Kernels, __ATOMIC_ACQUIRE);
+
+    if (kernels != NULL) {
+        return kernels;
+    }
+
+    kernels = &ScalarKernels;
+
+#if defined(XENO_NATIVE_X86)
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX2)) {
+        kernels = &Avx2Kernels;
+    } else if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_SSSE3)) {
+        kernels = &Ssse3Kernels;
+    }
+#elif defined(XENO_NATIVE_ARM64)
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_NEON)) {
+        kernels = &NeonKernels;
+    }
+#endif
+
+    __atomic_store_n(&Kernels, kernels, __ATOMIC_RELEASE);
+
+    return kernels;
+}
+
+DOTNET_STRING HexUtility_GetKernelName() {
+    return GetKernels()->Name;
+}
+
+void HexUtility_ToUpperHex(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    GetKernels()->ToUpperHex(input, inputLength, keyStream, output);
+}
+
+void HexUtility_ToUpperHexWithDash(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output) {
+    GetKernels()->ToUpperHexWithDash(input, inputLength, keyStream, output);
+}
@@ -0,0 +1,13 @@
+#ifndef HEXUTILITY_H
+#define HEXUTILITY_H
+
+#include "global.h"
+
+void HexUtility_ToUpperHex_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output);
+void HexUtility_ToUpperHexWithDash_Scalar(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output);
+
+DOTNET_STRING HexUtility_GetKernelName(void);
+void HexUtility_ToUpperHex(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output);
+void HexUtility_ToUpperHexWithDash(DOTNET_READ_ONLY_SPAN_BYTE input, DOTNET_INT inputLength, DOTNET_READ_ONLY_SPAN_BYTE keyStream, DOTNET_SPAN_BYTE output);
+
+#endif
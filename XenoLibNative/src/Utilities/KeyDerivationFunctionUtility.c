@@ -1,4 +1,26 @@
 #include "KeyDerivationFunctionUtility.h"
+#include "CpuDispatchUtility.h"
+#include "CryptographyUtility.h"
+
+#ifdef XENO_NATIVE_X86
+#include <immintrin.h>
+#endif
+
+#define SHA1_BLOCK_SIZE 64
+#define SHA1_DIGEST_SIZE 20
+
+// Every iteration after the first hashes a 20 byte digest behind a 64 byte pad, so both compressions see the same padded block.
+#define PBKDF2_SHA1_ITERATION_BIT_LENGTH ((SHA1_BLOCK_SIZE + SHA1_DIGEST_SIZE) * 8)
+
+// Word i of lane n lives at [i][n], the kernels load a whole row of lanes at once.
+typedef struct PBKDF2_SHA1_LANES {
+    DOTNET_UINT Inner[5][PBKDF2_SHA1_MAX_LANES];
+    DOTNET_UINT Outer[5][PBKDF2_SHA1_MAX_LANES];
+    DOTNET_UINT U[5][PBKDF2_SHA1_MAX_LANES];
+    DOTNET_UINT T[5][PBKDF2_SHA1_MAX_LANES];
+} PBKDF2_SHA1_LANES;
+
+DOTNET_PRIVATE const DOTNET_UINT Sha1InitialState[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
 
 DOTNET_PRIVATE DOTNET_BOOL ComputeBaseValue(KDF_PBKDF1_CTX *ctx) {
     if (ctx == NULL) {
@@ -11,25 +33,29 @@ DOTNET_PRIVATE DOTNET_BOOL ComputeBaseValue(KDF_PBKDF1_CTX *ctx) {
         return DOTNET_FALSE;
     }
 
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
+    EVP_MD_CTX *context = CryptographyUtility_RentMessageDigestContext();
 
     if (context == NULL) {
+        free(tempBaseValue);
         return DOTNET_FALSE;
     }
 
     if (!EVP_DigestInit_ex(context, ctx->Hash, NULL)) {
-        EVP_MD_CTX_free(context);
+        CryptographyUtility_ReturnMessageDigestContext(context);
+        free(tempBaseValue);
         return DOTNET_FALSE;
     }
 
     if (!EVP_DigestUpdate(context, ctx->Password, ctx->PasswordLength)) {
-        EVP_MD_CTX_free(context);
+        CryptographyUtility_ReturnMessageDigestContext(context);
+        free(tempBaseValue);
         return DOTNET_FALSE;
     }
 
     if (ctx->Salt != NULL) {
         if (!EVP_DigestUpdate(context, ctx->Salt, ctx->SaltLength)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
+            free(tempBaseValue);
             return DOTNET_FALSE;
         }
     }
@@ -37,7 +63,8 @@ DOTNET_PRIVATE DOTNET_BOOL ComputeBaseValue(KDF_PBKDF1_CTX *ctx) {
     DOTNET_UINT bytesWritten;
 
     if (!EVP_DigestFinal_ex(context, tempBaseValue, &bytesWritten)) {
-        EVP_MD_CTX_free(context);
+        CryptographyUtility_ReturnMessageDigestContext(context);
+        free(tempBaseValue);
         return DOTNET_FALSE;
     }
 
@@ -45,22 +72,25 @@ DOTNET_PRIVATE DOTNET_BOOL ComputeBaseValue(KDF_PBKDF1_CTX *ctx) {
 
     for (DOTNET_INT i = 1; i < iterations; i++) {
         if (!EVP_DigestInit_ex(context, ctx->Hash, NULL)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
+            free(tempBaseValue);
             return DOTNET_FALSE;
         }
 
         if (!EVP_DigestUpdate(context, tempBaseValue, bytesWritten)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
+            free(tempBaseValue);
             return DOTNET_FALSE;
         }
 
         if (!EVP_DigestFinal_ex(context, tempBaseValue, &bytesWritten)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
+            free(tempBaseValue);
             return DOTNET_FALSE;
         }
     }
 
-    EVP_MD_CTX_free(context);
+    CryptographyUtility_ReturnMessageDigestContext(context);
 
     ctx->BaseValue = tempBaseValue;
     ctx->BaseValueLength = bytesWritten;
@@ -116,31 +146,31 @@ DOTNET_PRIVATE DOTNET_BOOL ComputeBytes(KDF_PBKDF1_CTX *ctx, DOTNET_INT cb, DOTN
     DOTNET_SPAN_BYTE baseValue = ctx->BaseValue;
     DOTNET_INT baseValueLength = ctx->BaseValueLength;
 
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
+    EVP_MD_CTX *context = CryptographyUtility_RentMessageDigestContext();
 
     if (context == NULL) {
         return DOTNET_FALSE;
     }
 
     if (!EVP_DigestInit_ex(context, ctx->Hash, NULL)) {
-        EVP_MD_CTX_free(context);
+        CryptographyUtility_ReturnMessageDigestContext(context);
         return DOTNET_FALSE;
     }
 
     if (!HashPrefix(ctx, context)) {
-        EVP_MD_CTX_free(context);
+        CryptographyUtility_ReturnMessageDigestContext(context);
         return DOTNET_FALSE;
     }
 
     if (!EVP_DigestUpdate(context, baseValue, baseValueLength)) {
-        EVP_MD_CTX_free(context);
+        CryptographyUtility_ReturnMessageDigestContext(context);
         return DOTNET_FALSE;
     }
 
     DOTNET_UINT bytesWritten;
 
     if (!EVP_DigestFinal_ex(context, rgb + ib, &bytesWritten)) {
-        EVP_MD_CTX_free(context);
+        CryptographyUtility_ReturnMessageDigestContext(context);
         return DOTNET_FALSE;
     }
 
@@ -148,29 +178,29 @@ DOTNET_PRIVATE DOTNET_BOOL ComputeBytes(KDF_PBKDF1_CTX *ctx, DOTNET_INT cb, DOTN
 
     while (cb > ib) {
         if (!EVP_DigestInit_ex(context, ctx->Hash, NULL)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
             return DOTNET_FALSE;
         }
 
         if (!HashPrefix(ctx, context)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
             return DOTNET_FALSE;
         }
 
         if (!EVP_DigestUpdate(context, baseValue, baseValueLength)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
             return DOTNET_FALSE;
         }
 
         if (!EVP_DigestFinal_ex(context, rgb + ib, &bytesWritten)) {
-            EVP_MD_CTX_free(context);
+            CryptographyUtility_ReturnMessageDigestContext(context);
             return DOTNET_FALSE;
         }
 
         ib += cbHash;
     }
 
-    EVP_MD_CTX_free(context);
+    CryptographyUtility_ReturnMessageDigestContext(context);
 
     return DOTNET_TRUE;
 }
@@ -203,7 +233,7 @@ DOTNET_PUBLIC KDF_PBKDF1_CTX *KeyDerivationFunctionUtility_CreatePBKDF1(DOTNET_R
 
     ctx->Prefix = 0;
 
-    ctx->Hash = EVP_MD_fetch(NULL, hashName, NULL);
+    ctx->Hash = CryptographyUtility_FetchMessageDigest(hashName);
 
     if (ctx->Hash == NULL) {
         free(ctx);
@@ -327,3 +357,544 @@ DOTNET_PUBLIC void KeyDerivationFunctionUtility_Free(KDF_PBKDF1_CTX *ctx) {
 
     free(ctx);
 }
+
+/*
+ * SHA-1 and PBKDF2-HMAC-SHA1
+ */
+
+DOTNET_PRIVATE DOTNET_UINT LoadBigEndian32(DOTNET_READ_ONLY_SPAN_BYTE source) {
+    return (DOTNET_UINT) source[0] << 24 | (DOTNET_UINT) source[1] << 16 | (DOTNET_UINT) source[2] << 8 | (DOTNET_UINT) source[3];
+}
+
+DOTNET_PRIVATE void StoreBigEndian32(DOTNET_UINT value, DOTNET_SPAN_BYTE destination) {
+    destination[0] = (DOTNET_BYTE) (value >> 24);
+    destination[1] = (DOTNET_BYTE) (value >> 16);
+    destination[2] = (DOTNET_BYTE) (value >> 8);
+    destination[3] = (DOTNET_BYTE) value;
+}
+
+/*
+ * One SHA-1 compression over the message words W, written once for every vector width.
+ * Each round adds into e and rotates b, the next round takes the variables shifted by one instead of moving them.
+ */
+#define SHA1_MESSAGE(W, i) ((i) < 16 ? W[(i)] : (W[(i) & 15] = SHA1_ROL(SHA1_XOR(SHA1_XOR(W[((i) - 3) & 15], W[((i) - 8) & 15]), SHA1_XOR(W[((i) - 14) & 15], W[(i) & 15])), 1)))
+
+#define SHA1_ROUND(a, b, c, d, e, F, k, w) \
+    do { \
+        e = SHA1_ADD(SHA1_ADD(SHA1_ADD(e, SHA1_ROL(a, 5)), SHA1_ADD(F(b, c, d), SHA1_SET1(k))), w); \
+        b = SHA1_ROL(b, 30); \
+    } while (0)
+
+#define SHA1_FIVE_ROUNDS(W, F, k, i) \
+    do { \
+        SHA1_ROUND(a, b, c, d, e, F, k, SHA1_MESSAGE(W, (i))); \
+        SHA1_ROUND(e, a, b, c, d, F, k, SHA1_MESSAGE(W, (i) + 1)); \
+        SHA1_ROUND(d, e, a, b, c, F, k, SHA1_MESSAGE(W, (i) + 2)); \
+        SHA1_ROUND(c, d, e, a, b, F, k, SHA1_MESSAGE(W, (i) + 3)); \
+        SHA1_ROUND(b, c, d, e, a, F, k, SHA1_MESSAGE(W, (i) + 4)); \
+    } while (0)
+
+#define SHA1_TWENTY_ROUNDS(W, F, k, i) \
+    do { \
+        SHA1_FIVE_ROUNDS(W, F, k, (i)); \
+        SHA1_FIVE_ROUNDS(W, F, k, (i) + 5); \
+        SHA1_FIVE_ROUNDS(W, F, k, (i) + 10); \
+        SHA1_FIVE_ROUNDS(W, F, k, (i) + 15); \
+    } while (0)
+
+#define SHA1_COMPRESS(TYPE, S, W) \
+    do { \
+        TYPE a = S[0], b = S[1], c = S[2], d = S[3], e = S[4]; \
+        SHA1_TWENTY_ROUNDS(W, SHA1_CH, 0x5A827999, 0); \
+        SHA1_TWENTY_ROUNDS(W, SHA1_PARITY, 0x6ED9EBA1, 20); \
+        SHA1_TWENTY_ROUNDS(W, SHA1_MAJ, 0x8F1BBCDC, 40); \
+        SHA1_TWENTY_ROUNDS(W, SHA1_PARITY, 0xCA62C1D6, 60); \
+        S[0] = SHA1_ADD(S[0], a); \
+        S[1] = SHA1_ADD(S[1], b); \
+        S[2] = SHA1_ADD(S[2], c); \
+        S[3] = SHA1_ADD(S[3], d); \
+        S[4] = SHA1_ADD(S[4], e); \
+    } while (0)
+
+// U = HMAC(P, U) is two compressions of one padded block: the inner one from the ipad state, the outer one over its digest from the opad state.
+#define PBKDF2_SHA1_ITERATE(TYPE, LOAD, STORE, lanes, lane, iterations) \
+    do { \
+        TYPE inner[5], outer[5], u[5], t[5], W[16]; \
+        for (DOTNET_INT word = 0; word < 5; word++) { \
+            inner[word] = LOAD((lanes)->Inner[word] + (lane)); \
+            outer[word] = LOAD((lanes)->Outer[word] + (lane)); \
+            u[word] = LOAD((lanes)->U[word] + (lane)); \
+            t[word] = LOAD((lanes)->T[word] + (lane)); \
+        } \
+        for (DOTNET_INT iteration = 1; iteration < (iterations); iteration++) { \
+            TYPE s[5]; \
+            for (DOTNET_INT word = 0; word < 5; word++) { \
+                W[word] = u[word]; \
+                s[word] = inner[word]; \
+            } \
+            W[5] = SHA1_SET1(0x80000000); \
+            for (DOTNET_INT word = 6; word < 15; word++) { \
+                W[word] = SHA1_SET1(0); \
+            } \
+            W[15] = SHA1_SET1(PBKDF2_SHA1_ITERATION_BIT_LENGTH); \
+            SHA1_COMPRESS(TYPE, s, W); \
+            for (DOTNET_INT word = 0; word < 5; word++) { \
+                W[word] = s[word]; \
+                u[word] = outer[word]; \
+            } \
+            W[5] = SHA1_SET1(0x80000000); \
+            for (DOTNET_INT word = 6; word < 15; word++) { \
+                W[word] = SHA1_SET1(0); \
+            } \
+            W[15] = SHA1_SET1(PBKDF2_SHA1_ITERATION_BIT_LENGTH); \
+            SHA1_COMPRESS(TYPE, u, W); \
+            for (DOTNET_INT word = 0; word < 5; word++) { \
+                t[word] = SHA1_XOR(t[word], u[word]); \
+            } \
+        } \
+        for (DOTNET_INT word = 0; word < 5; word++) { \
+            STORE((lanes)->T[word] + (lane), t[word]); \
+        } \
+    } while (0)
+
+#define SHA1_ADD(a, b) ((DOTNET_UINT) ((a) + (b)))
+#define SHA1_XOR(a, b) ((a) ^ (b))
+#define SHA1_ROL(x, n) ((DOTNET_UINT) ((x) << (n) | (x) >> (32 - (n))))
+#define SHA1_CH(b, c, d) ((d) ^ ((b) & ((c) ^ (d))))
+#define SHA1_PARITY(b, c, d) ((b) ^ (c) ^ (d))
+#define SHA1_MAJ(b, c, d) (((b) & (c)) | ((d) & ((b) | (c))))
+#define SHA1_SET1(x) ((DOTNET_UINT) (x))
+#define SHA1_LOAD(source) (*(source))
+#define SHA1_STORE(destination, value) (*(destination) = (value))
+
+DOTNET_PRIVATE void CompressSha1_Scalar(DOTNET_UINT state[5], DOTNET_READ_ONLY_SPAN_BYTE block) {
+    DOTNET_UINT W[16];
+
+    for (DOTNET_INT i = 0; i < 16; i++) {
+        W[i] = LoadBigEndian32(block + i * 4);
+    }
+
+    SHA1_COMPRESS(DOTNET_UINT, state, W);
+}
+
+DOTNET_PRIVATE void IteratePbkdf2Sha1_Scalar(PBKDF2_SHA1_LANES *lanes, DOTNET_INT lane, DOTNET_INT iterations) {
+    PBKDF2_SHA1_ITERATE(DOTNET_UINT, SHA1_LOAD, SHA1_STORE, lanes, lane, iterations);
+}
+
+#undef SHA1_ADD
+#undef SHA1_XOR
+#undef SHA1_ROL
+#undef SHA1_CH
+#undef SHA1_PARITY
+#undef SHA1_MAJ
+#undef SHA1_SET1
+#undef SHA1_LOAD
+#undef SHA1_STORE
+
+#ifdef XENO_NATIVE_X86
+
+#define SHA1_ADD(a, b) _mm256_add_epi32(a, b)
+#define SHA1_XOR(a, b) _mm256_xor_si256(a, b)
+#define SHA1_ROL(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#define SHA1_CH(b, c, d) _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)))
+#define SHA1_PARITY(b, c, d) _mm256_xor_si256(_mm256_xor_si256(b, c), d)
+#define SHA1_MAJ(b, c, d) _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)))
+#define SHA1_SET1(x) _mm256_set1_epi32((int) (x))
+#define SHA1_LOAD(source) _mm256_loadu_si256((const __m256i *) (source))
+#define SHA1_STORE(destination, value) _mm256_storeu_si256((__m256i *) (destination), value)
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE void IteratePbkdf2Sha1Lanes_AVX2(PBKDF2_SHA1_LANES *lanes, DOTNET_INT lane, DOTNET_INT iterations) {
+    PBKDF2_SHA1_ITERATE(__m256i, SHA1_LOAD, SHA1_STORE, lanes, lane, iterations);
+}
+
+#undef SHA1_ADD
+#undef SHA1_XOR
+#undef SHA1_ROL
+#undef SHA1_CH
+#undef SHA1_PARITY
+#undef SHA1_MAJ
+#undef SHA1_SET1
+#undef SHA1_LOAD
+#undef SHA1_STORE
+
+#define SHA1_ADD(a, b) _mm512_add_epi32(a, b)
+#define SHA1_XOR(a, b) _mm512_xor_si512(a, b)
+#define SHA1_ROL(x, n) _mm512_rol_epi32(x, n)
+#define SHA1_CH(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0xCA)
+#define SHA1_PARITY(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0x96)
+#define SHA1_MAJ(b, c, d) _mm512_ternarylogic_epi32(b, c, d, 0xE8)
+#define SHA1_SET1(x) _mm512_set1_epi32((int) (x))
+#define SHA1_LOAD(source) _mm512_loadu_si512((const void *) (source))
+#define SHA1_STORE(destination, value) _mm512_storeu_si512((void *) (destination), value)
+
+XENO_NATIVE_TARGET("avx512f")
+DOTNET_PRIVATE void IteratePbkdf2Sha1Lanes_AVX512(PBKDF2_SHA1_LANES *lanes, DOTNET_INT lane, DOTNET_INT iterations) {
+    PBKDF2_SHA1_ITERATE(__m512i, SHA1_LOAD, SHA1_STORE, lanes, lane, iterations);
+}
+
+#undef SHA1_ADD
+#undef SHA1_XOR
+#undef SHA1_ROL
+#undef SHA1_CH
+#undef SHA1_PARITY
+#undef SHA1_MAJ
+#undef SHA1_SET1
+#undef SHA1_LOAD
+#undef SHA1_STORE
+
+/*
+ * SHA-NI keeps A to D in one register with A in the top word and E in the top word of another.
+ * Four rounds per sha1rnds4, the E register alternates between two variables like the reference code from Intel.
+ */
+#define SHA1_SHA_FOUR_ROUNDS(e0, e1, m0, m1, m2, m3, function) \
+    do { \
+        e0 = _mm_sha1nexte_epu32(e0, m0); \
+        e1 = shaAbcd; \
+        m1 = _mm_sha1msg2_epu32(m1, m0); \
+        shaAbcd = _mm_sha1rnds4_epu32(shaAbcd, e0, function); \
+        m3 = _mm_sha1msg1_epu32(m3, m0); \
+        m2 = _mm_xor_si128(m2, m0); \
+    } while (0)
+
+// A macro rather than a function so the state stays in registers across the two compressions of an iteration.
+#define SHA1_SHA_COMPRESS(abcdState, eState, message0, message1, message2, message3) \
+    do { \
+        __m128i shaAbcd = (abcdState), shaE0 = (eState), shaE1; \
+        __m128i shaM0 = (message0), shaM1 = (message1), shaM2 = (message2), shaM3 = (message3); \
+        shaE0 = _mm_add_epi32(shaE0, shaM0); \
+        shaE1 = shaAbcd; \
+        shaAbcd = _mm_sha1rnds4_epu32(shaAbcd, shaE0, 0); \
+        shaE1 = _mm_sha1nexte_epu32(shaE1, shaM1); \
+        shaE0 = shaAbcd; \
+        shaAbcd = _mm_sha1rnds4_epu32(shaAbcd, shaE1, 0); \
+        shaM0 = _mm_sha1msg1_epu32(shaM0, shaM1); \
+        shaE0 = _mm_sha1nexte_epu32(shaE0, shaM2); \
+        shaE1 = shaAbcd; \
+        shaAbcd = _mm_sha1rnds4_epu32(shaAbcd, shaE0, 0); \
+        shaM1 = _mm_sha1msg1_epu32(shaM1, shaM2); \
+        shaM0 = _mm_xor_si128(shaM0, shaM2); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM3, shaM0, shaM1, shaM2, 0); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM0, shaM1, shaM2, shaM3, 0); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM1, shaM2, shaM3, shaM0, 1); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM2, shaM3, shaM0, shaM1, 1); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM3, shaM0, shaM1, shaM2, 1); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM0, shaM1, shaM2, shaM3, 1); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM1, shaM2, shaM3, shaM0, 1); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM2, shaM3, shaM0, shaM1, 2); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM3, shaM0, shaM1, shaM2, 2); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM0, shaM1, shaM2, shaM3, 2); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM1, shaM2, shaM3, shaM0, 2); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM2, shaM3, shaM0, shaM1, 2); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM3, shaM0, shaM1, shaM2, 3); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM0, shaM1, shaM2, shaM3, 3); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM1, shaM2, shaM3, shaM0, 3); \
+        SHA1_SHA_FOUR_ROUNDS(shaE0, shaE1, shaM2, shaM3, shaM0, shaM1, 3); \
+        SHA1_SHA_FOUR_ROUNDS(shaE1, shaE0, shaM3, shaM0, shaM1, shaM2, 3); \
+        (eState) = _mm_sha1nexte_epu32(shaE0, (eState)); \
+        (abcdState) = _mm_add_epi32(shaAbcd, (abcdState)); \
+    } while (0)
+
+XENO_NATIVE_TARGET("sha,sse4.1")
+DOTNET_PRIVATE void CompressSha1_SHA_Block(DOTNET_UINT state[5], DOTNET_READ_ONLY_SPAN_BYTE block) {
+    const __m128i shuffle = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i abcd = _mm_set_epi32((int) state[0], (int) state[1], (int) state[2], (int) state[3]);
+    __m128i e = _mm_set_epi32((int) state[4], 0, 0, 0);
+
+    SHA1_SHA_COMPRESS(abcd, e, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) block), shuffle), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (block + 16)), shuffle), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (block + 32)), shuffle), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (block + 48)), shuffle));
+
+    state[0] = (DOTNET_UINT) _mm_extract_epi32(abcd, 3);
+    state[1] = (DOTNET_UINT) _mm_extract_epi32(abcd, 2);
+    state[2] = (DOTNET_UINT) _mm_extract_epi32(abcd, 1);
+    state[3] = (DOTNET_UINT) _mm_extract_epi32(abcd, 0);
+    state[4] = (DOTNET_UINT) _mm_extract_epi32(e, 3);
+}
+
+// The iterated block is the previous digest, so ABCD and E feed the next compression as they are, only the padding word is or'ed in.
+XENO_NATIVE_TARGET("sha,sse4.1")
+DOTNET_PRIVATE void IteratePbkdf2Sha1Lanes_SHA(PBKDF2_SHA1_LANES *lanes, DOTNET_INT lane, DOTNET_INT laneCount, DOTNET_INT iterations) {
+    const __m128i padding = _mm_set_epi32(0, (int) 0x80000000, 0, 0);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i length = _mm_set_epi32(0, 0, 0, PBKDF2_SHA1_ITERATION_BIT_LENGTH);
+    __m128i innerAbcd[4], innerE[4], outerAbcd[4], outerE[4], uAbcd[4], uE[4], tAbcd[4], tE[4];
+
+    for (DOTNET_INT i = 0; i < laneCount; i++) {
+        DOTNET_INT n = lane + i;
+
+        innerAbcd[i] = _mm_set_epi32((int) lanes->Inner[0][n], (int) lanes->Inner[1][n], (int) lanes->Inner[2][n], (int) lanes->Inner[3][n]);
+        innerE[i] = _mm_set_epi32((int) lanes->Inner[4][n], 0, 0, 0);
+        outerAbcd[i] = _mm_set_epi32((int) lanes->Outer[0][n], (int) lanes->Outer[1][n], (int) lanes->Outer[2][n], (int) lanes->Outer[3][n]);
+        outerE[i] = _mm_set_epi32((int) lanes->Outer[4][n], 0, 0, 0);
+        uAbcd[i] = _mm_set_epi32((int) lanes->U[0][n], (int) lanes->U[1][n], (int) lanes->U[2][n], (int) lanes->U[3][n]);
+        uE[i] = _mm_set_epi32((int) lanes->U[4][n], 0, 0, 0);
+        tAbcd[i] = _mm_set_epi32((int) lanes->T[0][n], (int) lanes->T[1][n], (int) lanes->T[2][n], (int) lanes->T[3][n]);
+        tE[i] = _mm_set_epi32((int) lanes->T[4][n], 0, 0, 0);
+    }
+
+    // The lanes are independent chains, interleaving them hides the latency of sha1rnds4.
+    for (DOTNET_INT iteration = 1; iteration < iterations; iteration++) {
+        for (DOTNET_INT i = 0; i < laneCount; i++) {
+            __m128i sAbcd = innerAbcd[i];
+            __m128i sE = innerE[i];
+
+            SHA1_SHA_COMPRESS(sAbcd, sE, uAbcd[i], _mm_or_si128(uE[i], padding), zero, length);
+
+            uAbcd[i] = outerAbcd[i];
+            uE[i] = outerE[i];
+
+            SHA1_SHA_COMPRESS(uAbcd[i], uE[i], sAbcd, _mm_or_si128(sE, padding), zero, length);
+
+            tAbcd[i] = _mm_xor_si128(tAbcd[i], uAbcd[i]);
+            tE[i] = _mm_xor_si128(tE[i], uE[i]);
+        }
+    }
+
+    for (DOTNET_INT i = 0; i < laneCount; i++) {
+        DOTNET_INT n = lane + i;
+
+        lanes->T[0][n] = (DOTNET_UINT) _mm_extract_epi32(tAbcd[i], 3);
+        lanes->T[1][n] = (DOTNET_UINT) _mm_extract_epi32(tAbcd[i], 2);
+        lanes->T[2][n] = (DOTNET_UINT) _mm_extract_epi32(tAbcd[i], 1);
+        lanes->T[3][n] = (DOTNET_UINT) _mm_extract_epi32(tAbcd[i], 0);
+        lanes->T[4][n] = (DOTNET_UINT) _mm_extract_epi32(tE[i], 3);
+    }
+}
+
+#undef SHA1_SHA_FOUR_ROUNDS
+#undef SHA1_SHA_COMPRESS
+
+#endif
+
+DOTNET_PRIVATE DOTNET_BOOL HasSha1Extensions(void) {
+#ifdef XENO_NATIVE_X86
+    return CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_SHA | CPU_DISPATCH_FEATURE_SSE41);
+#else
+    return DOTNET_FALSE;
+#endif
+}
+
+DOTNET_PRIVATE void CompressSha1(DOTNET_UINT state[5], DOTNET_READ_ONLY_SPAN_BYTE block) {
+#ifdef XENO_NATIVE_X86
+    if (HasSha1Extensions()) {
+        CompressSha1_SHA_Block(state, block);
+        return;
+    }
+#endif
+
+    CompressSha1_Scalar(state, block);
+}
+
+// Absorbs source and then suffix behind prefixLength bytes that are already in state, pads and leaves the digest in state.
+DOTNET_PRIVATE void FinishSha1(DOTNET_UINT state[5], DOTNET_ULONG prefixLength, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_READ_ONLY_SPAN_BYTE suffix, DOTNET_INT suffixLength) {
+    DOTNET_BYTE tail[SHA1_BLOCK_SIZE * 2];
+    DOTNET_INT fullBlocks = sourceLength / SHA1_BLOCK_SIZE;
+    DOTNET_INT remaining = sourceLength % SHA1_BLOCK_SIZE;
+
+    for (DOTNET_INT i = 0; i < fullBlocks; i++) {
+        CompressSha1(state, source + i * SHA1_BLOCK_SIZE);
+    }
+
+    // At most 63 bytes of source and a 4 byte block counter are left over, they always fit in two blocks with the padding.
+    if (remaining > 0) {
+        memcpy(tail, source + fullBlocks * SHA1_BLOCK_SIZE, remaining);
+    }
+
+    if (suffixLength > 0) {
+        memcpy(tail + remaining, suffix, suffixLength);
+    }
+
+    DOTNET_INT tailLength = remaining + suffixLength;
+    DOTNET_INT tailBlocks = tailLength + 9 > SHA1_BLOCK_SIZE ? 2 : 1;
+    DOTNET_ULONG bitLength = (prefixLength + sourceLength + suffixLength) * 8;
+
+    tail[tailLength] = 0x80;
+    memset(tail + tailLength + 1, 0, tailBlocks * SHA1_BLOCK_SIZE - tailLength - 1);
+    StoreBigEndian32((DOTNET_UINT) (bitLength >> 32), tail + tailBlocks * SHA1_BLOCK_SIZE - 8);
+    StoreBigEndian32((DOTNET_UINT) bitLength, tail + tailBlocks * SHA1_BLOCK_SIZE - 4);
+
+    for (DOTNET_INT i = 0; i < tailBlocks; i++) {
+        CompressSha1(state, tail + i * SHA1_BLOCK_SIZE);
+    }
+}
+
+DOTNET_PRIVATE void StoreSha1Digest(const DOTNET_UINT state[5], DOTNET_SPAN_BYTE destination) {
+    for (DOTNET_INT i = 0; i < 5; i++) {
+        StoreBigEndian32(state[i], destination + i * 4);
+    }
+}
+
+// The ipad and opad states only depend on the password, they are compressed once and reused by every iteration.
+DOTNET_PRIVATE void PreparePbkdf2Sha1Lane(PBKDF2_SHA1_LANES *lanes, DOTNET_INT lane, DOTNET_READ_ONLY_SPAN_BYTE password, DOTNET_INT passwordLength) {
+    DOTNET_BYTE key[SHA1_BLOCK_SIZE];
+    DOTNET_UINT inner[5], outer[5];
+
+    memset(key, 0, sizeof(key));
+
+    if (passwordLength > SHA1_BLOCK_SIZE) {
+        DOTNET_UINT digest[5];
+
+        memcpy(digest, Sha1InitialState, sizeof(digest));
+        FinishSha1(digest, 0, password, passwordLength, NULL, 0);
+        StoreSha1Digest(digest, key);
+    } else if (passwordLength > 0) {
+        memcpy(key, password, passwordLength);
+    }
+
+    for (DOTNET_INT i = 0; i < SHA1_BLOCK_SIZE; i++) {
+        key[i] ^= 0x36;
+    }
+
+    memcpy(inner, Sha1InitialState, sizeof(inner));
+    CompressSha1(inner, key);
+
+    for (DOTNET_INT i = 0; i < SHA1_BLOCK_SIZE; i++) {
+        key[i] ^= 0x36 ^ 0x5C;
+    }
+
+    memcpy(outer, Sha1InitialState, sizeof(outer));
+    CompressSha1(outer, key);
+
+    for (DOTNET_INT word = 0; word < 5; word++) {
+        lanes->Inner[word][lane] = inner[word];
+        lanes->Outer[word][lane] = outer[word];
+    }
+}
+
+// U1 = HMAC(P, salt || block) has a salt of any length, it runs once per block and stays on the single message path.
+DOTNET_PRIVATE void StartPbkdf2Sha1Lane(PBKDF2_SHA1_LANES *lanes, DOTNET_INT lane, DOTNET_READ_ONLY_SPAN_BYTE salt, DOTNET_INT saltLength, DOTNET_UINT block) {
+    DOTNET_BYTE counter[4], innerDigest[SHA1_DIGEST_SIZE];
+    DOTNET_UINT state[5];
+
+    StoreBigEndian32(block, counter);
+
+    for (DOTNET_INT word = 0; word < 5; word++) {
+        state[word] = lanes->Inner[word][lane];
+    }
+
+    FinishSha1(state, SHA1_BLOCK_SIZE, salt, saltLength, counter, sizeof(counter));
+    StoreSha1Digest(state, innerDigest);
+
+    for (DOTNET_INT word = 0; word < 5; word++) {
+        state[word] = lanes->Outer[word][lane];
+    }
+
+    FinishSha1(state, SHA1_BLOCK_SIZE, innerDigest, sizeof(innerDigest), NULL, 0);
+
+    for (DOTNET_INT word = 0; word < 5; word++) {
+        lanes->U[word][lane] = state[word];
+        lanes->T[word][lane] = state[word];
+    }
+}
+
+DOTNET_PRIVATE void IteratePbkdf2Sha1Lanes(PBKDF2_SHA1_LANES *lanes, DOTNET_INT laneCount, DOTNET_INT kernelLaneCount, DOTNET_INT iterations) {
+    DOTNET_INT lane = 0;
+
+    // A short tail steps down to a narrower kernel once the unused lanes of the wide one would cost more than the tail itself.
+    while (lane < laneCount) {
+#ifdef XENO_NATIVE_X86
+        if (kernelLaneCount == 16 && laneCount - lane > 2) {
+            IteratePbkdf2Sha1Lanes_AVX512(lanes, lane, iterations);
+            lane += 16;
+            continue;
+        }
+
+        if (kernelLaneCount >= 8 && laneCount - lane > 4) {
+            IteratePbkdf2Sha1Lanes_AVX2(lanes, lane, iterations);
+            lane += 8;
+            continue;
+        }
+
+        if (HasSha1Extensions()) {
+            DOTNET_INT shaLanes = laneCount - lane < 4 ? laneCount - lane : 4;
+
+            IteratePbkdf2Sha1Lanes_SHA(lanes, lane, shaLanes, iterations);
+            lane += shaLanes;
+            continue;
+        }
+#endif
+
+        IteratePbkdf2Sha1_Scalar(lanes, lane, iterations);
+        lane++;
+    }
+}
+
+DOTNET_PUBLIC DOTNET_INT KeyDerivationFunctionUtility_GetPbkdf2Sha1LaneCount() {
+#ifdef XENO_NATIVE_X86
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX512F)) {
+        return 16;
+    }
+
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX2)) {
+        return 8;
+    }
+
+    if (HasSha1Extensions()) {
+        return 4;
+    }
+#endif
+
+    return 1;
+}
+
+DOTNET_PUBLIC DOTNET_STRING KeyDerivationFunctionUtility_GetPbkdf2Sha1KernelName() {
+    switch (KeyDerivationFunctionUtility_GetPbkdf2Sha1LaneCount()) {
+        case 16:
+            return "avx512-x16";
+
+        case 8:
+            return "avx2-x8";
+
+        case 4:
+            return "sha-x4";
+
+        default:
+            return "scalar";
+    }
+}
+
+DOTNET_PUBLIC DOTNET_BOOL KeyDerivationFunctionUtility_ComputePbkdf2Sha1Batch(const DOTNET_BYTE *const *passwords, DOTNET_READ_ONLY_SPAN_INT passwordLengths, DOTNET_READ_ONLY_SPAN_BYTE salt, DOTNET_INT saltLength, DOTNET_INT iterations, DOTNET_BYTE *const *destinations, DOTNET_INT keyLength, DOTNET_INT count) {
+    if (passwords == NULL || passwordLengths == NULL || (salt == NULL && saltLength > 0) || saltLength < 0 || iterations <= 0 || destinations == NULL || keyLength < 0 || count < 0) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        if (passwordLengths[i] < 0 || (passwords[i] == NULL && passwordLengths[i] > 0)) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    DOTNET_INT kernelLaneCount = KeyDerivationFunctionUtility_GetPbkdf2Sha1LaneCount();
+    PBKDF2_SHA1_LANES lanes;
+
+    memset(&lanes, 0, sizeof(lanes));
+
+    for (DOTNET_INT i = 0; i < count; i += PBKDF2_SHA1_MAX_LANES) {
+        DOTNET_INT groupLanes = count - i < PBKDF2_SHA1_MAX_LANES ? count - i : PBKDF2_SHA1_MAX_LANES;
+
+        // Every password is read before the first output byte is written, so a destination can overwrite its own password.
+        for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+            PreparePbkdf2Sha1Lane(&lanes, lane, passwords[i + lane], passwordLengths[i + lane]);
+        }
+
+        for (DOTNET_INT offset = 0, block = 1; offset < keyLength; offset += SHA1_DIGEST_SIZE, block++) {
+            DOTNET_BYTE digest[SHA1_DIGEST_SIZE];
+            DOTNET_INT length = keyLength - offset < SHA1_DIGEST_SIZE ? keyLength - offset : SHA1_DIGEST_SIZE;
+
+            for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+                StartPbkdf2Sha1Lane(&lanes, lane, salt, saltLength, (DOTNET_UINT) block);
+            }
+
+            IteratePbkdf2Sha1Lanes(&lanes, groupLanes, kernelLaneCount, iterations);
+
+            for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+                for (DOTNET_INT word = 0; word < 5; word++) {
+                    StoreBigEndian32(lanes.T[word][lane], digest + word * 4);
+                }
+
+                memcpy(destinations[i + lane] + offset, digest, length);
+            }
+        }
+    }
+
+    return DOTNET_TRUE;
+}
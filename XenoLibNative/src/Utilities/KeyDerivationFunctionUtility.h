@@ -4,6 +4,8 @@
 #include "global.h"
 #include "openssl/evp.h"
 
+#define PBKDF2_SHA1_MAX_LANES 16
+
 typedef struct KDF_PBKDF1_CTX {
     DOTNET_READ_ONLY_SPAN_BYTE Password;
     DOTNET_INT PasswordLength;
@@ -30,4 +32,10 @@ DOTNET_INT KeyDerivationFunctionUtility_GetBytes(KDF_PBKDF1_CTX *ctx, DOTNET_SPA
 void KeyDerivationFunctionUtility_Reset(KDF_PBKDF1_CTX *ctx);
 void KeyDerivationFunctionUtility_Free(KDF_PBKDF1_CTX *ctx);
 
+DOTNET_INT KeyDerivationFunctionUtility_GetPbkdf2Sha1LaneCount(void);
+DOTNET_STRING KeyDerivationFunctionUtility_GetPbkdf2Sha1KernelName(void);
+
+// Same output as PKCS5_PBKDF2_HMAC_SHA1 for every password, the salt and the iterations are shared. A destination may be its own password.
+DOTNET_BOOL KeyDerivationFunctionUtility_ComputePbkdf2Sha1Batch(const DOTNET_BYTE *const *passwords, DOTNET_READ_ONLY_SPAN_INT passwordLengths, DOTNET_READ_ONLY_SPAN_BYTE salt, DOTNET_INT saltLength, DOTNET_INT iterations, DOTNET_BYTE *const *destinations, DOTNET_INT keyLength, DOTNET_INT count);
+
 #endif
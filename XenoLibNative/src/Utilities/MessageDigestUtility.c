@@ -1,42 +1,814 @@
 #include "MessageDigestUtility.h"
+#include "CpuDispatchUtility.h"
+#include "CryptographyUtility.h"
 
-DOTNET_INT MessageDigestUtility_ComputeHash_EVP_MD(const EVP_MD *type, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
+#ifdef XENO_NATIVE_X86
+#include <immintrin.h>
+#endif
 
-    if (context == NULL) {
-        return 0;
+typedef struct SHA512_LANE {
+    DOTNET_READ_ONLY_SPAN_BYTE Source;
+    DOTNET_INT FullBlocks;
+    DOTNET_INT Blocks;
+    DOTNET_BYTE Tail[SHA512_BLOCK_SIZE * 2];
+} SHA512_LANE;
+
+typedef struct SHA3_512_LANE {
+    DOTNET_READ_ONLY_SPAN_BYTE Source;
+    DOTNET_INT FullBlocks;
+    DOTNET_INT Blocks;
+    DOTNET_BYTE Tail[SHA3_512_BLOCK_SIZE];
+} SHA3_512_LANE;
+
+DOTNET_PRIVATE const DOTNET_ULONG Sha512RoundConstants[80] = {
+    0x428A2F98D728AE22, 0x7137449123EF65CD, 0xB5C0FBCFEC4D3B2F, 0xE9B5DBA58189DBBC, 0x3956C25BF348B538, 0x59F111F1B605D019, 0x923F82A4AF194F9B, 0xAB1C5ED5DA6D8118,
+    0xD807AA98A3030242, 0x12835B0145706FBE, 0x243185BE4EE4B28C, 0x550C7DC3D5FFB4E2, 0x72BE5D74F27B896F, 0x80DEB1FE3B1696B1, 0x9BDC06A725C71235, 0xC19BF174CF692694,
+    0xE49B69C19EF14AD2, 0xEFBE4786384F25E3, 0x0FC19DC68B8CD5B5, 0x240CA1CC77AC9C65, 0x2DE92C6F592B0275, 0x4A7484AA6EA6E483, 0x5CB0A9DCBD41FBD4, 0x76F988DA831153B5,
+    0x983E5152EE66DFAB, 0xA831C66D2DB43210, 0xB00327C898FB213F, 0xBF597FC7BEEF0EE4, 0xC6E00BF33DA88FC2, 0xD5A79147930AA725, 0x06CA6351E003826F, 0x142929670A0E6E70,
+    0x27B70A8546D22FFC, 0x2E1B21385C26C926, 0x4D2C6DFC5AC42AED, 0x53380D139D95B3DF, 0x650A73548BAF63DE, 0x766A0ABB3C77B2A8, 0x81C2C92E47EDAEE6, 0x92722C851482353B,
+    0xA2BFE8A14CF10364, 0xA81A664BBC423001, 0xC24B8B70D0F89791, 0xC76C51A30654BE30, 0xD192E819D6EF5218, 0xD69906245565A910, 0xF40E35855771202A, 0x106AA07032BBD1B8,
+    0x19A4C116B8D2D0C8, 0x1E376C085141AB53, 0x2748774CDF8EEB99, 0x34B0BCB5E19B48A8, 0x391C0CB3C5C95A63, 0x4ED8AA4AE3418ACB, 0x5B9CCA4F7763E373, 0x682E6FF3D6B2B8A3,
+    0x748F82EE5DEFB2FC, 0x78A5636F43172F60, 0x84C87814A1F0AB72, 0x8CC702081A6439EC, 0x90BEFFFA23631E28, 0xA4506CEBDE82BDE9, 0xBEF9A3F7B2C67915, 0xC67178F2E372532B,
+    0xCA273ECEEA26619C, 0xD186B8C721C0C207, 0xEADA7DD6CDE0EB1E, 0xF57D4F7FEE6ED178, 0x06F067AA72176FBA, 0x0A637DC5A2C898A6, 0x113F9804BEF90DAE, 0x1B710B35131C471B,
+    0x28DB77F523047D84, 0x32CAAB7B40C72493, 0x3C9EBE0A15C9BEBC, 0x431D67C49C100D4C, 0x4CC5D4BECB3E42B6, 0x597F299CFC657E2A, 0x5FCB6FAB3AD6FAEC, 0x6C44198C4A475817};
+
+DOTNET_PRIVATE const DOTNET_ULONG Sha512InitialState[8] = {0x6A09E667F3BCC908, 0xBB67AE8584CAA73B, 0x3C6EF372FE94F82B, 0xA54FF53A5F1D36F1, 0x510E527FADE682D1, 0x9B05688C2B3E6C1F, 0x1F83D9ABFB41BD6B, 0x5BE0CD19137E2179};
+
+DOTNET_PRIVATE DOTNET_ULONG LoadBigEndian64(DOTNET_READ_ONLY_SPAN_BYTE source) {
+    return (DOTNET_ULONG) source[0] << 56 | (DOTNET_ULONG) source[1] << 48 | (DOTNET_ULONG) source[2] << 40 | (DOTNET_ULONG) source[3] << 32 |
+           (DOTNET_ULONG) source[4] << 24 | (DOTNET_ULONG) source[5] << 16 | (DOTNET_ULONG) source[6] << 8 | (DOTNET_ULONG) source[7];
+}
+
+DOTNET_PRIVATE void StoreBigEndian64(DOTNET_ULONG value, DOTNET_SPAN_BYTE destination) {
+    for (DOTNET_INT i = 7; i >= 0; i--) {
+        destination[i] = (DOTNET_BYTE) value;
+        value >>= 8;
+    }
+}
+
+DOTNET_PRIVATE void PrepareSha512Lane(SHA512_LANE *lane, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength) {
+    // Whole blocks are read straight from the source, the remaining bytes, the 0x80 terminator and the 128-bit bit length go to the tail.
+    DOTNET_INT remaining = sourceLength % SHA512_BLOCK_SIZE;
+    DOTNET_INT tailLength = remaining + 1 + 16 <= SHA512_BLOCK_SIZE ? SHA512_BLOCK_SIZE : SHA512_BLOCK_SIZE * 2;
+
+    lane->Source = source;
+    lane->FullBlocks = sourceLength / SHA512_BLOCK_SIZE;
+    lane->Blocks = lane->FullBlocks + tailLength / SHA512_BLOCK_SIZE;
+
+    memcpy(lane->Tail, source + lane->FullBlocks * SHA512_BLOCK_SIZE, remaining);
+    memset(lane->Tail + remaining, 0, tailLength - remaining);
+
+    lane->Tail[remaining] = 0x80;
+    StoreBigEndian64((DOTNET_ULONG) sourceLength >> 61, lane->Tail + tailLength - 16);
+    StoreBigEndian64((DOTNET_ULONG) sourceLength << 3, lane->Tail + tailLength - 8);
+}
+
+DOTNET_PRIVATE DOTNET_READ_ONLY_SPAN_BYTE GetSha512LaneBlock(const SHA512_LANE *lane, DOTNET_INT block) {
+    if (block < lane->FullBlocks) {
+        return lane->Source + block * SHA512_BLOCK_SIZE;
+    }
+
+    // Lanes that are already finished keep hashing their tail, their digest was captured at their own last block.
+    DOTNET_INT tailBlock = block - lane->FullBlocks;
+    return lane->Tail + (tailBlock < lane->Blocks - lane->FullBlocks ? tailBlock : 0) * SHA512_BLOCK_SIZE;
+}
+
+#define SHA512_ROR(x, n) ((x) >> (n) | (x) << (64 - (n)))
+
+// The lane states are stored word by word, word i of lane n lives at state[i * stride + n].
+DOTNET_PRIVATE void CompressSha512_Scalar(DOTNET_SPAN_ULONG state, DOTNET_INT stride, DOTNET_READ_ONLY_SPAN_BYTE block) {
+    DOTNET_ULONG w[80];
+
+    for (DOTNET_INT t = 0; t < 16; t++) {
+        w[t] = LoadBigEndian64(block + t * 8);
+    }
+
+    for (DOTNET_INT t = 16; t < 80; t++) {
+        DOTNET_ULONG s0 = SHA512_ROR(w[t - 15], 1) ^ SHA512_ROR(w[t - 15], 8) ^ w[t - 15] >> 7;
+        DOTNET_ULONG s1 = SHA512_ROR(w[t - 2], 19) ^ SHA512_ROR(w[t - 2], 61) ^ w[t - 2] >> 6;
+        w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    DOTNET_ULONG a = state[0], b = state[stride], c = state[stride * 2], d = state[stride * 3], e = state[stride * 4], f = state[stride * 5], g = state[stride * 6], h = state[stride * 7];
+
+    for (DOTNET_INT t = 0; t < 80; t++) {
+        DOTNET_ULONG temp1 = h + (SHA512_ROR(e, 14) ^ SHA512_ROR(e, 18) ^ SHA512_ROR(e, 41)) + ((e & f) ^ (~e & g)) + Sha512RoundConstants[t] + w[t];
+        DOTNET_ULONG temp2 = (SHA512_ROR(a, 28) ^ SHA512_ROR(a, 34) ^ SHA512_ROR(a, 39)) + ((a & b) | (c & (a | b)));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    state[0] += a;
+    state[stride] += b;
+    state[stride * 2] += c;
+    state[stride * 3] += d;
+    state[stride * 4] += e;
+    state[stride * 5] += f;
+    state[stride * 6] += g;
+    state[stride * 7] += h;
+}
+
+#ifdef XENO_NATIVE_X86
+
+#define SHA512_AVX2_ROR(x, n) _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE void CompressSha512Lanes_AVX2(DOTNET_SPAN_ULONG state, DOTNET_INT stride, const DOTNET_BYTE *const *inputs) {
+    __m256i w[16];
+
+    for (DOTNET_INT i = 0; i < 16; i++) {
+        w[i] = _mm256_set_epi64x((long long) LoadBigEndian64(inputs[3] + i * 8), (long long) LoadBigEndian64(inputs[2] + i * 8), (long long) LoadBigEndian64(inputs[1] + i * 8), (long long) LoadBigEndian64(inputs[0] + i * 8));
+    }
+
+    __m256i a = _mm256_loadu_si256((const __m256i *) state), b = _mm256_loadu_si256((const __m256i *) (state + stride)), c = _mm256_loadu_si256((const __m256i *) (state + stride * 2)), d = _mm256_loadu_si256((const __m256i *) (state + stride * 3));
+    __m256i e = _mm256_loadu_si256((const __m256i *) (state + stride * 4)), f = _mm256_loadu_si256((const __m256i *) (state + stride * 5)), g = _mm256_loadu_si256((const __m256i *) (state + stride * 6)), h = _mm256_loadu_si256((const __m256i *) (state + stride * 7));
+
+    for (DOTNET_INT t = 0; t < 80; t++) {
+        if (t >= 16) {
+            __m256i w15 = w[(t - 15) & 15];
+            __m256i w2 = w[(t - 2) & 15];
+
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(SHA512_AVX2_ROR(w15, 1), SHA512_AVX2_ROR(w15, 8)), _mm256_srli_epi64(w15, 7));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(SHA512_AVX2_ROR(w2, 19), SHA512_AVX2_ROR(w2, 61)), _mm256_srli_epi64(w2, 6));
+
+            w[t & 15] = _mm256_add_epi64(_mm256_add_epi64(w[t & 15], s0), _mm256_add_epi64(w[(t - 7) & 15], s1));
+        }
+
+        __m256i sum1 = _mm256_xor_si256(_mm256_xor_si256(SHA512_AVX2_ROR(e, 14), SHA512_AVX2_ROR(e, 18)), SHA512_AVX2_ROR(e, 41));
+        __m256i choose = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i temp1 = _mm256_add_epi64(_mm256_add_epi64(h, sum1), _mm256_add_epi64(choose, _mm256_add_epi64(_mm256_set1_epi64x((long long) Sha512RoundConstants[t]), w[t & 15])));
+
+        __m256i sum0 = _mm256_xor_si256(_mm256_xor_si256(SHA512_AVX2_ROR(a, 28), SHA512_AVX2_ROR(a, 34)), SHA512_AVX2_ROR(a, 39));
+        __m256i majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i temp2 = _mm256_add_epi64(sum0, majority);
+
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi64(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi64(temp1, temp2);
+    }
+
+    _mm256_storeu_si256((__m256i *) state, _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) state), a));
+    _mm256_storeu_si256((__m256i *) (state + stride), _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (state + stride)), b));
+    _mm256_storeu_si256((__m256i *) (state + stride * 2), _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (state + stride * 2)), c));
+    _mm256_storeu_si256((__m256i *) (state + stride * 3), _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (state + stride * 3)), d));
+    _mm256_storeu_si256((__m256i *) (state + stride * 4), _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (state + stride * 4)), e));
+    _mm256_storeu_si256((__m256i *) (state + stride * 5), _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (state + stride * 5)), f));
+    _mm256_storeu_si256((__m256i *) (state + stride * 6), _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (state + stride * 6)), g));
+    _mm256_storeu_si256((__m256i *) (state + stride * 7), _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (state + stride * 7)), h));
+}
+
+XENO_NATIVE_TARGET("avx512f")
+DOTNET_PRIVATE void CompressSha512Lanes_AVX512(DOTNET_SPAN_ULONG state, DOTNET_INT stride, const DOTNET_BYTE *const *inputs) {
+    __m512i w[16];
+
+    for (DOTNET_INT i = 0; i < 16; i++) {
+        w[i] = _mm512_set_epi64((long long) LoadBigEndian64(inputs[7] + i * 8), (long long) LoadBigEndian64(inputs[6] + i * 8), (long long) LoadBigEndian64(inputs[5] + i * 8), (long long) LoadBigEndian64(inputs[4] + i * 8),
+                                (long long) LoadBigEndian64(inputs[3] + i * 8), (long long) LoadBigEndian64(inputs[2] + i * 8), (long long) LoadBigEndian64(inputs[1] + i * 8), (long long) LoadBigEndian64(inputs[0] + i * 8));
+    }
+
+    __m512i a = _mm512_loadu_si512(state), b = _mm512_loadu_si512(state + stride), c = _mm512_loadu_si512(state + stride * 2), d = _mm512_loadu_si512(state + stride * 3);
+    __m512i e = _mm512_loadu_si512(state + stride * 4), f = _mm512_loadu_si512(state + stride * 5), g = _mm512_loadu_si512(state + stride * 6), h = _mm512_loadu_si512(state + stride * 7);
+
+    for (DOTNET_INT t = 0; t < 80; t++) {
+        if (t >= 16) {
+            __m512i w15 = w[(t - 15) & 15];
+            __m512i w2 = w[(t - 2) & 15];
+
+            // 0x96 is a three way xor.
+            __m512i s0 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(w15, 1), _mm512_ror_epi64(w15, 8), _mm512_srli_epi64(w15, 7), 0x96);
+            __m512i s1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(w2, 19), _mm512_ror_epi64(w2, 61), _mm512_srli_epi64(w2, 6), 0x96);
+
+            w[t & 15] = _mm512_add_epi64(_mm512_add_epi64(w[t & 15], s0), _mm512_add_epi64(w[(t - 7) & 15], s1));
+        }
+
+        // 0xCA selects f or g by e, 0xE8 is the bitwise majority of a, b and c.
+        __m512i sum1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(e, 14), _mm512_ror_epi64(e, 18), _mm512_ror_epi64(e, 41), 0x96);
+        __m512i choose = _mm512_ternarylogic_epi64(e, f, g, 0xCA);
+        __m512i temp1 = _mm512_add_epi64(_mm512_add_epi64(h, sum1), _mm512_add_epi64(choose, _mm512_add_epi64(_mm512_set1_epi64((long long) Sha512RoundConstants[t]), w[t & 15])));
+
+        __m512i sum0 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(a, 28), _mm512_ror_epi64(a, 34), _mm512_ror_epi64(a, 39), 0x96);
+        __m512i majority = _mm512_ternarylogic_epi64(a, b, c, 0xE8);
+        __m512i temp2 = _mm512_add_epi64(sum0, majority);
+
+        h = g;
+        g = f;
+        f = e;
+        e = _mm512_add_epi64(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm512_add_epi64(temp1, temp2);
+    }
+
+    _mm512_storeu_si512(state, _mm512_add_epi64(_mm512_loadu_si512(state), a));
+    _mm512_storeu_si512(state + stride, _mm512_add_epi64(_mm512_loadu_si512(state + stride), b));
+    _mm512_storeu_si512(state + stride * 2, _mm512_add_epi64(_mm512_loadu_si512(state + stride * 2), c));
+    _mm512_storeu_si512(state + stride * 3, _mm512_add_epi64(_mm512_loadu_si512(state + stride * 3), d));
+    _mm512_storeu_si512(state + stride * 4, _mm512_add_epi64(_mm512_loadu_si512(state + stride * 4), e));
+    _mm512_storeu_si512(state + stride * 5, _mm512_add_epi64(_mm512_loadu_si512(state + stride * 5), f));
+    _mm512_storeu_si512(state + stride * 6, _mm512_add_epi64(_mm512_loadu_si512(state + stride * 6), g));
+    _mm512_storeu_si512(state + stride * 7, _mm512_add_epi64(_mm512_loadu_si512(state + stride * 7), h));
+}
+
+#endif
+
+// Compresses one block of every lane, the stride must leave room for the lanes rounded up to the kernel width.
+DOTNET_PRIVATE void CompressSha512Lanes(DOTNET_SPAN_ULONG state, DOTNET_INT stride, const DOTNET_BYTE *const *blocks, DOTNET_INT lanes, DOTNET_INT laneCount) {
+    for (DOTNET_INT lane = 0; lane < lanes; lane += laneCount) {
+        const DOTNET_BYTE *groupBlocks[8];
+
+        // A partial group repeats its last lane into state columns that are never read back.
+        for (DOTNET_INT i = 0; i < laneCount; i++) {
+            groupBlocks[i] = blocks[lane + i < lanes ? lane + i : lanes - 1];
+        }
+
+#ifdef XENO_NATIVE_X86
+        if (laneCount == 8) {
+            CompressSha512Lanes_AVX512(state + lane, stride, groupBlocks);
+            continue;
+        }
+
+        if (laneCount == 4) {
+            CompressSha512Lanes_AVX2(state + lane, stride, groupBlocks);
+            continue;
+        }
+#endif
+
+        CompressSha512_Scalar(state + lane, stride, groupBlocks[0]);
+    }
+}
+
+DOTNET_PRIVATE void StoreSha512Digest(DOTNET_READ_ONLY_SPAN_ULONG state, DOTNET_INT stride, DOTNET_SPAN_BYTE destination) {
+    for (DOTNET_INT i = 0; i < 8; i++) {
+        StoreBigEndian64(state[i * stride], destination + i * 8);
+    }
+}
+
+DOTNET_PRIVATE const DOTNET_ULONG KeccakRoundConstants[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000, 0x000000000000808B, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A, 0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800A, 0x800000008000000A, 0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+DOTNET_PRIVATE DOTNET_ULONG LoadLittleEndian64(DOTNET_READ_ONLY_SPAN_BYTE source) {
+    return (DOTNET_ULONG) source[0] | (DOTNET_ULONG) source[1] << 8 | (DOTNET_ULONG) source[2] << 16 | (DOTNET_ULONG) source[3] << 24 |
+           (DOTNET_ULONG) source[4] << 32 | (DOTNET_ULONG) source[5] << 40 | (DOTNET_ULONG) source[6] << 48 | (DOTNET_ULONG) source[7] << 56;
+}
+
+DOTNET_PRIVATE void StoreLittleEndian64(DOTNET_ULONG value, DOTNET_SPAN_BYTE destination) {
+    for (DOTNET_INT i = 0; i < 8; i++) {
+        destination[i] = (DOTNET_BYTE) value;
+        value >>= 8;
+    }
+}
+
+DOTNET_PRIVATE void PrepareSha3_512Lane(SHA3_512_LANE *lane, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength) {
+    // At most 71 bytes are left over, so the 0x06 domain byte and the final 0x80 always fit in one more block.
+    DOTNET_INT remaining = sourceLength % SHA3_512_BLOCK_SIZE;
+
+    lane->Source = source;
+    lane->FullBlocks = sourceLength / SHA3_512_BLOCK_SIZE;
+    lane->Blocks = lane->FullBlocks + 1;
+
+    memcpy(lane->Tail, source + lane->FullBlocks * SHA3_512_BLOCK_SIZE, remaining);
+    memset(lane->Tail + remaining, 0, SHA3_512_BLOCK_SIZE - remaining);
+
+    lane->Tail[remaining] ^= 0x06;
+    lane->Tail[SHA3_512_BLOCK_SIZE - 1] ^= 0x80;
+}
+
+/*
+ * One Keccak-f[1600] round over the words A[x + 5 * y], written once for every vector width.
+ * The rotated words land in E one output row at a time, each row goes through chi as soon as it is complete.
+ */
+#define KECCAK_ROW(E, row, B0, B1, B2, B3, B4) \
+    do { \
+        E[(row) * 5] = KECCAK_CHI(B0, B1, B2); \
+        E[(row) * 5 + 1] = KECCAK_CHI(B1, B2, B3); \
+        E[(row) * 5 + 2] = KECCAK_CHI(B2, B3, B4); \
+        E[(row) * 5 + 3] = KECCAK_CHI(B3, B4, B0); \
+        E[(row) * 5 + 4] = KECCAK_CHI(B4, B0, B1); \
+    } while (0)
+
+#define KECCAK_ROUND(TYPE, A, E, roundConstant) \
+    do { \
+        TYPE C0 = KECCAK_XOR5(A[0], A[5], A[10], A[15], A[20]); \
+        TYPE C1 = KECCAK_XOR5(A[1], A[6], A[11], A[16], A[21]); \
+        TYPE C2 = KECCAK_XOR5(A[2], A[7], A[12], A[17], A[22]); \
+        TYPE C3 = KECCAK_XOR5(A[3], A[8], A[13], A[18], A[23]); \
+        TYPE C4 = KECCAK_XOR5(A[4], A[9], A[14], A[19], A[24]); \
+        TYPE D0 = KECCAK_XOR(C4, KECCAK_ROL(C1, 1)); \
+        TYPE D1 = KECCAK_XOR(C0, KECCAK_ROL(C2, 1)); \
+        TYPE D2 = KECCAK_XOR(C1, KECCAK_ROL(C3, 1)); \
+        TYPE D3 = KECCAK_XOR(C2, KECCAK_ROL(C4, 1)); \
+        TYPE D4 = KECCAK_XOR(C3, KECCAK_ROL(C0, 1)); \
+        TYPE B0 = KECCAK_XOR(A[0], D0), B1 = KECCAK_ROL(KECCAK_XOR(A[6], D1), 44), B2 = KECCAK_ROL(KECCAK_XOR(A[12], D2), 43), B3 = KECCAK_ROL(KECCAK_XOR(A[18], D3), 21), B4 = KECCAK_ROL(KECCAK_XOR(A[24], D4), 14); \
+        KECCAK_ROW(E, 0, B0, B1, B2, B3, B4); \
+        E[0] = KECCAK_XOR(E[0], KECCAK_SET1(roundConstant)); \
+        B0 = KECCAK_ROL(KECCAK_XOR(A[3], D3), 28), B1 = KECCAK_ROL(KECCAK_XOR(A[9], D4), 20), B2 = KECCAK_ROL(KECCAK_XOR(A[10], D0), 3), B3 = KECCAK_ROL(KECCAK_XOR(A[16], D1), 45), B4 = KECCAK_ROL(KECCAK_XOR(A[22], D2), 61); \
+        KECCAK_ROW(E, 1, B0, B1, B2, B3, B4); \
+        B0 = KECCAK_ROL(KECCAK_XOR(A[1], D1), 1), B1 = KECCAK_ROL(KECCAK_XOR(A[7], D2), 6), B2 = KECCAK_ROL(KECCAK_XOR(A[13], D3), 25), B3 = KECCAK_ROL(KECCAK_XOR(A[19], D4), 8), B4 = KECCAK_ROL(KECCAK_XOR(A[20], D0), 18); \
+        KECCAK_ROW(E, 2, B0, B1, B2, B3, B4); \
+        B0 = KECCAK_ROL(KECCAK_XOR(A[4], D4), 27), B1 = KECCAK_ROL(KECCAK_XOR(A[5], D0), 36), B2 = KECCAK_ROL(KECCAK_XOR(A[11], D1), 10), B3 = KECCAK_ROL(KECCAK_XOR(A[17], D2), 15), B4 = KECCAK_ROL(KECCAK_XOR(A[23], D3), 56); \
+        KECCAK_ROW(E, 3, B0, B1, B2, B3, B4); \
+        B0 = KECCAK_ROL(KECCAK_XOR(A[2], D2), 62), B1 = KECCAK_ROL(KECCAK_XOR(A[8], D3), 55), B2 = KECCAK_ROL(KECCAK_XOR(A[14], D4), 39), B3 = KECCAK_ROL(KECCAK_XOR(A[15], D0), 41), B4 = KECCAK_ROL(KECCAK_XOR(A[21], D1), 2); \
+        KECCAK_ROW(E, 4, B0, B1, B2, B3, B4); \
+    } while (0)
+
+// Permutes the state, then hashes its own 64 byte digest rounds - 1 more times. Rounds are processed in pairs so A and E swap roles without copies.
+#define KECCAK_PERMUTE(TYPE, A, rounds) \
+    do { \
+        TYPE E[25]; \
+        for (DOTNET_INT hash = 0; hash < (rounds); hash++) { \
+            if (hash > 0) { \
+                A[8] = KECCAK_SET1(0x8000000000000006); \
+                for (DOTNET_INT word = 9; word < 25; word++) { \
+                    A[word] = KECCAK_SET1(0); \
+                } \
+            } \
+            for (DOTNET_INT round = 0; round < 24; round += 2) { \
+                KECCAK_ROUND(TYPE, A, E, KeccakRoundConstants[round]); \
+                KECCAK_ROUND(TYPE, E, A, KeccakRoundConstants[round + 1]); \
+            } \
+        } \
+    } while (0)
+
+#define KECCAK_XOR(a, b) ((a) ^ (b))
+#define KECCAK_XOR5(a, b, c, d, e) ((a) ^ (b) ^ (c) ^ (d) ^ (e))
+#define KECCAK_ROL(x, n) ((x) << (n) | (x) >> (64 - (n)))
+#define KECCAK_CHI(a, b, c) ((a) ^ (~(b) & (c)))
+#define KECCAK_SET1(x) ((DOTNET_ULONG) (x))
+
+// The lane states are stored word by word, word i of lane n lives at state[i * stride + n].
+DOTNET_PRIVATE void PermuteKeccak_Scalar(DOTNET_SPAN_ULONG state, DOTNET_INT stride, DOTNET_INT rounds) {
+    DOTNET_ULONG A[25];
+
+    for (DOTNET_INT i = 0; i < 25; i++) {
+        A[i] = state[i * stride];
+    }
+
+    KECCAK_PERMUTE(DOTNET_ULONG, A, rounds);
+
+    for (DOTNET_INT i = 0; i < 25; i++) {
+        state[i * stride] = A[i];
+    }
+}
+
+#undef KECCAK_XOR
+#undef KECCAK_XOR5
+#undef KECCAK_ROL
+#undef KECCAK_CHI
+#undef KECCAK_SET1
+
+#ifdef XENO_NATIVE_X86
+
+#define KECCAK_XOR(a, b) _mm256_xor_si256(a, b)
+#define KECCAK_XOR5(a, b, c, d, e) _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(c, d)), e)
+#define KECCAK_ROL(x, n) _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - (n)))
+#define KECCAK_CHI(a, b, c) _mm256_xor_si256(a, _mm256_andnot_si256(b, c))
+#define KECCAK_SET1(x) _mm256_set1_epi64x((long long) (x))
+
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE void PermuteKeccakLanes_AVX2(DOTNET_SPAN_ULONG state, DOTNET_INT stride, DOTNET_INT rounds) {
+    __m256i A[25];
+
+    for (DOTNET_INT i = 0; i < 25; i++) {
+        A[i] = _mm256_loadu_si256((const __m256i *) (state + i * stride));
+    }
+
+    KECCAK_PERMUTE(__m256i, A, rounds);
+
+    for (DOTNET_INT i = 0; i < 25; i++) {
+        _mm256_storeu_si256((__m256i *) (state + i * stride), A[i]);
+    }
+}
+
+#undef KECCAK_XOR
+#undef KECCAK_XOR5
+#undef KECCAK_ROL
+#undef KECCAK_CHI
+#undef KECCAK_SET1
+
+// 0x96 is a three way xor, 0xD2 is a ^ (~b & c).
+#define KECCAK_XOR(a, b) _mm512_xor_si512(a, b)
+#define KECCAK_XOR5(a, b, c, d, e) _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(a, b, c, 0x96), d, e, 0x96)
+#define KECCAK_ROL(x, n) _mm512_rol_epi64(x, n)
+#define KECCAK_CHI(a, b, c) _mm512_ternarylogic_epi64(a, b, c, 0xD2)
+#define KECCAK_SET1(x) _mm512_set1_epi64((long long) (x))
+
+XENO_NATIVE_TARGET("avx512f")
+DOTNET_PRIVATE void PermuteKeccakLanes_AVX512(DOTNET_SPAN_ULONG state, DOTNET_INT stride, DOTNET_INT rounds) {
+    __m512i A[25];
+
+    for (DOTNET_INT i = 0; i < 25; i++) {
+        A[i] = _mm512_loadu_si512(state + i * stride);
+    }
+
+    KECCAK_PERMUTE(__m512i, A, rounds);
+
+    for (DOTNET_INT i = 0; i < 25; i++) {
+        _mm512_storeu_si512(state + i * stride, A[i]);
     }
+}
+
+#undef KECCAK_XOR
+#undef KECCAK_XOR5
+#undef KECCAK_ROL
+#undef KECCAK_CHI
+#undef KECCAK_SET1
+
+#endif
 
+// Permutes every lane, the stride must leave room for the lanes rounded up to the kernel width.
+DOTNET_PRIVATE void PermuteKeccakLanes(DOTNET_SPAN_ULONG state, DOTNET_INT stride, DOTNET_INT lanes, DOTNET_INT laneCount, DOTNET_INT rounds) {
+    DOTNET_INT lane = 0;
+
+    // A short tail steps down to a narrower kernel, a single message is faster in the scalar one than in an 8 lane register.
+    while (lane < lanes) {
+#ifdef XENO_NATIVE_X86
+        if (laneCount == 8 && lanes - lane > 4) {
+            PermuteKeccakLanes_AVX512(state + lane, stride, rounds);
+            lane += 8;
+            continue;
+        }
+
+        if (laneCount >= 4 && lanes - lane > 1) {
+            PermuteKeccakLanes_AVX2(state + lane, stride, rounds);
+            lane += 4;
+            continue;
+        }
+#endif
+
+        PermuteKeccak_Scalar(state + lane, stride, rounds);
+        lane++;
+    }
+}
+
+DOTNET_INT MessageDigestUtility_ComputeHash_EVP_MD_CTX(EVP_MD_CTX *context, const EVP_MD *type, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    // A NULL type reuses the digest the context was last initialized with.
     if (!EVP_DigestInit_ex(context, type, NULL)) {
-        EVP_MD_CTX_free(context);
         return 0;
     }
 
     if (!EVP_DigestUpdate(context, source, sourceLength)) {
-        EVP_MD_CTX_free(context);
         return 0;
     }
 
     DOTNET_UINT bytesWritten;
 
     if (!EVP_DigestFinal_ex(context, destination, &bytesWritten)) {
-        EVP_MD_CTX_free(context);
         return 0;
     }
 
-    EVP_MD_CTX_free(context);
-
     return (DOTNET_INT) bytesWritten;
 }
 
+DOTNET_INT MessageDigestUtility_ComputeHash_EVP_MD(const EVP_MD *type, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    // Pooled contexts remember their last digest, so a NULL type must not fall through to it.
+    if (type == NULL) {
+        return 0;
+    }
+
+    EVP_MD_CTX *context = CryptographyUtility_RentMessageDigestContext();
+
+    if (context == NULL) {
+        return 0;
+    }
+
+    DOTNET_INT bytesWritten = MessageDigestUtility_ComputeHash_EVP_MD_CTX(context, type, source, sourceLength, destination);
+
+    CryptographyUtility_ReturnMessageDigestContext(context);
+
+    return bytesWritten;
+}
+
 inline DOTNET_PUBLIC DOTNET_INT MessageDigestUtility_ComputeSha2_256Hash(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha256(), source, sourceLength, destination);
+    return MessageDigestUtility_ComputeHash_EVP_MD(CryptographyUtility_GetMessageDigest(CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_256), source, sourceLength, destination);
 }
 
 inline DOTNET_PUBLIC DOTNET_INT MessageDigestUtility_ComputeSha2_512Hash(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha512(), source, sourceLength, destination);
+    return MessageDigestUtility_ComputeHash_EVP_MD(CryptographyUtility_GetMessageDigest(CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_512), source, sourceLength, destination);
 }
 
 inline DOTNET_PUBLIC DOTNET_INT MessageDigestUtility_ComputeSha3_512Hash(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return MessageDigestUtility_ComputeHash_EVP_MD(EVP_sha3_512(), source, sourceLength, destination);
+    return MessageDigestUtility_ComputeHash_EVP_MD(CryptographyUtility_GetMessageDigest(CRYPTOGRAPHY_MESSAGE_DIGEST_SHA3_512), source, sourceLength, destination);
+}
+
+DOTNET_INT MessageDigestUtility_GetSha2_512LaneCount() {
+#ifdef XENO_NATIVE_X86
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX512F)) {
+        return 8;
+    }
+
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX2)) {
+        return 4;
+    }
+#endif
+
+    return 1;
+}
+
+DOTNET_STRING MessageDigestUtility_GetSha2_512KernelName() {
+    switch (MessageDigestUtility_GetSha2_512LaneCount()) {
+        case 8:
+            return "avx512-x8";
+
+        case 4:
+            return "avx2-x4";
+
+        default:
+            return "scalar";
+    }
+}
+
+DOTNET_BOOL MessageDigestUtility_ComputeSha2_512HashBatch(EVP_MD_CTX *context, const DOTNET_BYTE *const *sources, DOTNET_READ_ONLY_SPAN_INT sourceLengths, DOTNET_BYTE *const *destinations, DOTNET_INT count) {
+    if (sources == NULL || sourceLengths == NULL || destinations == NULL || count < 0) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_INT laneCount = MessageDigestUtility_GetSha2_512LaneCount();
+
+    if (laneCount > 1 && count > 1) {
+        SHA512_LANE lanes[8];
+        DOTNET_ULONG state[8][8];
+        const DOTNET_BYTE *blocks[8];
+
+        for (DOTNET_INT i = 0; i < count; i += laneCount) {
+            DOTNET_INT groupLanes = count - i < laneCount ? count - i : laneCount;
+            DOTNET_INT groupBlocks = 0;
+
+            for (DOTNET_INT word = 0; word < 8; word++) {
+                for (DOTNET_INT lane = 0; lane < 8; lane++) {
+                    state[word][lane] = Sha512InitialState[word];
+                }
+            }
+
+            for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+                if (sourceLengths[i + lane] < 0) {
+                    return DOTNET_FALSE;
+                }
+
+                PrepareSha512Lane(&lanes[lane], sources[i + lane], sourceLengths[i + lane]);
+
+                if (lanes[lane].Blocks > groupBlocks) {
+                    groupBlocks = lanes[lane].Blocks;
+                }
+            }
+
+            for (DOTNET_INT block = 0; block < groupBlocks; block++) {
+                for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+                    blocks[lane] = GetSha512LaneBlock(&lanes[lane], block);
+                }
+
+                CompressSha512Lanes(state[0], 8, blocks, groupLanes, laneCount);
+
+                // Each digest is captured at its own last block, shorter messages keep hashing their tail afterwards.
+                for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+                    if (lanes[lane].Blocks == block + 1) {
+                        StoreSha512Digest(state[0] + lane, 8, destinations[i + lane]);
+                    }
+                }
+            }
+        }
+
+        return DOTNET_TRUE;
+    }
+
+    if (context == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        if (!MessageDigestUtility_ComputeHash_EVP_MD_CTX(context, CryptographyUtility_GetMessageDigest(CRYPTOGRAPHY_MESSAGE_DIGEST_SHA2_512), sources[i], sourceLengths[i], destinations[i])) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    return DOTNET_TRUE;
+}
+
+
+DOTNET_BOOL MessageDigestUtility_Sha2_512Lanes_Init(SHA512_LANES_CTX *context, DOTNET_INT lanes) {
+    if (context == NULL || lanes <= 0 || lanes > SHA512_LANES_MAX_LANES) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT word = 0; word < 8; word++) {
+        for (DOTNET_INT lane = 0; lane < SHA512_LANES_MAX_LANES; lane++) {
+            context->State[word][lane] = Sha512InitialState[word];
+        }
+    }
+
+    context->BufferLength = 0;
+    context->Length = 0;
+    context->Lanes = lanes;
+    context->LaneCount = MessageDigestUtility_GetSha2_512LaneCount();
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_BOOL MessageDigestUtility_Sha2_512Lanes_Update(SHA512_LANES_CTX *context, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength) {
+    if (context == NULL || context->Lanes <= 0 || context->Lanes > SHA512_LANES_MAX_LANES || sources == NULL || sourceLength < 0) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_INT lanes = context->Lanes;
+    DOTNET_INT offset = 0;
+    const DOTNET_BYTE *blocks[SHA512_LANES_MAX_LANES];
+
+    context->Length += (DOTNET_ULONG) sourceLength;
+
+    if (context->BufferLength > 0) {
+        DOTNET_INT length = SHA512_BLOCK_SIZE - context->BufferLength < sourceLength ? SHA512_BLOCK_SIZE - context->BufferLength : sourceLength;
+
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            memcpy(context->Buffer[lane] + context->BufferLength, sources[lane], length);
+            blocks[lane] = context->Buffer[lane];
+        }
+
+        context->BufferLength += length;
+        offset = length;
+
+        if (context->BufferLength < SHA512_BLOCK_SIZE) {
+            return DOTNET_TRUE;
+        }
+
+        CompressSha512Lanes(context->State[0], SHA512_LANES_MAX_LANES, blocks, lanes, context->LaneCount);
+        context->BufferLength = 0;
+    }
+
+    for (; sourceLength - offset >= SHA512_BLOCK_SIZE; offset += SHA512_BLOCK_SIZE) {
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            blocks[lane] = sources[lane] + offset;
+        }
+
+        CompressSha512Lanes(context->State[0], SHA512_LANES_MAX_LANES, blocks, lanes, context->LaneCount);
+    }
+
+    if (offset < sourceLength) {
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            memcpy(context->Buffer[lane], sources[lane] + offset, sourceLength - offset);
+        }
+
+        context->BufferLength = sourceLength - offset;
+    }
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_BOOL MessageDigestUtility_Sha2_512Lanes_Final(SHA512_LANES_CTX *context, DOTNET_BYTE *const *destinations) {
+    if (context == NULL || context->Lanes <= 0 || context->Lanes > SHA512_LANES_MAX_LANES || destinations == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    DOTNET_INT lanes = context->Lanes;
+    DOTNET_INT length = context->BufferLength;
+    const DOTNET_BYTE *blocks[SHA512_LANES_MAX_LANES];
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        context->Buffer[lane][length] = 0x80;
+        memset(context->Buffer[lane] + length + 1, 0, SHA512_BLOCK_SIZE - length - 1);
+        blocks[lane] = context->Buffer[lane];
+    }
+
+    // The 128-bit bit length needs the last 16 bytes of a block, it spills into one more block when they are taken.
+    if (length + 1 + 16 > SHA512_BLOCK_SIZE) {
+        CompressSha512Lanes(context->State[0], SHA512_LANES_MAX_LANES, blocks, lanes, context->LaneCount);
+
+        for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+            memset(context->Buffer[lane], 0, SHA512_BLOCK_SIZE);
+        }
+    }
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        StoreBigEndian64(context->Length >> 61, context->Buffer[lane] + SHA512_BLOCK_SIZE - 16);
+        StoreBigEndian64(context->Length << 3, context->Buffer[lane] + SHA512_BLOCK_SIZE - 8);
+    }
+
+    CompressSha512Lanes(context->State[0], SHA512_LANES_MAX_LANES, blocks, lanes, context->LaneCount);
+
+    for (DOTNET_INT lane = 0; lane < lanes; lane++) {
+        StoreSha512Digest(context->State[0] + lane, SHA512_LANES_MAX_LANES, destinations[lane]);
+    }
+
+    return DOTNET_TRUE;
+}
+DOTNET_INT MessageDigestUtility_GetSha3_512LaneCount() {
+#ifdef XENO_NATIVE_X86
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX512F)) {
+        return 8;
+    }
+
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX2)) {
+        return 4;
+    }
+#endif
+
+    return 1;
+}
+
+DOTNET_STRING MessageDigestUtility_GetSha3_512KernelName() {
+    switch (MessageDigestUtility_GetSha3_512LaneCount()) {
+        case 8:
+            return "avx512-x8";
+
+        case 4:
+            return "avx2-x4";
+
+        default:
+            return "scalar";
+    }
+}
+
+DOTNET_BOOL MessageDigestUtility_ComputeSha3_512HashBatch(const DOTNET_BYTE *const *sources, DOTNET_READ_ONLY_SPAN_INT sourceLengths, DOTNET_BYTE *const *destinations, DOTNET_INT count, DOTNET_INT rounds) {
+    if (sources == NULL || sourceLengths == NULL || destinations == NULL || count < 0 || rounds < 0) {
+        return DOTNET_FALSE;
+    }
+
+    for (DOTNET_INT i = 0; i < count; i++) {
+        if (sourceLengths[i] < 0) {
+            return DOTNET_FALSE;
+        }
+    }
+
+    if (rounds == 0) {
+        return DOTNET_TRUE;
+    }
+
+    DOTNET_INT laneCount = MessageDigestUtility_GetSha3_512LaneCount();
+    SHA3_512_LANE lanes[8];
+    DOTNET_ULONG state[25][8];
+    DOTNET_ULONG digests[8][8];
+
+    for (DOTNET_INT i = 0; i < count; i += laneCount) {
+        DOTNET_INT groupLanes = count - i < laneCount ? count - i : laneCount;
+        DOTNET_INT groupBlocks = 0;
+
+        memset(state, 0, sizeof(state));
+
+        for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+            PrepareSha3_512Lane(&lanes[lane], sources[i + lane], sourceLengths[i + lane]);
+
+            if (lanes[lane].Blocks > groupBlocks) {
+                groupBlocks = lanes[lane].Blocks;
+            }
+        }
+
+        for (DOTNET_INT block = 0; block < groupBlocks; block++) {
+            for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+                // Lanes that are already finished absorb nothing more, their digest was captured at their own last block.
+                if (block >= lanes[lane].Blocks) {
+                    continue;
+                }
+
+                DOTNET_READ_ONLY_SPAN_BYTE data = block < lanes[lane].FullBlocks ? lanes[lane].Source + block * SHA3_512_BLOCK_SIZE : lanes[lane].Tail;
+
+                for (DOTNET_INT word = 0; word < SHA3_512_BLOCK_SIZE / 8; word++) {
+                    state[word][lane] ^= LoadLittleEndian64(data + word * 8);
+                }
+            }
+
+            PermuteKeccakLanes(state[0], 8, groupLanes, laneCount, 1);
+
+            for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+                if (lanes[lane].Blocks == block + 1) {
+                    for (DOTNET_INT word = 0; word < 8; word++) {
+                        digests[word][lane] = state[word][lane];
+                    }
+                }
+            }
+        }
+
+        // The remaining rounds hash 64 byte digests, every lane is in step again and they run back to back in the kernel.
+        if (rounds > 1) {
+            memset(state, 0, sizeof(state));
+            memcpy(state, digests, sizeof(digests));
+
+            for (DOTNET_INT lane = 0; lane < 8; lane++) {
+                state[8][lane] = 0x8000000000000006;
+            }
+
+            PermuteKeccakLanes(state[0], 8, groupLanes, laneCount, rounds - 1);
+            memcpy(digests, state, sizeof(digests));
+        }
+
+        for (DOTNET_INT lane = 0; lane < groupLanes; lane++) {
+            for (DOTNET_INT word = 0; word < 8; word++) {
+                StoreLittleEndian64(digests[word][lane], destinations[i + lane] + word * 8);
+            }
+        }
+    }
+
+    return DOTNET_TRUE;
 }
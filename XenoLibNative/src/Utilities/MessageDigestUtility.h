@@ -4,8 +4,40 @@
 #include "global.h"
 #include "openssl/evp.h"
 
+#define SHA512_BLOCK_SIZE 128
+#define SHA512_DIGEST_SIZE 64
+#define SHA512_LANES_MAX_LANES 16
+#define SHA3_512_BLOCK_SIZE 72
+
+// Hashes up to 16 messages of the same length in lock step, the data can arrive in pieces of any size.
+typedef struct SHA512_LANES_CTX {
+    DOTNET_ULONG State[8][SHA512_LANES_MAX_LANES];
+    DOTNET_BYTE Buffer[SHA512_LANES_MAX_LANES][SHA512_BLOCK_SIZE];
+    DOTNET_INT BufferLength;
+    DOTNET_ULONG Length;
+    DOTNET_INT Lanes;
+    DOTNET_INT LaneCount;
+} SHA512_LANES_CTX;
+
+DOTNET_INT MessageDigestUtility_ComputeHash_EVP_MD_CTX(EVP_MD_CTX *context, const EVP_MD *type, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
+DOTNET_INT MessageDigestUtility_ComputeHash_EVP_MD(const EVP_MD *type, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
+
 DOTNET_INT MessageDigestUtility_ComputeSha2_256Hash(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
 DOTNET_INT MessageDigestUtility_ComputeSha2_512Hash(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
 DOTNET_INT MessageDigestUtility_ComputeSha3_512Hash(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
 
+DOTNET_INT MessageDigestUtility_GetSha2_512LaneCount(void);
+DOTNET_STRING MessageDigestUtility_GetSha2_512KernelName(void);
+DOTNET_BOOL MessageDigestUtility_ComputeSha2_512HashBatch(EVP_MD_CTX *context, const DOTNET_BYTE *const *sources, DOTNET_READ_ONLY_SPAN_INT sourceLengths, DOTNET_BYTE *const *destinations, DOTNET_INT count);
+
+DOTNET_INT MessageDigestUtility_GetSha3_512LaneCount(void);
+DOTNET_STRING MessageDigestUtility_GetSha3_512KernelName(void);
+
+// Every round after the first hashes the previous 64 byte digest again, a destination may be its own source.
+DOTNET_BOOL MessageDigestUtility_ComputeSha3_512HashBatch(const DOTNET_BYTE *const *sources, DOTNET_READ_ONLY_SPAN_INT sourceLengths, DOTNET_BYTE *const *destinations, DOTNET_INT count, DOTNET_INT rounds);
+
+DOTNET_BOOL MessageDigestUtility_Sha2_512Lanes_Init(SHA512_LANES_CTX *context, DOTNET_INT lanes);
+DOTNET_BOOL MessageDigestUtility_Sha2_512Lanes_Update(SHA512_LANES_CTX *context, const DOTNET_BYTE *const *sources, DOTNET_INT sourceLength);
+DOTNET_BOOL MessageDigestUtility_Sha2_512Lanes_Final(SHA512_LANES_CTX *context, DOTNET_BYTE *const *destinations);
+
 #endif
@@ -0,0 +1,422 @@
+#include "RandomNumberGeneratorUtility.h"
+#include "CpuDispatchUtility.h"
+#include "openssl/rand.h"
+
+#if defined(XENO_NATIVE_X86)
+#include <immintrin.h>
+#elif defined(XENO_NATIVE_ARM64)
+#include <arm_neon.h>
+#endif
+
+inline DOTNET_PRIVATE DOTNET_ULONG RotateLeft(DOTNET_ULONG value, DOTNET_INT count) {
+    return value << count | value >> (64 - count);
+}
+
+DOTNET_PRIVATE DOTNET_INT GetDigitCount(DOTNET_LONG value) {
+    DOTNET_INT count = value < 0 ? 2 : 1;
+    DOTNET_ULONG absoluteValue = value < 0 ? (DOTNET_ULONG) 0 - (DOTNET_ULONG) value : (DOTNET_ULONG) value;
+
+    while (absoluteValue >= 10) {
+        absoluteValue /= 10;
+        count++;
+    }
+
+    return count;
+}
+
+DOTNET_PRIVATE DOTNET_LONG GetRandomBetweenSize(RANDOM_NUMBER_GENERATOR *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue) {
+    // Same mapping as the managed randomizer: one random byte scaled across the range.
+    DOTNET_BYTE randomIndex = (DOTNET_BYTE) (RandomNumberGeneratorUtility_NextULong(generator) >> 56);
+    DOTNET_DOUBLE multiplier = randomIndex / 255.0 - 0.00000000001;
+
+    if (multiplier < 0) {
+        multiplier = 0;
+    }
+
+    return minimumValue + (DOTNET_LONG) (multiplier * (DOTNET_DOUBLE) (maximumValue - minimumValue + 1));
+}
+
+DOTNET_BOOL RandomNumberGeneratorUtility_Initialize(RANDOM_NUMBER_GENERATOR *generator) {
+    if (generator == NULL || RAND_bytes((unsigned char *) generator->State, sizeof(generator->State)) != 1) {
+        return DOTNET_FALSE;
+    }
+
+    // An all zero state would only ever produce zeros.
+    if ((generator->State[0] | generator->State[1] | generator->State[2] | generator->State[3]) == 0) {
+        generator->State[0] = 0x9E3779B97F4A7C15;
+    }
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_ULONG RandomNumberGeneratorUtility_NextULong(RANDOM_NUMBER_GENERATOR *generator) {
+    DOTNET_ULONG *state = generator->State;
+    DOTNET_ULONG result = RotateLeft(state[1] * 5, 7) * 9;
+    DOTNET_ULONG temp = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= temp;
+    state[3] = RotateLeft(state[3], 45);
+
+    return result;
+}
+
+DOTNET_LONG RandomNumberGeneratorUtility_GetRandomBetween(RANDOM_NUMBER_GENERATOR *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue) {
+    DOTNET_ULONG range = (DOTNET_ULONG) maximumValue - (DOTNET_ULONG) minimumValue;
+
+    if (range == 0) {
+        return minimumValue;
+    }
+
+    // Values above the range are rejected, the mask keeps the rejection rate under one half.
+    DOTNET_ULONG mask = range;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    mask |= mask >> 32;
+
+    DOTNET_ULONG result;
+
+    do {
+        result = RandomNumberGeneratorUtility_NextULong(generator) & mask;
+    } while (result > range);
+
+    return (DOTNET_LONG) ((DOTNET_ULONG) minimumValue + result);
+}
+
+DOTNET_LONG RandomNumberGeneratorUtility_GetBiasRandomBetween(RANDOM_NUMBER_GENERATOR *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue) {
+    if (maximumValue <= minimumValue) {
+        return minimumValue;
+    }
+
+    // Digits are drawn one at a time, so the digit count is only reachable for ranges that never go below zero.
+    if (minimumValue < 0) {
+        return RandomNumberGeneratorUtility_GetRandomBetween(generator, minimumValue, maximumValue);
+    }
+
+    // Picks a digit count between the minimum and a random value within the range, then draws each digit uniformly.
+    DOTNET_INT minimumValueLength = GetDigitCount(minimumValue);
+    DOTNET_INT maximumValueLength = GetDigitCount(GetRandomBetweenSize(generator, minimumValue, maximumValue));
+    DOTNET_INT randomLength = (DOTNET_INT) GetRandomBetweenSize(generator, minimumValueLength, maximumValueLength);
+
+    DOTNET_ULONG result;
+
+    do {
+        result = 0;
+
+        for (DOTNET_INT i = 0; i < randomLength; i++) {
+            result = result * 10 + (DOTNET_ULONG) GetRandomBetweenSize(generator, 0, 9);
+        }
+    } while (result < (DOTNET_ULONG) minimumValue || result > (DOTNET_ULONG) maximumValue);
+
+    return (DOTNET_LONG) result;
+}
+
+DOTNET_PRIVATE void FillLanes_Scalar(DOTNET_ULONG state[][RANDOM_NUMBER_GENERATOR_LANE_COUNT], DOTNET_SPAN_ULONG output, DOTNET_INT steps) {
+    for (DOTNET_INT i = 0; i < steps; i++) {
+        for (DOTNET_INT lane = 0; lane < RANDOM_NUMBER_GENERATOR_LANE_COUNT; lane++) {
+            DOTNET_ULONG temp = state[1][lane] << 17;
+
+            output[i * RANDOM_NUMBER_GENERATOR_LANE_COUNT + lane] = RotateLeft(state[1][lane] * 5, 7) * 9;
+
+            state[2][lane] ^= state[0][lane];
+            state[3][lane] ^= state[1][lane];
+            state[1][lane] ^= state[2][lane];
+            state[0][lane] ^= state[3][lane];
+            state[2][lane] ^= temp;
+            state[3][lane] = RotateLeft(state[3][lane], 45);
+        }
+    }
+}
+
+#if defined(XENO_NATIVE_X86)
+
+// There is no 64-bit multiply before avx512, * 5 and * 9 are a shift and an add.
+XENO_NATIVE_TARGET("avx2")
+DOTNET_PRIVATE void FillLanes_AVX2(DOTNET_ULONG state[][RANDOM_NUMBER_GENERATOR_LANE_COUNT], DOTNET_SPAN_ULONG output, DOTNET_INT steps) {
+    __m256i s0 = _mm256_loadu_si256((const __m256i *) state[0]);
+    __m256i s1 = _mm256_loadu_si256((const __m256i *) state[1]);
+    __m256i s2 = _mm256_loadu_si256((const __m256i *) state[2]);
+    __m256i s3 = _mm256_loadu_si256((const __m256i *) state[3]);
+
+    for (DOTNET_INT i = 0; i < steps; i++) {
+        __m256i result = _mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2));
+        result = _mm256_or_si256(_mm256_slli_epi64(result, 7), _mm256_srli_epi64(result, 57));
+        result = _mm256_add_epi64(result, _mm256_slli_epi64(result, 3));
+
+        _mm256_storeu_si256((__m256i *) (output + i * RANDOM_NUMBER_GENERATOR_LANE_COUNT), result);
+
+        __m256i temp = _mm256_slli_epi64(s1, 17);
+
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, temp);
+        s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+    }
+
+    _mm256_storeu_si256((__m256i *) state[0], s0);
+    _mm256_storeu_si256((__m256i *) state[1], s1);
+    _mm256_storeu_si256((__m256i *) state[2], s2);
+    _mm256_storeu_si256((__m256i *) state[3], s3);
+}
+
+#elif defined(XENO_NATIVE_ARM64)
+
+DOTNET_PRIVATE void FillLanes_NEON(DOTNET_ULONG state[][RANDOM_NUMBER_GENERATOR_LANE_COUNT], DOTNET_SPAN_ULONG output, DOTNET_INT steps) {
+    // Lanes 0-1 and 2-3 are kept in separate registers.
+    for (DOTNET_INT half = 0; half < RANDOM_NUMBER_GENERATOR_LANE_COUNT; half += 2) {
+        uint64x2_t s0 = vld1q_u64(state[0] + half);
+        uint64x2_t s1 = vld1q_u64(state[1] + half);
+        uint64x2_t s2 = vld1q_u64(state[2] + half);
+        uint64x2_t s3 = vld1q_u64(state[3] + half);
+
+        for (DOTNET_INT i = 0; i < steps; i++) {
+            uint64x2_t result = vaddq_u64(s1, vshlq_n_u64(s1, 2));
+            result = vorrq_u64(vshlq_n_u64(result, 7), vshrq_n_u64(result, 57));
+            result = vaddq_u64(result, vshlq_n_u64(result, 3));
+
+            vst1q_u64(output + i * RANDOM_NUMBER_GENERATOR_LANE_COUNT + half, result);
+
+            uint64x2_t temp = vshlq_n_u64(s1, 17);
+
+            s2 = veorq_u64(s2, s0);
+            s3 = veorq_u64(s3, s1);
+            s1 = veorq_u64(s1, s2);
+            s0 = veorq_u64(s0, s3);
+            s2 = veorq_u64(s2, temp);
+            s3 = vorrq_u64(vshlq_n_u64(s3, 45), vshrq_n_u64(s3, 19));
+        }
+
+        vst1q_u64(state[0] + half, s0);
+        vst1q_u64(state[1] + half, s1);
+        vst1q_u64(state[2] + half, s2);
+        vst1q_u64(state[3] + half, s3);
+    }
+}
+
+#endif
+
+typedef void (*RANDOM_NUMBER_GENERATOR_LANES_FILL)(DOTNET_ULONG state[][RANDOM_NUMBER_GENERATOR_LANE_COUNT], DOTNET_SPAN_ULONG output, DOTNET_INT steps);
+
+typedef struct RANDOM_NUMBER_GENERATOR_KERNELS {
+    DOTNET_STRING Name;
+    RANDOM_NUMBER_GENERATOR_LANES_FILL FillLanes;
+} RANDOM_NUMBER_GENERATOR_KERNELS;
+
+DOTNET_PRIVATE const RANDOM_NUMBER_GENERATOR_KERNELS ScalarKernels = {"scalar", FillLanes_Scalar};
+
+#if defined(XENO_NATIVE_X86)
+DOTNET_PRIVATE const RANDOM_NUMBER_GENERATOR_KERNELS Avx2Kernels = {"avx2", FillLanes_AVX2};
+#elif defined(XENO_NATIVE_ARM64)
+DOTNET_PRIVATE const RANDOM_NUMBER_GENERATOR_KERNELS NeonKernels = {"neon", FillLanes_NEON};
+#endif
+
+DOTNET_PRIVATE const RANDOM_NUMBER_GENERATOR_KERNELS *Kernels = NULL;
+
+DOTNET_PRIVATE const RANDOM_NUMBER_GENERATOR_KERNELS *GetKernels() {
+    const RANDOM_NUMBER_GENERATOR_KERNELS *kernels = __atomic_load_n(&Kernels, __ATOMIC_ACQUIRE);
+
+    if (kernels != NULL) {
+        return kernels;
+    }
+
+    kernels = &ScalarKernels;
+
+#if defined(XENO_NATIVE_X86)
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_AVX2)) {
+        kernels = &Avx2Kernels;
+    }
+#elif defined(XENO_NATIVE_ARM64)
+    if (CpuDispatchUtility_HasFeatures(CPU_DISPATCH_FEATURE_NEON)) {
+        kernels = &NeonKernels;
+    }
+#endif
+
+    __atomic_store_n(&Kernels, kernels, __ATOMIC_RELEASE);
+
+    return kernels;
+}
+
+DOTNET_PRIVATE DOTNET_ULONG NextSplitMix64(DOTNET_ULONG *seed) {
+    DOTNET_ULONG result = *seed += 0x9E3779B97F4A7C15;
+    result = (result ^ result >> 30) * 0xBF58476D1CE4E5B9;
+    result = (result ^ result >> 27) * 0x94D049BB133111EB;
+    return result ^ result >> 31;
+}
+
+DOTNET_PRIVATE DOTNET_ULONG NextBufferedULong(RANDOM_NUMBER_GENERATOR_LANES *generator) {
+    if (generator->BufferIndex == RANDOM_NUMBER_GENERATOR_LANES_BUFFER_LENGTH) {
+        GetKernels()->FillLanes(generator->State, generator->Buffer, RANDOM_NUMBER_GENERATOR_LANES_BUFFER_LENGTH / RANDOM_NUMBER_GENERATOR_LANE_COUNT);
+        generator->BufferIndex = 0;
+    }
+
+    return generator->Buffer[generator->BufferIndex++];
+}
+
+DOTNET_PRIVATE DOTNET_BYTE NextBufferedByte(RANDOM_NUMBER_GENERATOR_LANES *generator) {
+    // The bias draws only need a byte each, the top byte first like the single stream generator.
+    if (generator->BytesLength == 0) {
+        generator->Bytes = NextBufferedULong(generator);
+        generator->BytesLength = 8;
+    }
+
+    DOTNET_BYTE result = (DOTNET_BYTE) (generator->Bytes >> 56);
+
+    generator->Bytes <<= 8;
+    generator->BytesLength--;
+
+    return result;
+}
+
+DOTNET_PRIVATE DOTNET_LONG GetBufferedRandomBetweenSize(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue) {
+    DOTNET_DOUBLE multiplier = NextBufferedByte(generator) / 255.0 - 0.00000000001;
+
+    if (multiplier < 0) {
+        multiplier = 0;
+    }
+
+    return minimumValue + (DOTNET_LONG) (multiplier * (DOTNET_DOUBLE) (maximumValue - minimumValue + 1));
+}
+
+inline DOTNET_PRIVATE DOTNET_ULONG GetBufferedRandomDigit(RANDOM_NUMBER_GENERATOR_LANES *generator) {
+    // Same as GetBufferedRandomBetweenSize(generator, 0, 9) without the floating point: the epsilon only matters when 10 * byte is a multiple of 255.
+    DOTNET_ULONG randomIndex = NextBufferedByte(generator);
+    return randomIndex == 0 ? 0 : (randomIndex * 10 - 1) / 255;
+}
+
+DOTNET_BOOL RandomNumberGeneratorUtility_InitializeLanes(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_ULONG seed) {
+    if (generator == NULL) {
+        return DOTNET_FALSE;
+    }
+
+    if (seed == 0) {
+        if (RAND_bytes((unsigned char *) generator->State, sizeof(generator->State)) != 1) {
+            return DOTNET_FALSE;
+        }
+    } else {
+        for (DOTNET_INT lane = 0; lane < RANDOM_NUMBER_GENERATOR_LANE_COUNT; lane++) {
+            for (DOTNET_INT i = 0; i < 4; i++) {
+                generator->State[i][lane] = NextSplitMix64(&seed);
+            }
+        }
+    }
+
+    // An all zero state would only ever produce zeros.
+    for (DOTNET_INT lane = 0; lane < RANDOM_NUMBER_GENERATOR_LANE_COUNT; lane++) {
+        if ((generator->State[0][lane] | generator->State[1][lane] | generator->State[2][lane] | generator->State[3][lane]) == 0) {
+            generator->State[0][lane] = 0x9E3779B97F4A7C15;
+        }
+    }
+
+    generator->BufferIndex = RANDOM_NUMBER_GENERATOR_LANES_BUFFER_LENGTH;
+    generator->Bytes = 0;
+    generator->BytesLength = 0;
+
+    return DOTNET_TRUE;
+}
+
+DOTNET_PUBLIC RANDOM_NUMBER_GENERATOR_LANES *RandomNumberGeneratorUtility_CreateLanes(DOTNET_ULONG seed) {
+    RANDOM_NUMBER_GENERATOR_LANES *generator = malloc(sizeof(RANDOM_NUMBER_GENERATOR_LANES));
+
+    if (generator == NULL) {
+        return NULL;
+    }
+
+    if (!RandomNumberGeneratorUtility_InitializeLanes(generator, seed)) {
+        free(generator);
+        return NULL;
+    }
+
+    return generator;
+}
+
+DOTNET_STRING RandomNumberGeneratorUtility_GetKernelName() {
+    return GetKernels()->Name;
+}
+
+void RandomNumberGeneratorUtility_FillULong(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_SPAN_ULONG output, DOTNET_INT length) {
+    DOTNET_INT i = 0;
+
+    while (i < length && generator->BufferIndex < RANDOM_NUMBER_GENERATOR_LANES_BUFFER_LENGTH) {
+        output[i++] = generator->Buffer[generator->BufferIndex++];
+    }
+
+    // With the buffer drained, whole steps go straight to the output and the sequence stays the same.
+    DOTNET_INT steps = (length - i) / RANDOM_NUMBER_GENERATOR_LANE_COUNT;
+
+    if (steps > 0) {
+        GetKernels()->FillLanes(generator->State, output + i, steps);
+        i += steps * RANDOM_NUMBER_GENERATOR_LANE_COUNT;
+    }
+
+    while (i < length) {
+        output[i++] = NextBufferedULong(generator);
+    }
+}
+
+void RandomNumberGeneratorUtility_FillRandomBetween(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue, DOTNET_SPAN_LONG output, DOTNET_INT length) {
+    DOTNET_ULONG range = (DOTNET_ULONG) maximumValue - (DOTNET_ULONG) minimumValue;
+
+    DOTNET_ULONG mask = range;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    mask |= mask >> 32;
+
+    for (DOTNET_INT i = 0; i < length; i++) {
+        DOTNET_ULONG result;
+
+        do {
+            result = NextBufferedULong(generator) & mask;
+        } while (result > range);
+
+        output[i] = (DOTNET_LONG) ((DOTNET_ULONG) minimumValue + result);
+    }
+}
+
+void RandomNumberGeneratorUtility_FillBiasRandomBetween(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue, DOTNET_SPAN_LONG output, DOTNET_INT length) {
+    if (maximumValue <= minimumValue) {
+        for (DOTNET_INT i = 0; i < length; i++) {
+            output[i] = minimumValue;
+        }
+
+        return;
+    }
+
+    if (minimumValue < 0) {
+        RandomNumberGeneratorUtility_FillRandomBetween(generator, minimumValue, maximumValue, output, length);
+        return;
+    }
+
+    DOTNET_INT minimumValueLength = GetDigitCount(minimumValue);
+
+    for (DOTNET_INT i = 0; i < length; i++) {
+        DOTNET_INT maximumValueLength = GetDigitCount(GetBufferedRandomBetweenSize(generator, minimumValue, maximumValue));
+        DOTNET_INT randomLength = (DOTNET_INT) GetBufferedRandomBetweenSize(generator, minimumValueLength, maximumValueLength);
+
+        DOTNET_ULONG result;
+
+        do {
+            result = 0;
+
+            for (DOTNET_INT j = 0; j < randomLength; j++) {
+                result = result * 10 + GetBufferedRandomDigit(generator);
+            }
+        } while (result < (DOTNET_ULONG) minimumValue || result > (DOTNET_ULONG) maximumValue);
+
+        output[i] = (DOTNET_LONG) result;
+    }
+}
+
+DOTNET_PUBLIC void RandomNumberGeneratorUtility_FreeLanes(RANDOM_NUMBER_GENERATOR_LANES *generator) {
+    free(generator);
+}
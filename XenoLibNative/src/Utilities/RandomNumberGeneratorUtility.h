@@ -0,0 +1,37 @@
+#ifndef RANDOMNUMBERGENERATORUTILITY_H
+#define RANDOMNUMBERGENERATORUTILITY_H
+
+#include "global.h"
+
+// xoshiro256** seeded from the OpenSSL random generator, meant for picking candidates and not for anything secret.
+typedef struct RANDOM_NUMBER_GENERATOR {
+    DOTNET_ULONG State[4];
+} RANDOM_NUMBER_GENERATOR;
+
+#define RANDOM_NUMBER_GENERATOR_LANE_COUNT 4
+#define RANDOM_NUMBER_GENERATOR_LANES_BUFFER_LENGTH 64
+
+// Four xoshiro256** streams stepped together, the output interleaves them: value i comes from lane i % 4.
+typedef struct RANDOM_NUMBER_GENERATOR_LANES {
+    DOTNET_ULONG State[4][RANDOM_NUMBER_GENERATOR_LANE_COUNT];
+    DOTNET_ULONG Buffer[RANDOM_NUMBER_GENERATOR_LANES_BUFFER_LENGTH];
+    DOTNET_INT BufferIndex;
+    DOTNET_ULONG Bytes;
+    DOTNET_INT BytesLength;
+} RANDOM_NUMBER_GENERATOR_LANES;
+
+DOTNET_BOOL RandomNumberGeneratorUtility_Initialize(RANDOM_NUMBER_GENERATOR *generator);
+DOTNET_ULONG RandomNumberGeneratorUtility_NextULong(RANDOM_NUMBER_GENERATOR *generator);
+DOTNET_LONG RandomNumberGeneratorUtility_GetRandomBetween(RANDOM_NUMBER_GENERATOR *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue);
+DOTNET_LONG RandomNumberGeneratorUtility_GetBiasRandomBetween(RANDOM_NUMBER_GENERATOR *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue);
+
+// A zero seed draws every lane from the OpenSSL random generator, any other seed gives a repeatable sequence.
+DOTNET_BOOL RandomNumberGeneratorUtility_InitializeLanes(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_ULONG seed);
+RANDOM_NUMBER_GENERATOR_LANES *RandomNumberGeneratorUtility_CreateLanes(DOTNET_ULONG seed);
+DOTNET_STRING RandomNumberGeneratorUtility_GetKernelName(void);
+void RandomNumberGeneratorUtility_FillULong(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_SPAN_ULONG output, DOTNET_INT length);
+void RandomNumberGeneratorUtility_FillRandomBetween(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue, DOTNET_SPAN_LONG output, DOTNET_INT length);
+void RandomNumberGeneratorUtility_FillBiasRandomBetween(RANDOM_NUMBER_GENERATOR_LANES *generator, DOTNET_LONG minimumValue, DOTNET_LONG maximumValue, DOTNET_SPAN_LONG output, DOTNET_INT length);
+void RandomNumberGeneratorUtility_FreeLanes(RANDOM_NUMBER_GENERATOR_LANES *generator);
+
+#endif
@@ -1,39 +1,52 @@
 #include "SymmetricAlgorithmUtility.h"
+#include "AesMultiBufferUtility.h"
+#include "CryptographyUtility.h"
 
 inline DOTNET_INT SymmetricAlgorithmUtility_GetPaddedLength(DOTNET_INT size)
 {
     return 16 - size % 16;
 }
 
-DOTNET_INT SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(const EVP_CIPHER *type, DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+DOTNET_PRIVATE DOTNET_BOOL IsOverlapping(DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_READ_ONLY_SPAN_BYTE destination, DOTNET_INT length) {
+    return (uintptr_t) destination < (uintptr_t) (source + length) && (uintptr_t) source < (uintptr_t) (destination + length);
+}
+
+EVP_CIPHER_CTX *SymmetricAlgorithmUtility_CreateEncryptContext_EVP_CIPHER(const EVP_CIPHER *type, DOTNET_READ_ONLY_SPAN_BYTE key) {
     EVP_CIPHER_CTX *context = EVP_CIPHER_CTX_new();
 
     if (context == NULL) {
-        return 0;
+        return NULL;
     }
 
-    if (!EVP_EncryptInit_ex(context, type, NULL, key, iv)) {
+    if (!EVP_EncryptInit_ex(context, type, NULL, key, NULL)) {
         EVP_CIPHER_CTX_free(context);
+        return NULL;
+    }
+
+    return context;
+}
+
+DOTNET_INT SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER_CTX(EVP_CIPHER_CTX *context, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    // Passing a NULL cipher and key keeps the expanded key schedule and only resets the iv.
+    if (!EVP_EncryptInit_ex(context, NULL, NULL, NULL, iv)) {
         return 0;
     }
 
     DOTNET_INT initialOutputLength;
 
     if (!EVP_EncryptUpdate(context, destination, &initialOutputLength, source, sourceLength)) {
-        EVP_CIPHER_CTX_free(context);
         return 0;
     }
 
     DOTNET_INT paddingOutputLength = 0;
 
-    if (type == EVP_aes_256_cfb8()) {
+    if (EVP_CIPHER_CTX_get_nid(context) == NID_aes_256_cfb8) {
         DOTNET_BYTE paddingSizeRequired = SymmetricAlgorithmUtility_GetPaddedLength(sourceLength);
         DOTNET_BYTE paddingArray[paddingSizeRequired];
 
         memset(paddingArray, paddingSizeRequired, paddingSizeRequired);
 
         if (!EVP_EncryptUpdate(context, destination + initialOutputLength, &paddingOutputLength, paddingArray, paddingSizeRequired)) {
-            EVP_CIPHER_CTX_free(context);
             return 0;
         }
     }
@@ -41,44 +54,69 @@ DOTNET_INT SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(const EVP_CIPHER *type,
     DOTNET_INT finalOutputLength;
 
     if (!EVP_EncryptFinal_ex(context, destination + initialOutputLength + paddingOutputLength, &finalOutputLength)) {
-        EVP_CIPHER_CTX_free(context);
         return 0;
     }
 
-    EVP_CIPHER_CTX_free(context);
-
     return initialOutputLength + paddingOutputLength + finalOutputLength;
 }
 
+DOTNET_INT SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(const EVP_CIPHER *type, DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    // Pooled contexts remember their last cipher, so a NULL type must not fall through to it.
+    if (type == NULL) {
+        return 0;
+    }
+
+    EVP_CIPHER_CTX *context = CryptographyUtility_RentCipherContext();
+
+    if (context == NULL) {
+        return 0;
+    }
+
+    DOTNET_INT outputLength = 0;
+
+    if (EVP_EncryptInit_ex(context, type, NULL, key, NULL)) {
+        outputLength = SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER_CTX(context, iv, source, sourceLength, destination);
+    }
+
+    CryptographyUtility_ReturnCipherContext(context);
+
+    return outputLength;
+}
+
 DOTNET_INT SymmetricAlgorithmUtility_Decrypt_EVP_CIPHER(const EVP_CIPHER *type, DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    EVP_CIPHER_CTX *context = EVP_CIPHER_CTX_new();
+    if (type == NULL) {
+        return 0;
+    }
+
+    EVP_CIPHER_CTX *context = CryptographyUtility_RentCipherContext();
 
     if (context == NULL) {
         return 0;
     }
 
     if (!EVP_DecryptInit_ex(context, type, NULL, key, iv)) {
-        EVP_CIPHER_CTX_free(context);
+        CryptographyUtility_ReturnCipherContext(context);
         return 0;
     }
 
     DOTNET_INT outputLength;
 
     if (!EVP_DecryptUpdate(context, destination, &outputLength, source, sourceLength)) {
-        EVP_CIPHER_CTX_free(context);
+        CryptographyUtility_ReturnCipherContext(context);
         return 0;
     }
 
     DOTNET_INT finalOutputLength;
 
     if (!EVP_DecryptFinal_ex(context, destination + outputLength, &finalOutputLength)) {
-        EVP_CIPHER_CTX_free(context);
+        CryptographyUtility_ReturnCipherContext(context);
         return 0;
     }
 
-    EVP_CIPHER_CTX_free(context);
+    CryptographyUtility_ReturnCipherContext(context);
 
-    if (type == EVP_aes_256_cfb8()) {
+    // Fetched ciphers are distinct objects from the legacy EVP_aes_256_cfb8() one, so they are told apart by nid.
+    if (EVP_CIPHER_get_nid(type) == NID_aes_256_cfb8) {
         return outputLength + finalOutputLength - *(destination + outputLength + finalOutputLength - 1);
     } else {
         return outputLength + finalOutputLength;
@@ -86,21 +124,30 @@ DOTNET_INT SymmetricAlgorithmUtility_Decrypt_EVP_CIPHER(const EVP_CIPHER *type,
 }
 
 inline DOTNET_PUBLIC DOTNET_INT SymmetricAlgorithmUtility_Encrypt_AES_128_CBC(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(EVP_aes_128_cbc(), key, iv, source, sourceLength, destination);
+    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_128_CBC), key, iv, source, sourceLength, destination);
 }
 
 inline DOTNET_PUBLIC DOTNET_INT SymmetricAlgorithmUtility_Encrypt_AES_192_CBC(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(EVP_aes_192_cbc(), key, iv, source, sourceLength, destination);
+    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_192_CBC), key, iv, source, sourceLength, destination);
 }
 
 inline DOTNET_PUBLIC DOTNET_INT SymmetricAlgorithmUtility_Encrypt_AES_256_CBC(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(EVP_aes_256_cbc(), key, iv, source, sourceLength, destination);
+    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_256_CBC), key, iv, source, sourceLength, destination);
 }
 
 inline DOTNET_PUBLIC DOTNET_INT SymmetricAlgorithmUtility_Encrypt_AES_256_CFB_8(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(EVP_aes_256_cfb8(), key, iv, source, sourceLength, destination);
+    return SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_256_CFB8), key, iv, source, sourceLength, destination);
 }
 
-inline DOTNET_PUBLIC DOTNET_INT SymmetricAlgorithmUtility_Decrypt_AES_256_CFB_8(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
-    return SymmetricAlgorithmUtility_Decrypt_EVP_CIPHER(EVP_aes_256_cfb8(), key, iv, source, sourceLength, destination);
+DOTNET_PUBLIC DOTNET_INT SymmetricAlgorithmUtility_Decrypt_AES_256_CFB_8(DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination) {
+    // Every key stream byte depends only on cipher text that is already known, the multi buffer kernels decrypt many bytes at once.
+    if (key != NULL && iv != NULL && source != NULL && sourceLength > 0 && destination != NULL && !IsOverlapping(source, destination, sourceLength)) {
+        AES_MULTI_BUFFER_KEY expandedKey;
+
+        if (AesMultiBufferUtility_ExpandKey(&expandedKey, 256, key) && AesMultiBufferUtility_Decrypt_CFB8(&expandedKey, iv, source, sourceLength, destination)) {
+            return sourceLength - destination[sourceLength - 1];
+        }
+    }
+
+    return SymmetricAlgorithmUtility_Decrypt_EVP_CIPHER(CryptographyUtility_GetCipher(CRYPTOGRAPHY_CIPHER_AES_256_CFB8), key, iv, source, sourceLength, destination);
 }
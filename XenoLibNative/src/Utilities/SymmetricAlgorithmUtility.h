@@ -6,6 +6,9 @@
 
 DOTNET_INT SymmetricAlgorithmUtility_GetPaddedLength(DOTNET_INT size);
 
+EVP_CIPHER_CTX *SymmetricAlgorithmUtility_CreateEncryptContext_EVP_CIPHER(const EVP_CIPHER *type, DOTNET_READ_ONLY_SPAN_BYTE key);
+DOTNET_INT SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER_CTX(EVP_CIPHER_CTX *context, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
+
 DOTNET_INT SymmetricAlgorithmUtility_Encrypt_EVP_CIPHER(const EVP_CIPHER *type, DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
 DOTNET_INT SymmetricAlgorithmUtility_Decrypt_EVP_CIPHER(const EVP_CIPHER *type, DOTNET_READ_ONLY_SPAN_BYTE key, DOTNET_READ_ONLY_SPAN_BYTE iv, DOTNET_READ_ONLY_SPAN_BYTE source, DOTNET_INT sourceLength, DOTNET_SPAN_BYTE destination);
 
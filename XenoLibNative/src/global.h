@@ -10,6 +10,19 @@
 #define DOTNET_PRIVATE static
 #define DOTNET_PUBLIC XENO_NATIVE_EXPORT
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define XENO_NATIVE_X86
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define XENO_NATIVE_ARM64
+#endif
+
+// Allows a single function to use instructions beyond the baseline target, callers must check the cpu at runtime.
+#if defined(__GNUC__) || defined(__clang__)
+#define XENO_NATIVE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define XENO_NATIVE_TARGET(isa)
+#endif
+
 #define DOTNET_TRUE 1
 #define DOTNET_FALSE 0
 
@@ -19,6 +19,8 @@ public sealed class Network : IDisposable
     public event Action? Ready;
     public event NewBlockHandler? HasNewBlock;
 
+    private const int MaxPacketLength = 1024 * 1024;
+
     private static readonly byte[] CertificateSupportedCharacters = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789&~#@\'(\\)="u8.ToArray();
 
     private TcpClient? _tcpClient;
@@ -29,6 +31,8 @@ public sealed class Network : IDisposable
     private readonly byte[] _networkAesKey;
     private readonly byte[] _networkAesIv;
 
+    private PacketCodec? _packetCodec;
+
     private BlockingCollection<PacketData>? _packetDataBlockingCollection;
     private Task? _networkPacketHandlerTask;
 
@@ -127,6 +131,8 @@ public sealed class Network : IDisposable
                     pbkdf1.FillBytes(_networkAesIv);
                 }
 
+                _packetCodec = new PacketCodec(_networkAesKey, _networkAesIv, _tcpClient.ReceiveBufferSize, MaxPacketLength);
+
                 SendPacketToNetwork(new PacketData(certificateArrayPoolOwner, false));
 
                 SendPacketToNetwork(new PacketData($"{NetworkConstants.MinerLoginType}|{networkConnection.WalletAddress}", true, (packet, _) =>
@@ -171,6 +177,9 @@ public sealed class Network : IDisposable
         _tcpClient?.Dispose();
         _tcpClient = null;
 
+        _packetCodec?.Dispose();
+        _packetCodec = null;
+
         Disconnected?.Invoke(reason);
     }
 
@@ -184,11 +193,11 @@ public sealed class Network : IDisposable
 
                 try
                 {
-                    if (_tcpClient == null) return;
+                    if (_tcpClient == null || _packetCodec == null) return;
 
                     using var networkTimeoutCts = new CancellationTokenSource(_networkConnection!.TimeoutDuration);
 
-                    if (!await packetData.ExecuteAsync(_tcpClient.GetStream(), _networkAesKey, _networkAesIv, networkTimeoutCts.Token))
+                    if (!await packetData.ExecuteAsync(_tcpClient.GetStream(), _packetCodec, networkTimeoutCts.Token))
                     {
                         InternalDisconnect("Packet handler error");
                     }
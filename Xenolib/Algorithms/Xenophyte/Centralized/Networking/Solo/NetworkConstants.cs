@@ -11,6 +11,12 @@ public static class NetworkConstants
     /// <see cref="Xenophyte_Connector_All.Setting.ClassConnectorSetting" />
     public const int SeedNodePort = 18000;
 
+    /// <see cref="Xenophyte_Connector_All.Setting.ClassConnectorSetting" />
+    public const int MinWalletAddressSize = 48;
+
+    /// <see cref="Xenophyte_Connector_All.Setting.ClassConnectorSetting" />
+    public const int MaxWalletAddressSize = 96;
+
     /// <see cref="Xenophyte_Connector_All.Setting.ClassConnectorSetting" />
     public const int SeedNodeTokenPort = 18003;
 
@@ -0,0 +1,105 @@
+﻿using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+
+namespace Xenolib.Algorithms.Xenophyte.Centralized.Networking.Solo;
+
+[UnsupportedOSPlatform("browser")]
+public sealed partial class PacketCodec : IDisposable
+{
+    private static partial class Native
+    {
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial nint XenophyteCentralizedPacketCodec_Create(ReadOnlySpan<byte> aesKey, ReadOnlySpan<byte> aesIv, int maxPacketLength);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int XenophyteCentralizedPacketCodec_GetEncodeLength(int packetLength);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int XenophyteCentralizedPacketCodec_Encode(nint codec, ReadOnlySpan<byte> packet, int packetLength, Span<byte> output);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int XenophyteCentralizedPacketCodec_Decode(nint codec, ReadOnlySpan<byte> input, int inputLength, out int packetLength);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial nint XenophyteCentralizedPacketCodec_GetPacket(nint codec);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial void XenophyteCentralizedPacketCodec_Free(nint codec);
+    }
+
+    private nint _codec;
+
+    // Bytes read past the end of a packet belong to the next one and stay here until it is read.
+    private readonly byte[] _receiveBuffer;
+    private int _receiveOffset;
+    private int _receiveLength;
+
+    public PacketCodec(ReadOnlySpan<byte> aesKey, ReadOnlySpan<byte> aesIv, int receiveBufferSize, int maxPacketLength)
+    {
+        _codec = Native.XenophyteCentralizedPacketCodec_Create(aesKey, aesIv, maxPacketLength);
+        if (_codec == 0) throw new InvalidOperationException("Unable to create the packet codec.");
+
+        _receiveBuffer = GC.AllocateUninitializedArray<byte>(receiveBufferSize);
+    }
+
+    ~PacketCodec()
+    {
+        ReleaseUnmanagedResources();
+    }
+
+    public static int GetEncodeLength(int packetLength)
+    {
+        return Native.XenophyteCentralizedPacketCodec_GetEncodeLength(packetLength);
+    }
+
+    public int Encode(ReadOnlySpan<byte> packet, Span<byte> output)
+    {
+        return Native.XenophyteCentralizedPacketCodec_Encode(_codec, packet, packet.Length, output);
+    }
+
+    public async ValueTask<int> ReadPacketAsync(Stream stream, CancellationToken cancellationToken)
+    {
+        while (true)
+        {
+            if (_receiveLength == 0)
+            {
+                _receiveOffset = 0;
+                _receiveLength = await stream.ReadAsync(_receiveBuffer, cancellationToken);
+                if (_receiveLength == 0) return -1;
+            }
+
+            var consumed = Native.XenophyteCentralizedPacketCodec_Decode(_codec, _receiveBuffer.AsSpan(_receiveOffset, _receiveLength), _receiveLength, out var packetLength);
+
+            if (consumed < 0)
+            {
+                _receiveLength = 0;
+                return -1;
+            }
+
+            _receiveOffset += consumed;
+            _receiveLength -= consumed;
+
+            if (packetLength >= 0) return packetLength;
+        }
+    }
+
+    // The packet lives in the codec and is only valid until the next read.
+    public unsafe ReadOnlySpan<byte> GetPacket(int packetLength)
+    {
+        return new ReadOnlySpan<byte>((void*) Native.XenophyteCentralizedPacketCodec_GetPacket(_codec), packetLength);
+    }
+
+    private void ReleaseUnmanagedResources()
+    {
+        if (_codec == 0) return;
+
+        Native.XenophyteCentralizedPacketCodec_Free(_codec);
+        _codec = 0;
+    }
+
+    public void Dispose()
+    {
+        ReleaseUnmanagedResources();
+        GC.SuppressFinalize(this);
+    }
+}
\ No newline at end of file
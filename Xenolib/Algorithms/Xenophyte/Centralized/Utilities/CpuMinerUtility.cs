@@ -15,6 +15,17 @@ public static partial class CpuMinerUtility
         [LibraryImport(Program.XenoNativeLibrary)]
         public static partial int XenophyteCentralizedAlgorithm_GenerateNonEasyBlockNumbers(long minValue, long maxvalue, Span<long> output);
 
+        [LibraryImport(Program.XenoNativeLibrary)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static partial bool XenophyteCentralizedAlgorithm_IsEasyBlockNumber(long minValue, long maxValue, long value);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial long XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(long minValue, long maxValue);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static partial bool XenophyteCentralizedAlgorithm_GetNonEasyBlockNumber(long minValue, long maxValue, long index, out long value);
+
         [LibraryImport(Program.XenoNativeLibrary)]
         [return: MarshalAs(UnmanagedType.Bool)]
         public static partial bool XenophyteCentralizedAlgorithm_MakeEncryptedShare(ReadOnlySpan<byte> input, int inputLength, Span<byte> encryptedShare, Span<byte> hashEncryptedShare, ReadOnlySpan<byte> xorKey, int xorKeyLength, int aesKeySize, ReadOnlySpan<byte> aesKey, ReadOnlySpan<byte> aesIv, int aesRound);
@@ -34,6 +45,27 @@ public static partial class CpuMinerUtility
         return Native.XenophyteCentralizedAlgorithm_GenerateNonEasyBlockNumbers(minValue, maxValue, output);
     }
 
+    [UnsupportedOSPlatform("browser")]
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool IsEasyBlockNumber(long minValue, long maxValue, long value)
+    {
+        return Native.XenophyteCentralizedAlgorithm_IsEasyBlockNumber(minValue, maxValue, value);
+    }
+
+    [UnsupportedOSPlatform("browser")]
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static long GetNonEasyBlockNumberCount(long minValue, long maxValue)
+    {
+        return Native.XenophyteCentralizedAlgorithm_GetNonEasyBlockNumberCount(minValue, maxValue);
+    }
+
+    [UnsupportedOSPlatform("browser")]
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool TryGetNonEasyBlockNumber(long minValue, long maxValue, long index, out long value)
+    {
+        return Native.XenophyteCentralizedAlgorithm_GetNonEasyBlockNumber(minValue, maxValue, index, out value);
+    }
+
     [UnsupportedOSPlatform("browser")]
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static bool MakeEncryptedShare(ReadOnlySpan<byte> input, Span<byte> encryptedShare, Span<byte> hashEncryptedShare, ReadOnlySpan<byte> xorKey, ReadOnlySpan<byte> aesKey, ReadOnlySpan<byte> aesIv, int aesRound)
@@ -0,0 +1,87 @@
+﻿using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+
+namespace Xenolib.Algorithms.Xenophyte.Centralized.Utilities;
+
+[UnsupportedOSPlatform("browser")]
+public sealed partial class RandomBlockNumberGenerator : IDisposable
+{
+    private static partial class Native
+    {
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial nint RandomNumberGeneratorUtility_CreateLanes(ulong seed);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(nint generator, long minValue, long maxValue, [MarshalAs(UnmanagedType.Bool)] bool useXenophyteRandomizer, Span<long> firstNumbers, Span<long> secondNumbers, int length);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial void RandomNumberGeneratorUtility_FreeLanes(nint generator);
+    }
+
+    private const int PairsLength = 1024;
+
+    private readonly long[] _firstNumbers = new long[PairsLength];
+    private readonly long[] _secondNumbers = new long[PairsLength];
+
+    private nint _generator;
+
+    private long _minValue;
+    private long _maxValue;
+    private bool _useXenophyteRandomizer;
+    private int _pairsIndex;
+    private int _pairsLength;
+
+    public RandomBlockNumberGenerator(ulong seed = 0)
+    {
+        _generator = Native.RandomNumberGeneratorUtility_CreateLanes(seed);
+    }
+
+    ~RandomBlockNumberGenerator()
+    {
+        ReleaseUnmanagedResources();
+    }
+
+    public int GeneratePairs(long minValue, long maxValue, bool useXenophyteRandomizer, Span<long> firstNumbers, Span<long> secondNumbers)
+    {
+        return Native.XenophyteCentralizedAlgorithm_GenerateRandomBlockNumberPairs(_generator, minValue, maxValue, useXenophyteRandomizer, firstNumbers, secondNumbers, Math.Min(firstNumbers.Length, secondNumbers.Length));
+    }
+
+    public bool TryGetNextPair(long minValue, long maxValue, bool useXenophyteRandomizer, out long firstNumber, out long secondNumber)
+    {
+        if (_pairsIndex == _pairsLength || _minValue != minValue || _maxValue != maxValue || _useXenophyteRandomizer != useXenophyteRandomizer)
+        {
+            _minValue = minValue;
+            _maxValue = maxValue;
+            _useXenophyteRandomizer = useXenophyteRandomizer;
+            _pairsIndex = 0;
+            _pairsLength = GeneratePairs(minValue, maxValue, useXenophyteRandomizer, _firstNumbers, _secondNumbers);
+
+            if (_pairsLength == 0)
+            {
+                firstNumber = 0;
+                secondNumber = 0;
+                return false;
+            }
+        }
+
+        firstNumber = _firstNumbers[_pairsIndex];
+        secondNumber = _secondNumbers[_pairsIndex];
+        _pairsIndex++;
+
+        return true;
+    }
+
+    private void ReleaseUnmanagedResources()
+    {
+        if (_generator == 0) return;
+
+        Native.RandomNumberGeneratorUtility_FreeLanes(_generator);
+        _generator = 0;
+    }
+
+    public void Dispose()
+    {
+        ReleaseUnmanagedResources();
+        GC.SuppressFinalize(this);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+﻿using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+using System.Text;
+
+namespace Xenolib.Algorithms.Xenophyte.Centralized.Utilities;
+
+[UnsupportedOSPlatform("browser")]
+public sealed partial class SearchEngine : IDisposable
+{
+    private static partial class Native
+    {
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial nint XenophyteCentralizedSearchEngine_Create(ReadOnlySpan<SearchThreadOptions> threadOptions, int threadCount);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial long XenophyteCentralizedSearchEngine_StartJob(nint engine, long blockMinRange, long blockMaxRange, long timestamp, ReadOnlySpan<byte> xorKey, int xorKeyLength, int aesKeySize, ReadOnlySpan<byte> aesKey, ReadOnlySpan<byte> aesIv, int aesRound, ReadOnlySpan<byte> blockIndication, int blockIndicationLength);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial void XenophyteCentralizedSearchEngine_CancelJob(nint engine);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static partial bool XenophyteCentralizedSearchEngine_PollSolution(nint engine, out SearchSolution solution, Span<byte> encryptedShare, int timeoutMilliseconds);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial long XenophyteCentralizedSearchEngine_TakeHashCount(nint engine, int threadIndex);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial double XenophyteCentralizedSearchEngine_GetEasyBlockProgress(nint engine);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial void XenophyteCentralizedSearchEngine_Free(nint engine);
+    }
+
+    private nint _engine;
+
+    public SearchEngine(ReadOnlySpan<SearchThreadOptions> threadOptions)
+    {
+        _engine = Native.XenophyteCentralizedSearchEngine_Create(threadOptions, threadOptions.Length);
+    }
+
+    ~SearchEngine()
+    {
+        ReleaseUnmanagedResources();
+    }
+
+    public long StartJob(long blockMinRange, long blockMaxRange, long timestamp, ReadOnlySpan<byte> xorKey, ReadOnlySpan<byte> aesKey, ReadOnlySpan<byte> aesIv, int aesRound, string blockIndication)
+    {
+        var blockIndicationBytes = Encoding.ASCII.GetBytes(blockIndication);
+        return Native.XenophyteCentralizedSearchEngine_StartJob(_engine, blockMinRange, blockMaxRange, timestamp, xorKey, xorKey.Length, aesKey.Length * 8, aesKey, aesIv, aesRound, blockIndicationBytes, blockIndicationBytes.Length);
+    }
+
+    public void CancelJob()
+    {
+        Native.XenophyteCentralizedSearchEngine_CancelJob(_engine);
+    }
+
+    public bool PollSolution(out SearchSolution solution, Span<byte> encryptedShare, TimeSpan timeout)
+    {
+        return Native.XenophyteCentralizedSearchEngine_PollSolution(_engine, out solution, encryptedShare, (int) timeout.TotalMilliseconds);
+    }
+
+    public long TakeHashCount(int threadIndex)
+    {
+        return Native.XenophyteCentralizedSearchEngine_TakeHashCount(_engine, threadIndex);
+    }
+
+    public double GetEasyBlockProgress()
+    {
+        return Native.XenophyteCentralizedSearchEngine_GetEasyBlockProgress(_engine);
+    }
+
+    private void ReleaseUnmanagedResources()
+    {
+        if (_engine == 0) return;
+
+        Native.XenophyteCentralizedSearchEngine_Free(_engine);
+        _engine = 0;
+    }
+
+    public void Dispose()
+    {
+        ReleaseUnmanagedResources();
+        GC.SuppressFinalize(this);
+    }
+}
\ No newline at end of file
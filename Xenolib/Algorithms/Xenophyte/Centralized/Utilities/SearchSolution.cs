@@ -0,0 +1,19 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Xenolib.Algorithms.Xenophyte.Centralized.Utilities;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct SearchSolution
+{
+    public const int JobTypeEasy = 0;
+    public const int JobTypeSemiRandom = 1;
+    public const int JobTypeRandom = 2;
+
+    public readonly long JobId;
+    public readonly long FirstNumber;
+    public readonly long SecondNumber;
+    public readonly long Solution;
+    public readonly int Operator;
+    public readonly int JobType;
+    public readonly int ThreadIndex;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Xenolib.Algorithms.Xenophyte.Centralized.Utilities;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct SearchThreadOptions
+{
+    public readonly ulong ThreadAffinity;
+    public readonly int ThreadPriority;
+    public readonly int DoEasyBlock;
+    public readonly int UseXenophyteRandomizer;
+
+    public SearchThreadOptions(ulong threadAffinity, ThreadPriority threadPriority, bool doEasyBlock, bool useXenophyteRandomizer)
+    {
+        ThreadAffinity = threadAffinity;
+        ThreadPriority = (int) threadPriority;
+        DoEasyBlock = doEasyBlock ? 1 : 0;
+        UseXenophyteRandomizer = useXenophyteRandomizer ? 1 : 0;
+    }
+}
\ No newline at end of file
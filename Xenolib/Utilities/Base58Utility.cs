@@ -1,10 +1,21 @@
 ﻿using System.Numerics;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+using System.Text;
+using Xenolib.Utilities.Buffer;
 
 namespace Xenolib.Utilities;
 
-public static class Base58Utility
+public static partial class Base58Utility
 {
+    [UnsupportedOSPlatform("browser")]
+    private static partial class Native
+    {
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int Base58Utility_ValidateWalletAddresses(ReadOnlySpan<byte> addresses, ReadOnlySpan<int> addressLengths, int addressCount, int minLength, int maxLength, [MarshalAs(UnmanagedType.Bool)] bool requireChecksum, Span<int> results);
+    }
+
     private static readonly char[] Characters =
     {
         '1', '2', '3', '4', '5', '6', '7', '8', '9',
@@ -177,4 +188,49 @@ public static class Base58Utility
         bytesWritten = decodeLength;
         return true;
     }
+
+    // Validation runs on the native codec, which is standard Base58 rather than the fixed width layout of Encode and Decode above.
+    // Without requireChecksum only the length and the alphabet matter, which both codecs accept alike.
+    [UnsupportedOSPlatform("browser")]
+    public static bool IsValidWalletAddress(string walletAddress, int minLength, int maxLength, bool requireChecksum)
+    {
+        Span<bool> result = stackalloc bool[1];
+        return ValidateWalletAddresses(new ReadOnlySpan<string>(ref walletAddress), result, minLength, maxLength, requireChecksum) == 1;
+    }
+
+    [UnsupportedOSPlatform("browser")]
+    public static int ValidateWalletAddresses(ReadOnlySpan<string> walletAddresses, Span<bool> results, int minLength, int maxLength, bool requireChecksum)
+    {
+        using var addressLengthsArrayPoolOwner = ArrayPoolOwner<int>.Rent(walletAddresses.Length);
+        using var resultsArrayPoolOwner = ArrayPoolOwner<int>.Rent(walletAddresses.Length);
+
+        var addressLengths = addressLengthsArrayPoolOwner.Span;
+        var totalLength = 0;
+
+        // Anything longer than maxLength is rejected by length alone, so it is not worth copying.
+        for (var i = 0; i < walletAddresses.Length; i++)
+        {
+            addressLengths[i] = walletAddresses[i].Length <= maxLength ? walletAddresses[i].Length : 0;
+            totalLength += addressLengths[i];
+        }
+
+        using var addressesArrayPoolOwner = ArrayPoolOwner<byte>.Rent(totalLength);
+        var addresses = addressesArrayPoolOwner.Span;
+        var offset = 0;
+
+        // Characters outside ASCII become '?', which is not in the alphabet either.
+        for (var i = 0; i < walletAddresses.Length; i++)
+        {
+            offset += Encoding.ASCII.GetBytes(walletAddresses[i].AsSpan(0, addressLengths[i]), addresses[offset..]);
+        }
+
+        var validCount = Native.Base58Utility_ValidateWalletAddresses(addresses, addressLengths, walletAddresses.Length, minLength, maxLength, requireChecksum, resultsArrayPoolOwner.Span);
+
+        for (var i = 0; i < walletAddresses.Length; i++)
+        {
+            results[i] = resultsArrayPoolOwner.Span[i] != 0;
+        }
+
+        return validCount;
+    }
 }
\ No newline at end of file
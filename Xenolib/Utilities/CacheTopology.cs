@@ -0,0 +1,11 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Xenolib.Utilities;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct CacheTopology
+{
+    public readonly int Size;
+    public readonly int ProcessorStart;
+    public readonly int ProcessorCount;
+}
\ No newline at end of file
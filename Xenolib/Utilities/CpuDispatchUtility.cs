@@ -0,0 +1,45 @@
+﻿using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+
+namespace Xenolib.Utilities;
+
+[UnsupportedOSPlatform("browser")]
+public static partial class CpuDispatchUtility
+{
+    private static partial class Native
+    {
+        [LibraryImport(Program.XenoNativeLibrary)]
+        [return: MarshalAs(UnmanagedType.LPStr)]
+        public static partial string CpuDispatchUtility_GetTierName();
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuDispatchUtility_GetPrimitiveCount();
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        [return: MarshalAs(UnmanagedType.LPStr)]
+        public static partial string CpuDispatchUtility_GetPrimitiveName(int primitive);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        [return: MarshalAs(UnmanagedType.LPStr)]
+        public static partial string CpuDispatchUtility_GetKernelName(int primitive);
+    }
+
+    public static string TierName { get; }
+
+    public static string KernelNames { get; }
+
+    static CpuDispatchUtility()
+    {
+        TierName = Native.CpuDispatchUtility_GetTierName();
+
+        var primitiveCount = Native.CpuDispatchUtility_GetPrimitiveCount();
+        var kernelNames = new List<string>(primitiveCount);
+
+        for (var i = 0; i < primitiveCount; i++)
+        {
+            kernelNames.Add($"{Native.CpuDispatchUtility_GetPrimitiveName(i)}={Native.CpuDispatchUtility_GetKernelName(i)}");
+        }
+
+        KernelNames = string.Join(" ", kernelNames);
+    }
+}
\ No newline at end of file
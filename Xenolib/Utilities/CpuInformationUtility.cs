@@ -21,6 +21,27 @@ public static partial class CpuInformationUtility
 
         [LibraryImport(Program.XenoNativeLibrary)]
         public static partial int CpuInformationUtility_GetProcessorCoreCount();
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuInformationUtility_GetProcessorCount();
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuInformationUtility_GetProcessorClusterCount();
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuInformationUtility_GetProcessorPackageCount();
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuInformationUtility_GetProcessorTopology(Span<ProcessorTopology> output, int outputLength);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuInformationUtility_GetL2CacheTopology(Span<CacheTopology> output, int outputLength);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuInformationUtility_GetL3CacheTopology(Span<CacheTopology> output, int outputLength);
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial int CpuInformationUtility_GetThreadPlacement(int threadCount, Span<int> systemProcessorIds);
     }
 
     public static string ProcessorName { get; }
@@ -35,6 +56,16 @@ public static partial class CpuInformationUtility
 
     public static int ProcessorThreadCount { get; } = Environment.ProcessorCount;
 
+    public static int ProcessorClusterCount { get; }
+
+    public static int ProcessorPackageCount { get; }
+
+    public static ProcessorTopology[] ProcessorTopology { get; }
+
+    public static CacheTopology[] L2CacheTopology { get; }
+
+    public static CacheTopology[] L3CacheTopology { get; }
+
     static CpuInformationUtility()
     {
         ProcessorName = Native.CpuInformationUtility_GetProcessorName();
@@ -92,5 +123,23 @@ public static partial class CpuInformationUtility
         {
             ProcessorCoreCount = Environment.ProcessorCount / 2;
         }
+
+        ProcessorClusterCount = Native.CpuInformationUtility_GetProcessorClusterCount();
+        ProcessorPackageCount = Native.CpuInformationUtility_GetProcessorPackageCount();
+
+        ProcessorTopology = new ProcessorTopology[Native.CpuInformationUtility_GetProcessorCount()];
+        if (Native.CpuInformationUtility_GetProcessorTopology(ProcessorTopology, ProcessorTopology.Length) < 0) ProcessorTopology = Array.Empty<ProcessorTopology>();
+
+        L2CacheTopology = new CacheTopology[ProcessorTopology.Length];
+        L2CacheTopology = L2CacheTopology[..Math.Max(Native.CpuInformationUtility_GetL2CacheTopology(L2CacheTopology, L2CacheTopology.Length), 0)];
+
+        L3CacheTopology = new CacheTopology[ProcessorTopology.Length];
+        L3CacheTopology = L3CacheTopology[..Math.Max(Native.CpuInformationUtility_GetL3CacheTopology(L3CacheTopology, L3CacheTopology.Length), 0)];
+    }
+
+    public static int[] GetThreadPlacement(int threadCount)
+    {
+        var systemProcessorIds = new int[threadCount];
+        return Native.CpuInformationUtility_GetThreadPlacement(threadCount, systemProcessorIds) < 0 ? Array.Empty<int>() : systemProcessorIds;
     }
 }
\ No newline at end of file
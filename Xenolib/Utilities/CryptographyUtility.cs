@@ -0,0 +1,32 @@
+﻿using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+
+namespace Xenolib.Utilities;
+
+[UnsupportedOSPlatform("browser")]
+public static partial class CryptographyUtility
+{
+    private static partial class Native
+    {
+        [LibraryImport(Program.XenoNativeLibrary)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static partial bool CryptographyUtility_Initialize();
+
+        [LibraryImport(Program.XenoNativeLibrary)]
+        public static partial void CryptographyUtility_Shutdown();
+    }
+
+    public static void Initialize()
+    {
+        if (!Native.CryptographyUtility_Initialize())
+        {
+            throw new InvalidOperationException("Unable to fetch the OpenSSL algorithms used by the native library.");
+        }
+    }
+
+    // No other native call may be running.
+    public static void Shutdown()
+    {
+        Native.CryptographyUtility_Shutdown();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Xenolib.Utilities;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct ProcessorTopology
+{
+    public readonly int SystemProcessorId;
+    public readonly int SmtId;
+    public readonly int CoreIndex;
+    public readonly int ClusterIndex;
+    public readonly int PackageIndex;
+    public readonly int L2CacheIndex;
+    public readonly int L3CacheIndex;
+}
\ No newline at end of file
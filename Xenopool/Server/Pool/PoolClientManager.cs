@@ -2,6 +2,8 @@
 using System.Diagnostics.CodeAnalysis;
 using Microsoft.EntityFrameworkCore;
 using Xenolib.Algorithms.Xenophyte.Centralized.Networking.Pool;
+using Xenolib.Algorithms.Xenophyte.Centralized.Networking.Solo;
+using Xenolib.Utilities;
 using Xenopool.Server.Database;
 using Xenopool.Server.Database.Repository;
 
@@ -22,6 +24,12 @@ public sealed class PoolClientManager : IDisposable
 
     public LoginResponse AddClient(LoginRequest request)
     {
+        // Malformed addresses never reach the database, only the length and the alphabet are checked since Xenophyte addresses are not known to carry a Base58Check checksum.
+        if (!Base58Utility.IsValidWalletAddress(request.WalletAddress, NetworkConstants.MinWalletAddressSize, NetworkConstants.MaxWalletAddressSize, false))
+        {
+            return new LoginResponse { Status = false, Reason = "Invalid wallet address." };
+        }
+
         var account = _poolAccountRepository.GetAccount(request.WalletAddress) ?? _poolAccountRepository.CreateAccount(request.WalletAddress);
 
         if (account.IsBanned)
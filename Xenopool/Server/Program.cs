@@ -3,6 +3,7 @@
 using Microsoft.AspNetCore.HttpOverrides;
 using Microsoft.EntityFrameworkCore;
 using TheDialgaTeam.Core.Logging.Microsoft;
+using Xenolib.Utilities;
 using Xenopool.Server.Database;
 using Xenopool.Server.Options;
 using Xenopool.Server.Pool;
@@ -72,6 +73,9 @@ public static class Program
 
         app.MapGrpcService<PoolService>();
 
+        // There is no matching Shutdown, threads may still be inside a pooled call when the host returns and the OS reclaims the cache at exit.
+        CryptographyUtility.Initialize();
+
         app.Run();
     }
 
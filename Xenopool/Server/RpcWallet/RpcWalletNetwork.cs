@@ -97,7 +97,7 @@ public sealed class RpcWalletNetwork : IDisposable
 
         var base64DecodeLength = Base64Utility.DecodeLength(responseBytes.Span);
         using var base64DecodeOutput = ArrayPoolOwner<byte>.Rent(base64DecodeLength);
-        Base64Utility.Decode(responseBytes.Span, base64DecodeOutput.Span);
+        if (Base64Utility.Decode(responseBytes.Span, base64DecodeOutput.Span) < 0) return default;
 
         using var aesDecryptOutput = ArrayPoolOwner<byte>.Rent(base64DecodeLength);
         var outputLength = SymmetricAlgorithmUtility.Decrypt_AES_256_CFB_8(_aesKey, _aesIv, base64DecodeOutput.Span, aesDecryptOutput.Span);
@@ -19,6 +19,9 @@ public sealed class SoloMiningJob
     private static readonly char[] Operators = { '+', '-', '*', '/', '%' };
     private static readonly char[] Operators2 = { '+', '*', '%' };
 
+    [ThreadStatic]
+    private static RandomBlockNumberGenerator? _randomBlockNumberGenerator;
+
     private readonly long[] _easyBlockValues = new long[256];
     private readonly int _easyBlockValuesLength;
 
@@ -64,19 +67,21 @@ public sealed class SoloMiningJob
         {
             firstNumber = EasyBlockValues[RandomNumberGeneratorUtility.GetRandomBetween(0, 255)];
 
-            do
+            if (!TryGetRandomBlockNumberPair(header, out secondNumber, out _))
             {
-                secondNumber = RandomNumberGeneratorUtility.GetBiasRandomBetween(header.BlockMinRange, header.BlockMaxRange);
-            } while (EasyBlockValues.Contains(secondNumber));
+                poolShare = null;
+                return false;
+            }
         }
         else
         {
             secondNumber = EasyBlockValues[RandomNumberGeneratorUtility.GetRandomBetween(0, 255)];
 
-            do
+            if (!TryGetRandomBlockNumberPair(header, out firstNumber, out _))
             {
-                firstNumber = RandomNumberGeneratorUtility.GetBiasRandomBetween(header.BlockMinRange, header.BlockMaxRange);
-            } while (EasyBlockValues.Contains(firstNumber));
+                poolShare = null;
+                return false;
+            }
         }
 
         do
@@ -128,15 +133,11 @@ public sealed class SoloMiningJob
         char @operator;
         long solution;
 
-        do
-        {
-            firstNumber = RandomNumberGeneratorUtility.GetBiasRandomBetween(header.BlockMinRange, header.BlockMaxRange);
-        } while (EasyBlockValues.Contains(firstNumber));
-
-        do
+        if (!TryGetRandomBlockNumberPair(header, out firstNumber, out secondNumber))
         {
-            secondNumber = RandomNumberGeneratorUtility.GetBiasRandomBetween(header.BlockMinRange, header.BlockMaxRange);
-        } while (EasyBlockValues.Contains(secondNumber));
+            poolShare = null;
+            return false;
+        }
 
         do
         {
@@ -173,6 +174,12 @@ public sealed class SoloMiningJob
         return true;
     }
 
+    private static bool TryGetRandomBlockNumberPair(BlockHeaderResponse.Types.BlockHeader header, out long firstNumber, out long secondNumber)
+    {
+        _randomBlockNumberGenerator ??= new RandomBlockNumberGenerator();
+        return _randomBlockNumberGenerator.TryGetNextPair(header.BlockMinRange, header.BlockMaxRange, true, out firstNumber, out secondNumber);
+    }
+
     [SkipLocalsInit]
     private bool TryGenerateHash(long firstNumber, long secondNumber, char op, out string encryptedShare, out string encryptedShareHash)
     {
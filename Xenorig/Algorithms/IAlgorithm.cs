@@ -1,6 +1,6 @@
 ﻿namespace Xenorig.Algorithms;
 
-public interface IAlgorithm
+public interface IAlgorithm : IDisposable
 {
     Task StartAsync(CancellationToken cancellationToken);
 
@@ -12,6 +12,10 @@ internal class XenophyteCentralizedPoolAlgorithm : IAlgorithm
         throw new NotImplementedException();
     }
 
+    public void Dispose()
+    {
+    }
+
     public void PrintHashrate()
     {
         throw new NotImplementedException();
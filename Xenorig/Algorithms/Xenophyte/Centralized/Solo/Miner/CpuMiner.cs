@@ -1,6 +1,5 @@
 ﻿using System.Diagnostics;
 using System.Runtime.CompilerServices;
-using System.Runtime.InteropServices;
 using System.Text;
 using Microsoft.Extensions.Logging;
 using Xenolib.Algorithms.Xenophyte.Centralized.Networking.Solo;
@@ -12,26 +11,8 @@ namespace Xenorig.Algorithms.Xenophyte.Centralized.Solo.Miner;
 
 public delegate void BlockSubmitResultHandler(long height, string jobType, bool isGoodBlock, string reason, double roundTripTime);
 
-internal sealed partial class CpuMiner
+internal sealed class CpuMiner : IDisposable
 {
-    private static partial class Native
-    {
-        public static partial class Windows
-        {
-            [LibraryImport("kernel32")]
-            public static partial nint GetCurrentThread();
-
-            [LibraryImport("kernel32")]
-            public static partial nint SetThreadAffinityMask(nint hThread, nint dwThreadAffinityMask);
-        }
-
-        public static partial class Linux
-        {
-            [LibraryImport("libc", EntryPoint = "sched_setaffinity")]
-            public static partial int SetThreadAffinityMask(int pid, int cpuSetSize, in ulong mask);
-        }
-    }
-
     public event BlockSubmitResultHandler? FoundBlock;
 
     public const string JobTypeEasy = "Easy Block";
@@ -42,6 +23,8 @@ internal sealed partial class CpuMiner
     public double[] AverageHashCalculatedIn60Seconds { get; }
     public double[] AverageHashCalculatedIn15Minutes { get; }
 
+    public double EasyBlockProgress => _searchEngine.GetEasyBlockProgress();
+
     private const string InvalidShare = "Invalid Share";
     private const string OrphanShare = "Orphan Share";
 
@@ -52,15 +35,20 @@ internal sealed partial class CpuMiner
 
     private int _isCpuMinerActive;
 
-    private readonly Thread[] _cpuMiningThreads;
-    private readonly CpuMinerJob[] _cpuMinerJobs;
+    private readonly SearchEngine _searchEngine;
+    private Thread? _solutionThread;
+
+    private readonly object _jobLock = new();
+    private BlockHeader? _blockHeader;
+    private long _jobId;
+    private long _jobBlockHeight;
+    private string _jobBlockIndication = string.Empty;
 
     private readonly Timer _calculateAverageHashTimer;
 
     private int _amountSampledFor60Seconds;
     private int _amountSampledFor15Minutes;
 
-    private readonly long[] _totalHashCalculatedIn10Seconds;
     private readonly long[] _totalHashCalculatedIn60Seconds;
     private readonly long[] _totalHashCalculatedIn15Minutes;
 
@@ -71,23 +59,33 @@ internal sealed partial class CpuMiner
         _pool = pool;
         _network = network;
 
-        var totalThreads = options.Xenophyte_Centralized_Solo.CpuMiner.GetNumberOfThreads();
+        var cpuMinerOptions = options.Xenophyte_Centralized_Solo.CpuMiner;
+        var totalThreads = cpuMinerOptions.GetNumberOfThreads();
 
-        _cpuMiningThreads = new Thread[totalThreads];
-        _cpuMinerJobs = new CpuMinerJob[totalThreads];
+        var threadOptions = new SearchThreadOptions[totalThreads];
+        var threadPlacement = cpuMinerOptions.AutoThreadAffinity ? CpuInformationUtility.GetThreadPlacement(totalThreads) : Array.Empty<int>();
 
         for (var i = 0; i < totalThreads; i++)
         {
-            _cpuMinerJobs[i] = new CpuMinerJob();
+            var threadAffinity = cpuMinerOptions.GetThreadAffinity(i);
+
+            // A mask set in the thread config always wins over the automatic placement.
+            if (threadAffinity == 0 && i < threadPlacement.Length && threadPlacement[i] < 64)
+            {
+                threadAffinity = 1UL << threadPlacement[i];
+            }
+
+            threadOptions[i] = new SearchThreadOptions(threadAffinity, cpuMinerOptions.GetThreadPriority(i), cpuMinerOptions.GetDoEasyBlock(i), cpuMinerOptions.GetUseXenophyteRandomizer(i));
         }
 
+        _searchEngine = new SearchEngine(threadOptions);
+
         _calculateAverageHashTimer = new Timer(CalculateAverageHashTimerOnElapsed, null, Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
 
         AverageHashCalculatedIn10Seconds = new double[totalThreads];
         AverageHashCalculatedIn60Seconds = new double[totalThreads];
         AverageHashCalculatedIn15Minutes = new double[totalThreads];
 
-        _totalHashCalculatedIn10Seconds = new long[totalThreads];
         _totalHashCalculatedIn60Seconds = new long[totalThreads];
         _totalHashCalculatedIn15Minutes = new long[totalThreads];
     }
@@ -96,23 +94,20 @@ internal sealed partial class CpuMiner
     {
         if (Interlocked.CompareExchange(ref _isCpuMinerActive, 1, 0) == 1) return;
 
-        var totalThreads = _options.Xenophyte_Centralized_Solo.CpuMiner.GetNumberOfThreads();
-
-        for (var i = 0; i < totalThreads; i++)
+        _solutionThread = new Thread(ExecuteSolutionThread)
         {
-            var threadId = i;
+            Name = "Mining Solution Thread",
+            IsBackground = true
+        };
 
-            _cpuMiningThreads[i] = new Thread(() => ExecuteCpuMinerThread(threadId, _options.Xenophyte_Centralized_Solo.CpuMiner))
-            {
-                Name = $"Mining Thread {i}",
-                IsBackground = true,
-                Priority = _options.Xenophyte_Centralized_Solo.CpuMiner.GetThreadPriority(i)
-            };
+        _solutionThread.Start();
 
-            _cpuMiningThreads[i].Start();
+        lock (_jobLock)
+        {
+            if (_blockHeader != null) StartJob(_blockHeader);
         }
 
-        Logger.PrintCpuMinerReady(_logger, totalThreads);
+        Logger.PrintCpuMinerReady(_logger, AverageHashCalculatedIn10Seconds.Length);
 
         _calculateAverageHashTimer.Change(TimeSpan.FromSeconds(10), TimeSpan.FromSeconds(10));
     }
@@ -121,275 +116,102 @@ internal sealed partial class CpuMiner
     {
         if (Interlocked.CompareExchange(ref _isCpuMinerActive, 0, 1) == 0) return;
 
+        _searchEngine.CancelJob();
+        _solutionThread?.Join();
+
         _calculateAverageHashTimer.Change(Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
     }
 
-    public void UpdateJobTemplate(BlockHeader blockHeader)
+    public void Dispose()
     {
-        foreach (var cpuMinerJob in _cpuMinerJobs)
-        {
-            cpuMinerJob.Update(blockHeader);
-        }
-    }
+        StopCpuMiner();
 
-    private void ExecuteCpuMinerThread(int threadId, Options.CpuMiner options)
-    {
-        var threadAffinity = options.GetThreadAffinity(threadId);
+        // The timer callback reads the hash counters of the engine, wait for a running one before the engine is freed.
+        using var timerDisposed = new ManualResetEvent(false);
+        if (_calculateAverageHashTimer.Dispose(timerDisposed)) timerDisposed.WaitOne();
 
-        if (threadAffinity != 0)
-        {
-            if (RuntimeInformation.IsOSPlatform(OSPlatform.Windows))
-            {
-                Native.Windows.SetThreadAffinityMask(Native.Windows.GetCurrentThread(), (nint) threadAffinity);
-            }
-            else if (RuntimeInformation.IsOSPlatform(OSPlatform.Linux))
-            {
-                Native.Linux.SetThreadAffinityMask(0, sizeof(ulong), threadAffinity);
-            }
-        }
-
-        // Thread Variable
-        var cpuMinerJob = _cpuMinerJobs[threadId];
-
-        var doEasyBlock = options.GetDoEasyBlock(threadId);
-        var easyBlockIndex = options.GetEasyBlockIndex(threadId);
-        var totalEasyBlockThreads = options.GetTotalEasyBlockThreads();
-        var useXenophyteRandomizer = options.GetUseXenophyteRandomizer(threadId);
-
-        while (_isCpuMinerActive == 1)
-        {
-            // Wait for new block.
-            do
-            {
-                if (cpuMinerJob.HasNewBlock)
-                {
-                    cpuMinerJob.BlockFound = false;
-                    cpuMinerJob.HasNewBlock = false;
-                    break;
-                }
-
-                Thread.Sleep(1);
-            } while (_isCpuMinerActive == 1);
-
-            if (_isCpuMinerActive == 0) break;
-
-            // Received new block!
-            if (doEasyBlock)
-            {
-                DoEasyBlocksCalculations(threadId, easyBlockIndex, totalEasyBlockThreads, cpuMinerJob);
-
-                if (cpuMinerJob.BlockFound) continue;
-                if (cpuMinerJob.HasNewBlock) continue;
-            }
-
-            DoNonSmartMiningModeCalculations(threadId, useXenophyteRandomizer, cpuMinerJob);
-        }
+        // Freeing the engine joins its worker threads.
+        _searchEngine.Dispose();
     }
 
-    [SkipLocalsInit]
-    private void DoEasyBlocksCalculations(int threadId, int easyBlockIndex, int totalEasyBlockThreads, CpuMinerJob cpuMinerJob)
+    public void UpdateJobTemplate(BlockHeader blockHeader)
     {
-        cpuMinerJob.GenerateEasyBlockValues();
-
-        var easyBlockValues = cpuMinerJob.EasyBlockValues;
-
-        var (startIndex, size) = CpuMinerUtility.GetJobChunk(easyBlockValues.Length, totalEasyBlockThreads, easyBlockIndex);
-        if (size == 0) return;
-
-        Span<long> chunkData = stackalloc long[size];
-        BufferUtility.MemoryCopy(easyBlockValues.Slice(startIndex, size), chunkData, size);
-
-        Logger.PrintCurrentChunkedThreadJob(_logger, threadId, JobTypeEasy, startIndex, startIndex + size - 1, size);
-
-        for (var i = size - 1; i >= 0; i--)
+        lock (_jobLock)
         {
-            var choseRandom = RandomNumberGeneratorUtility.GetRandomBetween(0, i);
-
-            for (var j = cpuMinerJob.EasyBlockValues.Length - 1; j >= 0; j--)
-            {
-                var choseRandom2 = RandomNumberGeneratorUtility.GetRandomBetween(0, j);
-
-                DoMathCalculations(threadId, chunkData.GetRef(choseRandom), easyBlockValues.GetRef(choseRandom2), JobTypeEasy, cpuMinerJob);
+            _blockHeader = blockHeader;
 
-                (easyBlockValues.GetRef(j), easyBlockValues.GetRef(choseRandom2)) = (easyBlockValues.GetRef(choseRandom2), easyBlockValues.GetRef(j));
-            }
-
-            if (cpuMinerJob.BlockFound) return;
-            if (cpuMinerJob.HasNewBlock) return;
-
-            chunkData.GetRef(choseRandom) = chunkData.GetRef(i);
+            if (_isCpuMinerActive == 1) StartJob(blockHeader);
         }
     }
 
-    private void DoNonSmartMiningModeCalculations(int threadId, bool useXenophyteRandomizer, CpuMinerJob cpuMinerJob)
+    [SkipLocalsInit]
+    private void StartJob(BlockHeader blockHeader)
     {
-        var easyBlockValues = cpuMinerJob.EasyBlockValues;
+        var jobId = _searchEngine.StartJob(blockHeader.BlockMinRange, blockHeader.BlockMaxRange, blockHeader.BlockTimestampCreate, blockHeader.XorKey, blockHeader.AesKey, blockHeader.AesIv, blockHeader.AesRound, blockHeader.BlockIndication);
 
-        Logger.PrintCurrentThreadJob(_logger, threadId, JobTypeRandom);
-
-        if (useXenophyteRandomizer)
+        // A rejected block leaves the previous job running in the native engine, stop it rather than mine a stale block.
+        if (jobId == 0)
         {
-            do
-            {
-                long choseRandom;
-                long choseRandom2;
-
-                do
-                {
-                    choseRandom = RandomNumberGeneratorUtility.GetBiasRandomBetween(cpuMinerJob.BlockMinRange, cpuMinerJob.BlockMaxRange);
-                } while (cpuMinerJob.EasyBlockValues.Contains(choseRandom));
-
-                do
-                {
-                    choseRandom2 = RandomNumberGeneratorUtility.GetBiasRandomBetween(cpuMinerJob.BlockMinRange, cpuMinerJob.BlockMaxRange);
-                } while (cpuMinerJob.EasyBlockValues.Contains(choseRandom2));
-
-                DoMathCalculations(threadId, choseRandom, choseRandom2, JobTypeRandom, cpuMinerJob);
-                DoMathCalculations(threadId, choseRandom2, choseRandom, JobTypeRandom, cpuMinerJob);
-
-                if (cpuMinerJob.BlockFound) return;
-                if (cpuMinerJob.HasNewBlock) return;
-
-                for (var i = cpuMinerJob.EasyBlockValues.Length - 1; i >= 0; i--)
-                {
-                    var choseRandom3 = RandomNumberGeneratorUtility.GetRandomBetween(0, i);
-
-                    DoMathCalculations(threadId, choseRandom, easyBlockValues.GetRef(choseRandom3), JobTypeSemiRandom, cpuMinerJob);
-                    DoMathCalculations(threadId, easyBlockValues.GetRef(choseRandom3), choseRandom, JobTypeSemiRandom, cpuMinerJob);
-
-                    DoMathCalculations(threadId, choseRandom2, easyBlockValues.GetRef(choseRandom3), JobTypeSemiRandom, cpuMinerJob);
-                    DoMathCalculations(threadId, easyBlockValues.GetRef(choseRandom3), choseRandom2, JobTypeSemiRandom, cpuMinerJob);
-
-                    (easyBlockValues.GetRef(i), easyBlockValues.GetRef(choseRandom3)) = (easyBlockValues.GetRef(choseRandom3), easyBlockValues.GetRef(i));
-                }
-            } while (cpuMinerJob is { BlockFound: false, HasNewBlock: false });
+            _searchEngine.CancelJob();
+            Logger.PrintJobStartFailed(_logger, blockHeader.BlockHeight);
+            return;
         }
-        else
-        {
-            do
-            {
-                long choseRandom;
-                long choseRandom2;
-
-                do
-                {
-                    choseRandom = RandomNumberGeneratorUtility.GetRandomBetween(cpuMinerJob.BlockMinRange, cpuMinerJob.BlockMaxRange);
-                } while (cpuMinerJob.EasyBlockValues.Contains(choseRandom));
-
-                do
-                {
-                    choseRandom2 = RandomNumberGeneratorUtility.GetRandomBetween(cpuMinerJob.BlockMinRange, cpuMinerJob.BlockMaxRange);
-                } while (cpuMinerJob.EasyBlockValues.Contains(choseRandom2));
-
-                DoMathCalculations(threadId, choseRandom, choseRandom2, JobTypeRandom, cpuMinerJob);
-                DoMathCalculations(threadId, choseRandom2, choseRandom, JobTypeRandom, cpuMinerJob);
-
-                if (cpuMinerJob.BlockFound) return;
-                if (cpuMinerJob.HasNewBlock) return;
 
-                for (var i = cpuMinerJob.EasyBlockValues.Length - 1; i >= 0; i--)
-                {
-                    var choseRandom3 = RandomNumberGeneratorUtility.GetRandomBetween(0, i);
+        // Starting a job cancels whatever was running, so shares from the previous block are never submitted.
+        _jobId = jobId;
 
-                    DoMathCalculations(threadId, choseRandom, easyBlockValues.GetRef(choseRandom3), JobTypeSemiRandom, cpuMinerJob);
-                    DoMathCalculations(threadId, easyBlockValues.GetRef(choseRandom3), choseRandom, JobTypeSemiRandom, cpuMinerJob);
+        // The block header is updated in place by the network, keep what the share submission needs for this job.
+        _jobBlockHeight = blockHeader.BlockHeight;
+        _jobBlockIndication = blockHeader.BlockIndication;
 
-                    DoMathCalculations(threadId, choseRandom2, easyBlockValues.GetRef(choseRandom3), JobTypeSemiRandom, cpuMinerJob);
-                    DoMathCalculations(threadId, easyBlockValues.GetRef(choseRandom3), choseRandom2, JobTypeSemiRandom, cpuMinerJob);
+        var options = _options.Xenophyte_Centralized_Solo.CpuMiner;
 
-                    (easyBlockValues.GetRef(i), easyBlockValues.GetRef(choseRandom3)) = (easyBlockValues.GetRef(choseRandom3), easyBlockValues.GetRef(i));
-                }
-            } while (cpuMinerJob is { BlockFound: false, HasNewBlock: false });
+        // Easy block threads share one cursor over every easy block pair, they move on to random values once it is exhausted.
+        for (var i = 0; i < AverageHashCalculatedIn10Seconds.Length; i++)
+        {
+            Logger.PrintCurrentThreadJob(_logger, i, options.GetDoEasyBlock(i) ? JobTypeEasy : JobTypeRandom);
         }
     }
 
-    private void DoMathCalculations(int threadId, long firstNumber, long secondNumber, string jobType, CpuMinerJob cpuMinerJob)
+    [SkipLocalsInit]
+    private void ExecuteSolutionThread()
     {
-        if (firstNumber > secondNumber)
-        {
-            // Subtraction Rule:
-            var subtractionResult = firstNumber - secondNumber;
+        Span<byte> encryptedShare = stackalloc byte[64 * 2];
 
-            if (subtractionResult >= cpuMinerJob.BlockMinRange)
-            {
-                ValidateAndSubmitShare(threadId, firstNumber, secondNumber, subtractionResult, '-', jobType, cpuMinerJob);
-            }
+        while (_isCpuMinerActive == 1)
+        {
+            if (!_searchEngine.PollSolution(out var solution, encryptedShare, TimeSpan.FromMilliseconds(100))) continue;
 
-            // Division Rule:
-            var (integerDivideResult, integerDivideRemainder) = Math.DivRem(firstNumber, secondNumber);
+            long blockHeight;
+            string blockIndication;
 
-            if (integerDivideRemainder == 0 && integerDivideResult >= cpuMinerJob.BlockMinRange)
+            lock (_jobLock)
             {
-                ValidateAndSubmitShare(threadId, firstNumber, secondNumber, integerDivideResult, '/', jobType, cpuMinerJob);
-            }
+                if (solution.JobId != _jobId) continue;
 
-            // Modulo Rule:
-            if (integerDivideRemainder >= cpuMinerJob.BlockMinRange)
-            {
-                ValidateAndSubmitShare(threadId, firstNumber, secondNumber, integerDivideRemainder, '%', jobType, cpuMinerJob);
+                blockHeight = _jobBlockHeight;
+                blockIndication = _jobBlockIndication;
             }
-        }
-        else
-        {
-            var integerDivideRemainder = firstNumber % secondNumber;
 
-            // Modulo Rule:
-            if (integerDivideRemainder >= cpuMinerJob.BlockMinRange)
+            var jobType = solution.JobType switch
             {
-                ValidateAndSubmitShare(threadId, firstNumber, secondNumber, integerDivideRemainder, '%', jobType, cpuMinerJob);
-            }
-        }
-
-        // Addition Rule:
-        var additionResult = firstNumber + secondNumber;
-
-        if (additionResult <= cpuMinerJob.BlockMaxRange)
-        {
-            ValidateAndSubmitShare(threadId, firstNumber, secondNumber, additionResult, '+', jobType, cpuMinerJob);
-        }
-
-        // Multiplication Rule:
-        var multiplicationResult = firstNumber * secondNumber;
+                SearchSolution.JobTypeEasy => JobTypeEasy,
+                SearchSolution.JobTypeSemiRandom => JobTypeSemiRandom,
+                _ => JobTypeRandom
+            };
 
-        if (multiplicationResult <= cpuMinerJob.BlockMaxRange)
-        {
-            ValidateAndSubmitShare(threadId, firstNumber, secondNumber, multiplicationResult, '*', jobType, cpuMinerJob);
+            SubmitShare(solution.ThreadIndex, solution, jobType, encryptedShare, blockHeight, blockIndication);
         }
     }
 
-    [SkipLocalsInit]
-    private void ValidateAndSubmitShare(int threadId, long firstNumber, long secondNumber, long solution, char op, string jobType, CpuMinerJob cpuMinerJob)
+    private void SubmitShare(int threadId, in SearchSolution searchSolution, string jobType, ReadOnlySpan<byte> encryptedShare, long blockHeight, string blockIndication)
     {
-        Span<char> stringToEncrypt = stackalloc char[19 + 1 + 1 + 1 + 19 + 19];
-
-        firstNumber.TryFormat(stringToEncrypt, out var firstNumberWritten);
-
-        stringToEncrypt.GetRef(firstNumberWritten) = ' ';
-        stringToEncrypt.GetRef(firstNumberWritten + 1) = op;
-        stringToEncrypt.GetRef(firstNumberWritten + 2) = ' ';
-
-        secondNumber.TryFormat(stringToEncrypt[(firstNumberWritten + 3)..], out var secondNumberWritten);
-        cpuMinerJob.BlockTimestampCreate.TryFormat(stringToEncrypt[(firstNumberWritten + 3 + secondNumberWritten)..], out var finalWritten);
-
-        Span<byte> bytesToEncrypt = stackalloc byte[firstNumberWritten + 3 + secondNumberWritten + finalWritten];
-        Encoding.ASCII.GetBytes(stringToEncrypt[..(firstNumberWritten + 3 + secondNumberWritten + finalWritten)], bytesToEncrypt);
-
-        Span<byte> encryptedShare = stackalloc byte[64 * 2];
-        Span<byte> hashEncryptedShare = stackalloc byte[64 * 2];
-
-        if (!CpuMinerUtility.MakeEncryptedShare(bytesToEncrypt, encryptedShare, hashEncryptedShare, cpuMinerJob.XorKey, cpuMinerJob.AesKey, cpuMinerJob.AesIv, cpuMinerJob.AesRound))
-        {
-            return;
-        }
-
-        Interlocked.Increment(ref _totalHashCalculatedIn10Seconds.GetRef(threadId));
-
-        Span<char> hashEncryptedShareString = stackalloc char[Encoding.ASCII.GetCharCount(hashEncryptedShare)];
-        Encoding.ASCII.GetChars(hashEncryptedShare, hashEncryptedShareString);
-
-        if (!hashEncryptedShareString.SequenceEqual(cpuMinerJob.BlockIndication)) return;
+        var firstNumber = searchSolution.FirstNumber;
+        var secondNumber = searchSolution.SecondNumber;
+        var solution = searchSolution.Solution;
+        var op = (char) searchSolution.Operator;
 
-        _network.SendPacketToNetwork(new PacketData($"{NetworkConstants.ReceiveJob}|{Encoding.ASCII.GetString(encryptedShare)}|{solution}|{firstNumber} {op} {secondNumber}|{hashEncryptedShareString}|{cpuMinerJob.BlockHeight}|{_pool.UserAgent}", true, (packet, time) =>
+        _network.SendPacketToNetwork(new PacketData($"{NetworkConstants.ReceiveJob}|{Encoding.ASCII.GetString(encryptedShare)}|{solution}|{firstNumber} {op} {secondNumber}|{blockIndication}|{blockHeight}|{_pool.UserAgent}", true, (packet, time) =>
         {
             Span<char> temp = stackalloc char[Encoding.UTF8.GetCharCount(packet)];
             Encoding.UTF8.GetChars(packet, temp);
@@ -399,23 +221,22 @@ internal sealed partial class CpuMiner
 
             if (temp.StartsWith(NetworkConstants.ShareWrong))
             {
-                FoundBlock?.Invoke(cpuMinerJob.BlockHeight, jobType, false, InvalidShare, time.TotalMilliseconds);
+                FoundBlock?.Invoke(blockHeight, jobType, false, InvalidShare, time.TotalMilliseconds);
             }
             else if (temp.StartsWith(NetworkConstants.ShareUnlock))
             {
-                FoundBlock?.Invoke(cpuMinerJob.BlockHeight, jobType, true, string.Empty, time.TotalMilliseconds);
+                FoundBlock?.Invoke(blockHeight, jobType, true, string.Empty, time.TotalMilliseconds);
             }
             else if (temp.StartsWith(NetworkConstants.ShareAleady))
             {
-                FoundBlock?.Invoke(cpuMinerJob.BlockHeight, jobType, false, OrphanShare, time.TotalMilliseconds);
+                FoundBlock?.Invoke(blockHeight, jobType, false, OrphanShare, time.TotalMilliseconds);
             }
             else if (temp.StartsWith(NetworkConstants.ShareNotExist))
             {
-                FoundBlock?.Invoke(cpuMinerJob.BlockHeight, jobType, false, InvalidShare, time.TotalMilliseconds);
+                FoundBlock?.Invoke(blockHeight, jobType, false, InvalidShare, time.TotalMilliseconds);
             }
         }));
 
-        cpuMinerJob.BlockFound = true;
         Logger.PrintBlockFound(_logger, threadId, jobType, firstNumber, op, secondNumber, solution);
     }
 
@@ -425,8 +246,7 @@ internal sealed partial class CpuMiner
 
         for (var i = AverageHashCalculatedIn10Seconds.Length - 1; i >= 0; i--)
         {
-            var capturedValue = Interlocked.Read(ref _totalHashCalculatedIn10Seconds.GetRef(i));
-            Interlocked.Exchange(ref _totalHashCalculatedIn10Seconds.GetRef(i), 0);
+            var capturedValue = _searchEngine.TakeHashCount(i);
 
             _totalHashCalculatedIn60Seconds.GetRef(i) += capturedValue;
             _totalHashCalculatedIn15Minutes.GetRef(i) += capturedValue;
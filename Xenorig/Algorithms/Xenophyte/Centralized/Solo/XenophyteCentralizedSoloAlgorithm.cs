@@ -73,6 +73,13 @@ internal class XenophyteCentralizedSoloAlgorithm : IAlgorithm
         await _network.DisconnectAsync(cancellationToken);
     }
 
+    public void Dispose()
+    {
+        _printAverageHashTimer.Dispose();
+        _cpuMiner.Dispose();
+        _network.Dispose();
+    }
+
     public void PrintHashrate()
     {
         _maxHash = Math.Max(_maxHash, _cpuMiner.AverageHashCalculatedIn10Seconds.Sum());
@@ -99,6 +106,7 @@ internal class XenophyteCentralizedSoloAlgorithm : IAlgorithm
     public void PrintCurrentJob()
     {
         Logger.PrintJob(_logger, "current job", _pool.Url, _blockHeader.BlockDifficulty, _blockHeader.BlockMethod, _blockHeader.BlockHeight);
+        Logger.PrintJobProgress(_logger, CpuMiner.JobTypeEasy, _cpuMiner.EasyBlockProgress);
     }
 
     private void PrintAverageHashTimer(object? state)
@@ -31,6 +31,7 @@ internal sealed class ConsoleService : BackgroundService
         Logger.PrintAbout(_logger, "About", ApplicationUtility.Name, ApplicationUtility.Version, ApplicationUtility.FrameworkVersion);
         Logger.PrintCpu(_logger, "CPU", CpuInformationUtility.ProcessorName, CpuInformationUtility.ProcessorInstructionSetsSupported);
         Logger.PrintCpuCont(_logger, string.Empty, CpuInformationUtility.ProcessorL2Cache / 1024.0 / 1024.0, CpuInformationUtility.ProcessorL3Cache / 1024.0 / 1024.0, CpuInformationUtility.ProcessorCoreCount, CpuInformationUtility.ProcessorThreadCount);
+        Logger.PrintCpuKernels(_logger, string.Empty, CpuDispatchUtility.TierName, CpuDispatchUtility.KernelNames);
         Logger.PrintDonatePercentage(_logger, "DONATE", _options.DonatePercentage);
         Logger.PrintCommand(_logger, "COMMANDS");
 
@@ -45,29 +46,42 @@ internal sealed class ConsoleService : BackgroundService
         _minerInstances = CreateMinerInstances();
         if (_minerInstances.Length == 0) return;
 
-        await _minerInstances[_currentIndex].StartAsync(stoppingToken);
-
-        while (!stoppingToken.IsCancellationRequested)
+        try
         {
-            var readKeyTask = Task.Factory.StartNew(() => Console.ReadKey(true), stoppingToken, TaskCreationOptions.LongRunning, TaskScheduler.Current);
-            var taskCompleted = await Task.WhenAny(readKeyTask, Task.Delay(Timeout.Infinite, stoppingToken));
-            if (taskCompleted != readKeyTask) return;
-
-            var keyPressed = await readKeyTask;
+            await _minerInstances[_currentIndex].StartAsync(stoppingToken);
 
-            switch (keyPressed.Key)
+            while (!stoppingToken.IsCancellationRequested)
             {
-                case ConsoleKey.H:
-                    _minerInstances[_currentIndex].PrintHashrate();
-                    break;
-
-                case ConsoleKey.S:
-                    _minerInstances[_currentIndex].PrintStats();
-                    break;
+                var readKeyTask = Task.Factory.StartNew(() => Console.ReadKey(true), stoppingToken, TaskCreationOptions.LongRunning, TaskScheduler.Current);
+                var taskCompleted = await Task.WhenAny(readKeyTask, Task.Delay(Timeout.Infinite, stoppingToken));
+                if (taskCompleted != readKeyTask) return;
+
+                var keyPressed = await readKeyTask;
+
+                switch (keyPressed.Key)
+                {
+                    case ConsoleKey.H:
+                        _minerInstances[_currentIndex].PrintHashrate();
+                        break;
+
+                    case ConsoleKey.S:
+                        _minerInstances[_currentIndex].PrintStats();
+                        break;
+
+                    case ConsoleKey.J:
+                        _minerInstances[_currentIndex].PrintCurrentJob();
+                        break;
+                }
+            }
+        }
+        finally
+        {
+            // The miners own native worker threads, they are stopped and joined before the host goes away.
+            await _minerInstances[_currentIndex].StopAsync(CancellationToken.None);
 
-                case ConsoleKey.J:
-                    _minerInstances[_currentIndex].PrintCurrentJob();
-                    break;
+            foreach (var minerInstance in _minerInstances)
+            {
+                minerInstance.Dispose();
             }
         }
     }
@@ -14,6 +14,9 @@ internal static partial class Logger
     [LoggerMessage(Level = LogLevel.Information, Message = $"   {WhiteForegroundColor}{{category,-12}} {DarkGrayForegroundColor}L2: {CyanForegroundColor}{{l2Cache:F1}} {DarkGrayForegroundColor}MB L3: {CyanForegroundColor}{{l3Cache:F1}} {DarkGrayForegroundColor}MB {CyanForegroundColor}{{coreCount}}{DarkGrayForegroundColor}C/{CyanForegroundColor}{{threadCount}}{DarkGrayForegroundColor}T{Reset}")]
     public static partial void PrintCpuCont(ILogger logger, string category, double l2Cache, double l3Cache, int coreCount, int threadCount);
 
+    [LoggerMessage(Level = LogLevel.Information, Message = $"   {WhiteForegroundColor}{{category,-12}} {DarkGrayForegroundColor}tier: {CyanForegroundColor}{{tierName}} {DarkGrayForegroundColor}{{kernelNames}}{Reset}")]
+    public static partial void PrintCpuKernels(ILogger logger, string category, string tierName, string kernelNames);
+
     [LoggerMessage(Level = LogLevel.Information, Message = $" {GreenForegroundColor}* {WhiteForegroundColor}{{category,-12:l}} {DarkGrayForegroundColor}{{donatePercentage}}%{Reset}")]
     public static partial void PrintDonatePercentage(ILogger logger, string category, int donatePercentage);
 
@@ -41,8 +44,11 @@ internal static partial class Logger
     [LoggerMessage(Level = LogLevel.Information, Message = $"{MagentaForegroundColor}{{job}}{Reset} from {WhiteForegroundColor}{{host}}{Reset} diff {WhiteForegroundColor}{{difficulty}}{Reset} algo {WhiteForegroundColor}{{algorithm}}{Reset} height {WhiteForegroundColor}{{height}}{Reset}")]
     public static partial void PrintJob(ILogger logger, string job, string host, long difficulty, string algorithm, long height);
 
-    [LoggerMessage(Level = LogLevel.Information, Message = $"{BlueForegroundColor}Thread: {{threadId,-2}} | Job Type: {{jobType}} | Job Chunk: {{startIndex}}-{{endIndex}} ({{size}}){Reset}")]
-    public static partial void PrintCurrentChunkedThreadJob(ILogger logger, int threadId, string jobType, long startIndex, long endIndex, long size);
+    [LoggerMessage(Level = LogLevel.Information, Message = $"{BlueForegroundColor}Job Type: {{jobType}} | Covered: {{progress:P1}}{Reset}")]
+    public static partial void PrintJobProgress(ILogger logger, string jobType, double progress);
+
+    [LoggerMessage(Level = LogLevel.Information, Message = $"{DarkRedForegroundColor}Job for height {{height}} could not be started, mining is paused until the next block.{Reset}")]
+    public static partial void PrintJobStartFailed(ILogger logger, long height);
 
     [LoggerMessage(Level = LogLevel.Information, Message = $"{BlueForegroundColor}Thread: {{threadId,-2}} | Job Type: {{jobType}}{Reset}")]
     public static partial void PrintCurrentThreadJob(ILogger logger, int threadId, string jobType);
@@ -45,6 +45,8 @@ internal sealed class CpuMiner
     
     public ThreadPriority ThreadPriority { get; set; } = ThreadPriority.Normal;
 
+    public bool AutoThreadAffinity { get; set; }
+
     public CpuMinerThreadConfiguration[] ThreadConfigs { get; set; } = Array.Empty<CpuMinerThreadConfiguration>();
     
     public bool DoEasyBlock { get; set; } = true;
@@ -71,37 +73,6 @@ internal sealed class CpuMiner
         return GetThreadConfig(thread)?.DoEasyBlock ?? DoEasyBlock;
     }
     
-    public int GetEasyBlockIndex(int thread)
-    {
-        var index = -1;
-
-        for (var i = 0; i <= thread; i++)
-        {
-            if (GetDoEasyBlock(thread))
-            {
-                index++;
-            }
-        }
-        
-        return index;
-    }
-
-    public int GetTotalEasyBlockThreads()
-    {
-        var result = 0;
-        var numberOfThreads = GetNumberOfThreads();
-        
-        for (var i = 0; i < numberOfThreads; i++)
-        {
-            if (GetDoEasyBlock(i))
-            {
-                result++;
-            }
-        }
-        
-        return result;
-    }
-
     public bool GetUseXenophyteRandomizer(int thread)
     {
         return GetThreadConfig(thread)?.UseXenophyteRandomizer ?? UseXenophyteRandomizer;
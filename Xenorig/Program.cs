@@ -3,6 +3,7 @@ using Microsoft.Extensions.Hosting;
 using TheDialgaTeam.Serilog.Extensions;
 using TheDialgaTeam.Serilog.Formatting;
 using TheDialgaTeam.Serilog.Sinks.AnsiConsole;
+using Xenolib.Utilities;
 using Xenorig.Options;
 
 namespace Xenorig;
@@ -13,6 +14,9 @@ internal static class Program
     {
         AppDomain.CurrentDomain.UnhandledException += OnCurrentDomainOnUnhandledException;
 
+        // There is no matching Shutdown, threads may still be inside a pooled call when the host returns and the OS reclaims the cache at exit.
+        CryptographyUtility.Initialize();
+
         return Host.CreateDefaultBuilder(args)
             .ConfigureServices(collection =>
             {